@@ -0,0 +1,722 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <deque>        // For std::deque
+#include <stdexcept>    // For std::invalid_argument, std::runtime_error, std::out_of_range
+#include <new>          // For std::bad_alloc
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint8_t, std::uint64_t
+#include <cstdlib>      // For std::free, posix_memalign
+#include <cstring>      // For std::memset
+#include <cerrno>       // For errno, EINTR, EAGAIN, EBUSY
+#include <string>       // For std::string, std::to_string
+#include <algorithm>    // For std::min, std::max
+#include <type_traits>  // For std::is_same
+
+#include <fcntl.h>      // For open
+#include <unistd.h>     // For pread, close, syscall
+#include <sys/stat.h>   // For fstat
+#include <sys/uio.h>    // For struct iovec
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h> // For io_uring_params, io_uring_sqe, io_uring_cqe
+#include <sys/syscall.h>    // For SYS_io_uring_setup, SYS_io_uring_enter, SYS_io_uring_register
+#include <sys/mman.h>       // For mmap, munmap
+#if defined(SYS_io_uring_setup) && defined(SYS_io_uring_enter) && defined(SYS_io_uring_register)
+#define JABUFF_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#include "FramingRingBuffer2D.hpp"
+#include "MappedFileSource.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief How AsyncFileReader performs its reads.
+ */
+enum class IngestBackend {
+    IoUring, // Reads queued to the kernel, overlapping with the caller's work
+    Pread    // Blocking pread() from poll()
+};
+
+#if defined(JABUFF_HAS_IO_URING)
+namespace detail {
+
+// Minimal io_uring on the raw system calls (no liburing dependency).
+class IoUring {
+public:
+    IoUring() = default;
+    ~IoUring() { shutdown(); }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Returns false if the kernel refuses (too old, disabled, or filtered by seccomp).
+    bool init(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        int fd = static_cast<int>(::syscall(SYS_io_uring_setup, entries, &params));
+        if (fd < 0) return false;
+        m_fd = fd;
+
+        m_sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) m_sq_bytes = m_cq_bytes = std::max(m_sq_bytes, m_cq_bytes);
+
+        m_sq_ptr = ::mmap(nullptr, m_sq_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        if (m_sq_ptr == MAP_FAILED) { m_sq_ptr = nullptr; shutdown(); return false; }
+        if (single_mmap) {
+            m_cq_ptr = m_sq_ptr;
+        } else {
+            m_cq_ptr = ::mmap(nullptr, m_cq_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+            if (m_cq_ptr == MAP_FAILED) { m_cq_ptr = nullptr; shutdown(); return false; }
+        }
+        m_sqes_bytes = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, m_sqes_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) { shutdown(); return false; }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        std::uint8_t* sq = static_cast<std::uint8_t*>(m_sq_ptr);
+        std::uint8_t* cq = static_cast<std::uint8_t*>(m_cq_ptr);
+        m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sq_entries = params.sq_entries;
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        m_local_tail = *m_sq_tail;
+        return true;
+    }
+
+    bool registerBuffers(const struct iovec* buffers, unsigned count) {
+        return ::syscall(SYS_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+    }
+
+    // Returns a zeroed submission entry, or nullptr if the submission queue is full.
+    io_uring_sqe* getSqe() {
+        unsigned head = __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE);
+        if (m_local_tail - head >= m_sq_entries) return nullptr;
+        unsigned index = m_local_tail & m_sq_mask;
+        io_uring_sqe* sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        m_sq_array[index] = index;
+        ++m_local_tail;
+        return sqe;
+    }
+
+    // Publishes queued entries and optionally waits for wait_nr completions.
+    // Entries the kernel has not consumed (a partial submit, EAGAIN / EBUSY) stay
+    // queued and are offered again, here or by the next call.
+    bool submit(unsigned wait_nr) {
+        __atomic_store_n(m_sq_tail, m_local_tail, __ATOMIC_RELEASE);
+        for (;;) {
+            // Pending work is measured from the kernel's head, as liburing does.
+            unsigned to_submit = m_local_tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE);
+            if (to_submit == 0 && wait_nr == 0) return true;
+            unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+            long ret = ::syscall(SYS_io_uring_enter, m_fd, to_submit, wait_nr, flags, nullptr, 0);
+            if (ret < 0) {
+                if (errno == EINTR) continue;
+                // Out of resources or completions backed up: the caller reaps, then submits again.
+                return errno == EAGAIN || errno == EBUSY;
+            }
+            // The kernel does not wait after a partial submit, so retry while it makes progress.
+            if (ret == 0 || static_cast<unsigned>(ret) >= to_submit) return true;
+        }
+    }
+
+    bool popCompletion(std::uint64_t& user_data, int& result) {
+        unsigned head = *m_cq_head;
+        if (head == __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE)) return false;
+        const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+        user_data = cqe.user_data;
+        result = cqe.res;
+        __atomic_store_n(m_cq_head, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    void shutdown() {
+        if (m_sqes) ::munmap(m_sqes, m_sqes_bytes);
+        if (m_cq_ptr && m_cq_ptr != m_sq_ptr) ::munmap(m_cq_ptr, m_cq_bytes);
+        if (m_sq_ptr) ::munmap(m_sq_ptr, m_sq_bytes);
+        if (m_fd >= 0) ::close(m_fd);
+        m_sqes = nullptr;
+        m_cq_ptr = nullptr;
+        m_sq_ptr = nullptr;
+        m_fd = -1;
+    }
+
+    int m_fd = -1;
+    void* m_sq_ptr = nullptr;
+    void* m_cq_ptr = nullptr;
+    size_t m_sq_bytes = 0;
+    size_t m_cq_bytes = 0;
+    size_t m_sqes_bytes = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    unsigned* m_sq_head = nullptr;
+    unsigned* m_sq_tail = nullptr;
+    unsigned* m_sq_array = nullptr;
+    unsigned m_sq_mask = 0;
+    unsigned m_sq_entries = 0;
+    unsigned m_local_tail = 0;
+    unsigned* m_cq_head = nullptr;
+    unsigned* m_cq_tail = nullptr;
+    unsigned m_cq_mask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+};
+
+} // namespace detail
+#endif
+
+/**
+ * @brief Streams many WAV / raw files into FramingRingBuffer2Ds with asynchronous reads.
+ *
+ * Each added file feeds one ring. poll() queues reads for every file whose ring has
+ * free space and publishes the reads that have completed, in file order, with
+ * reserve() / commit(); in between the kernel performs the I/O while the caller frames
+ * and computes. One reader (one io_uring) serves any number of files.
+ *
+ * Where the file already holds the ring's sample layout (one channel, Float32 into a
+ * float ring or Float64 into a double ring) reads land straight in the ring's reserved
+ * free space. Otherwise they land in page-aligned staging buffers registered with the
+ * kernel (fixed buffers) and completion converts / deinterleaves them into the ring,
+ * exactly like MappedFileSource::pump().
+ *
+ * io_uring is used when the headers are available and the kernel allows it; otherwise
+ * (or on request) poll() falls back to blocking pread() calls. Regular files are always
+ * "ready" to epoll, so there is no readiness-based variant.
+ *
+ * While a file is attached, nothing else may write to its ring. Reading from it is fine.
+ * Requires POSIX (open / pread).
+ *
+ * @tparam T The sample type of the rings (float or double).
+ */
+template <typename T>
+class AsyncFileReader {
+public:
+    /**
+     * @brief Construct a reader.
+     *
+     * @param queue_depth The number of reads that may be in flight at once (across all files).
+     * @param chunk_bytes The size of each read (and of each staging buffer); a multiple of 4096.
+     * @param backend IngestBackend::IoUring to use io_uring when available, Pread to force the fallback.
+     * @throws std::invalid_argument if queue_depth is 0 or chunk_bytes is not a non-zero multiple of 4096.
+     */
+    AsyncFileReader(size_t queue_depth = 32, size_t chunk_bytes = 1 << 16, IngestBackend backend = IngestBackend::IoUring);
+
+    ~AsyncFileReader();
+
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+    /**
+     * @brief Adds a WAV file (same formats as MappedFileSource).
+     *
+     * @param path The file to read.
+     * @param target The ring to fill. Must outlive the reader and have the file's channel count.
+     * @return The stream index used by the per-stream getters.
+     * @throws std::runtime_error if the file cannot be opened or parsed.
+     * @throws std::invalid_argument if the channel count differs or one frame exceeds chunk_bytes.
+     */
+    size_t addFile(const std::string& path, FramingRingBuffer2D<T>& target);
+
+    /**
+     * @brief Adds a headerless (raw) interleaved file.
+     * @throws std::runtime_error if the file cannot be opened.
+     * @throws std::invalid_argument if the channel count differs or one frame exceeds chunk_bytes.
+     */
+    size_t addFile(const std::string& path, FramingRingBuffer2D<T>& target, SampleFormat format, size_t num_channels,
+                   size_t header_bytes = 0);
+
+    /**
+     * @brief Publishes completed reads and queues new ones.
+     *
+     * @param wait If true and nothing could be published yet, blocks until at least one read completes.
+     * @return The number of frames (samples per channel) committed to the rings by this call.
+     * @throws std::runtime_error if a read failed.
+     */
+    size_t poll(bool wait = false);
+
+    /**
+     * @brief Returns true once every frame of the stream has been committed to its ring.
+     * @throws std::out_of_range if stream is out of range.
+     */
+    bool isFinished(size_t stream) const;
+    bool allFinished() const;
+
+    /**
+     * @brief Returns the number of frames of the stream committed so far.
+     * @throws std::out_of_range if stream is out of range.
+     */
+    size_t getFramesPublished(size_t stream) const;
+    size_t getTotalFrames(size_t stream) const;
+
+    size_t getNumStreams() const;
+    size_t getReadsInFlight() const;
+    IngestBackend getBackend() const;
+    size_t getQueueDepth() const;
+    size_t getChunkBytes() const;
+
+private:
+    struct Stream {
+        std::string path;
+        int fd;
+        FramingRingBuffer2D<T>* target;
+        SampleFormat format;
+        size_t num_channels;
+        size_t frame_bytes;
+        size_t data_offset;
+        size_t total_frames;
+        size_t submitted_frames;  // Frames covered by queued or completed reads
+        size_t published_frames;  // Frames committed to the ring
+        size_t in_flight_frames;  // submitted - published
+        bool direct;              // Reads land in ring storage
+        std::deque<size_t> order; // Slots in file order
+    };
+
+    struct Slot {
+        size_t stream;
+        std::uint64_t file_offset;
+        size_t frames;
+        size_t bytes;
+        size_t done_bytes;
+        std::uint8_t* dest;
+        bool busy;
+        bool complete;
+        struct iovec iov;         // Destination of a direct read
+    };
+
+    size_t openStream(const std::string& path, FramingRingBuffer2D<T>& target, SampleFormat format, size_t num_channels,
+                      size_t data_offset, size_t data_bytes, int fd);
+    void submitReads();
+    bool submitRead(size_t stream);
+    void issue(size_t slot_index);
+    size_t reap();
+    size_t publish();
+    void checkStream(size_t stream) const;
+
+    size_t m_queue_depth;
+    size_t m_chunk_bytes;
+    IngestBackend m_backend;
+    std::uint8_t* m_staging;      // queue_depth * chunk_bytes, page-aligned
+    std::vector<Slot> m_slots;
+    std::vector<size_t> m_free_slots;
+    std::vector<Stream> m_streams;
+    size_t m_next_stream;         // Round-robin start for submissions
+    size_t m_in_flight;
+    bool m_fixed_buffers;
+    std::vector<RingSpan<T>> m_spans;
+    std::vector<T*> m_dst;
+#if defined(JABUFF_HAS_IO_URING)
+    detail::IoUring m_ring;
+#endif
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+AsyncFileReader<T>::AsyncFileReader(size_t queue_depth, size_t chunk_bytes, IngestBackend backend)
+    : m_queue_depth(queue_depth),
+      m_chunk_bytes(chunk_bytes),
+      m_backend(IngestBackend::Pread),
+      m_staging(nullptr),
+      m_next_stream(0),
+      m_in_flight(0),
+      m_fixed_buffers(false) {
+
+    if (queue_depth == 0) {
+        throw std::invalid_argument("Queue depth must be non-zero.");
+    }
+    if (chunk_bytes == 0 || chunk_bytes % 4096 != 0) {
+        throw std::invalid_argument("Chunk size (" + std::to_string(chunk_bytes) + ") must be a non-zero multiple of 4096.");
+    }
+
+    void* staging = nullptr;
+    if (posix_memalign(&staging, 4096, m_queue_depth * m_chunk_bytes) != 0) throw std::bad_alloc();
+    m_staging = static_cast<std::uint8_t*>(staging);
+
+    m_slots.resize(m_queue_depth);
+    for (size_t i = 0; i < m_queue_depth; ++i) {
+        m_slots[i].busy = false;
+        m_free_slots.push_back(m_queue_depth - 1 - i);
+    }
+
+#if defined(JABUFF_HAS_IO_URING)
+    if (backend == IngestBackend::IoUring && m_ring.init(static_cast<unsigned>(m_queue_depth))) {
+        m_backend = IngestBackend::IoUring;
+        // Registered buffers spare the kernel from mapping the staging pages on every read.
+        std::vector<struct iovec> buffers(m_queue_depth);
+        for (size_t i = 0; i < m_queue_depth; ++i) {
+            buffers[i].iov_base = m_staging + i * m_chunk_bytes;
+            buffers[i].iov_len = m_chunk_bytes;
+        }
+        m_fixed_buffers = m_ring.registerBuffers(buffers.data(), static_cast<unsigned>(m_queue_depth));
+    }
+#else
+    (void)backend;
+#endif
+}
+
+template <typename T>
+AsyncFileReader<T>::~AsyncFileReader() {
+#if defined(JABUFF_HAS_IO_URING)
+    // The kernel may still write into the staging buffers / rings: wait for its outstanding reads.
+    size_t outstanding = 0;
+    for (const Slot& slot : m_slots) {
+        if (slot.busy && !slot.complete) ++outstanding;
+    }
+    while (outstanding > 0 && m_ring.submit(1)) {
+        std::uint64_t user_data;
+        int result;
+        while (m_ring.popCompletion(user_data, result)) {
+            Slot& slot = m_slots[static_cast<size_t>(user_data)];
+            if (slot.busy && !slot.complete) {
+                slot.complete = true;
+                --outstanding;
+            }
+        }
+    }
+#endif
+    for (Stream& stream : m_streams) {
+        if (stream.fd >= 0) ::close(stream.fd);
+    }
+    std::free(m_staging);
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::addFile(const std::string& path, FramingRingBuffer2D<T>& target) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open '" + path + "'.");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat '" + path + "'.");
+    }
+    const size_t file_size = static_cast<size_t>(st.st_size);
+
+    // The header is read synchronously; 64 KiB covers the fmt chunk and any usual padding.
+    std::vector<std::uint8_t> header(std::min<size_t>(file_size, 1 << 16));
+    ssize_t got = header.empty() ? 0 : ::pread(fd, header.data(), header.size(), 0);
+    if (got < 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read '" + path + "'.");
+    }
+
+    detail::WavLayout layout;
+    try {
+        layout = detail::parseWavHeader(header.data(), static_cast<size_t>(got), file_size, path);
+        return openStream(path, target, layout.format, layout.num_channels, layout.data_offset, layout.data_bytes, fd);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::addFile(const std::string& path, FramingRingBuffer2D<T>& target, SampleFormat format, size_t num_channels,
+                                   size_t header_bytes) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open '" + path + "'.");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat '" + path + "'.");
+    }
+    const size_t file_size = static_cast<size_t>(st.st_size);
+    const size_t offset = std::min(header_bytes, file_size);
+
+    try {
+        return openStream(path, target, format, num_channels, offset, file_size - offset, fd);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::openStream(const std::string& path, FramingRingBuffer2D<T>& target, SampleFormat format, size_t num_channels,
+                                      size_t data_offset, size_t data_bytes, int fd) {
+    if (num_channels == 0 || target.getNumChannels() != num_channels) {
+        throw std::invalid_argument("Ring channel count (" + std::to_string(target.getNumChannels()) +
+                                    ") does not match '" + path + "' (" + std::to_string(num_channels) + ").");
+    }
+    const size_t frame_bytes = detail::bytesPerSample(format) * num_channels;
+    if (frame_bytes > m_chunk_bytes) {
+        throw std::invalid_argument("One frame of '" + path + "' (" + std::to_string(frame_bytes) + " bytes) exceeds the chunk size.");
+    }
+
+    Stream stream;
+    stream.path = path;
+    stream.fd = fd;
+    stream.target = &target;
+    stream.format = format;
+    stream.num_channels = num_channels;
+    stream.frame_bytes = frame_bytes;
+    stream.data_offset = data_offset;
+    stream.total_frames = data_bytes / frame_bytes;
+    stream.submitted_frames = 0;
+    stream.published_frames = 0;
+    stream.in_flight_frames = 0;
+    stream.direct = num_channels == 1 &&
+                    ((format == SampleFormat::Float32 && std::is_same<T, float>::value) ||
+                     (format == SampleFormat::Float64 && std::is_same<T, double>::value));
+    m_streams.push_back(std::move(stream));
+    return m_streams.size() - 1;
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::poll(bool wait) {
+    size_t published = publish();
+    submitReads();
+
+#if defined(JABUFF_HAS_IO_URING)
+    if (m_backend == IngestBackend::IoUring) {
+        unsigned wait_nr = (wait && published == 0 && m_in_flight > 0) ? 1 : 0;
+        if (!m_ring.submit(wait_nr)) {
+            throw std::runtime_error("io_uring submission failed.");
+        }
+        reap();
+    }
+#else
+    (void)wait;
+#endif
+
+    return published + publish();
+}
+
+template <typename T>
+void AsyncFileReader<T>::submitReads() {
+    // One read per stream per round, so one long file cannot take every slot.
+    const size_t count = m_streams.size();
+    bool progress = true;
+    while (progress && !m_free_slots.empty()) {
+        progress = false;
+        for (size_t k = 0; k < count && !m_free_slots.empty(); ++k) {
+            if (submitRead((m_next_stream + k) % count)) progress = true;
+        }
+    }
+    if (count > 0) m_next_stream = (m_next_stream + 1) % count;
+}
+
+template <typename T>
+bool AsyncFileReader<T>::submitRead(size_t s) {
+    Stream& stream = m_streams[s];
+    if (stream.submitted_frames >= stream.total_frames) return false;
+
+    FramingRingBuffer2D<T>& ring = *stream.target;
+    const size_t writable = ring.getAvailableWrite();
+    if (writable <= stream.in_flight_frames) return false;
+
+    size_t frames = std::min(stream.total_frames - stream.submitted_frames, writable - stream.in_flight_frames);
+    frames = std::min(frames, m_chunk_bytes / stream.frame_bytes);
+
+    std::uint8_t* dest = nullptr;
+    if (stream.direct) {
+        // Target the free space right after the reads already in flight; stop at the ring wrap.
+        ring.reserve(stream.in_flight_frames + frames, m_spans);
+        const RingSpan<T>& span = m_spans[0];
+        if (stream.in_flight_frames < span.first_size) {
+            frames = std::min(frames, span.first_size - stream.in_flight_frames);
+            dest = reinterpret_cast<std::uint8_t*>(span.first + stream.in_flight_frames);
+        } else {
+            dest = reinterpret_cast<std::uint8_t*>(span.second + (stream.in_flight_frames - span.first_size));
+        }
+    }
+
+    const size_t slot_index = m_free_slots.back();
+    m_free_slots.pop_back();
+    Slot& slot = m_slots[slot_index];
+    slot.stream = s;
+    slot.file_offset = stream.data_offset + static_cast<std::uint64_t>(stream.submitted_frames) * stream.frame_bytes;
+    slot.frames = frames;
+    slot.bytes = frames * stream.frame_bytes;
+    slot.done_bytes = 0;
+    slot.dest = stream.direct ? dest : m_staging + slot_index * m_chunk_bytes;
+    slot.busy = true;
+    slot.complete = false;
+
+    stream.submitted_frames += frames;
+    stream.in_flight_frames += frames;
+    stream.order.push_back(slot_index);
+    ++m_in_flight;
+    issue(slot_index);
+    return true;
+}
+
+template <typename T>
+void AsyncFileReader<T>::issue(size_t slot_index) {
+    Slot& slot = m_slots[slot_index];
+    const Stream& stream = m_streams[slot.stream];
+    std::uint8_t* dest = slot.dest + slot.done_bytes;
+    const size_t bytes = slot.bytes - slot.done_bytes;
+    const std::uint64_t offset = slot.file_offset + slot.done_bytes;
+
+#if defined(JABUFF_HAS_IO_URING)
+    if (m_backend == IngestBackend::IoUring) {
+        io_uring_sqe* sqe = m_ring.getSqe();
+        if (sqe == nullptr) {
+            // Queue depth == ring entries, so this only happens if the kernel is slow to consume.
+            m_ring.submit(0);
+            sqe = m_ring.getSqe();
+        }
+        if (sqe != nullptr) {
+            sqe->fd = stream.fd;
+            sqe->off = offset;
+            sqe->user_data = slot_index;
+            if (!stream.direct && m_fixed_buffers) {
+                sqe->opcode = IORING_OP_READ_FIXED;
+                sqe->addr = reinterpret_cast<std::uint64_t>(dest);
+                sqe->len = static_cast<std::uint32_t>(bytes);
+                sqe->buf_index = static_cast<std::uint16_t>(slot_index);
+            } else {
+                slot.iov.iov_base = dest;
+                slot.iov.iov_len = bytes;
+                sqe->opcode = IORING_OP_READV;
+                sqe->addr = reinterpret_cast<std::uint64_t>(&slot.iov);
+                sqe->len = 1;
+            }
+            return;
+        }
+        // Fall through to a blocking read rather than lose the request.
+    }
+#endif
+
+    size_t done = 0;
+    while (done < bytes) {
+        ssize_t n = ::pread(stream.fd, dest + done, bytes - done, static_cast<off_t>(offset + done));
+        if (n <= 0) {
+            throw std::runtime_error("Reading '" + stream.path + "' failed.");
+        }
+        done += static_cast<size_t>(n);
+    }
+    slot.done_bytes = slot.bytes;
+    slot.complete = true;
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::reap() {
+    size_t completed = 0;
+#if defined(JABUFF_HAS_IO_URING)
+    std::uint64_t user_data;
+    int result;
+    bool reissued = false;
+    while (m_ring.popCompletion(user_data, result)) {
+        const size_t slot_index = static_cast<size_t>(user_data);
+        Slot& slot = m_slots[slot_index];
+        if (result <= 0) {
+            throw std::runtime_error("Reading '" + m_streams[slot.stream].path + "' failed (" + std::to_string(-result) + ").");
+        }
+        slot.done_bytes += static_cast<size_t>(result);
+        if (slot.done_bytes < slot.bytes) {
+            issue(slot_index); // Short read: queue the remainder
+            reissued = true;
+        } else {
+            slot.complete = true;
+            ++completed;
+        }
+    }
+    if (reissued) m_ring.submit(0);
+#endif
+    return completed;
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::publish() {
+    size_t published = 0;
+    for (Stream& stream : m_streams) {
+        while (!stream.order.empty() && m_slots[stream.order.front()].complete) {
+            const size_t slot_index = stream.order.front();
+            Slot& slot = m_slots[slot_index];
+            FramingRingBuffer2D<T>& ring = *stream.target;
+
+            if (!stream.direct) {
+                // Staged: convert / deinterleave into the reserved space (at most two runs).
+                ring.reserve(slot.frames, m_spans);
+                m_dst.resize(stream.num_channels);
+                const size_t first = m_spans[0].first_size;
+                for (size_t c = 0; c < stream.num_channels; ++c) m_dst[c] = m_spans[c].first;
+                detail::convertInterleaved(stream.format, stream.num_channels, m_dst.data(), slot.dest, first);
+                if (first < slot.frames) {
+                    for (size_t c = 0; c < stream.num_channels; ++c) m_dst[c] = m_spans[c].second;
+                    detail::convertInterleaved(stream.format, stream.num_channels, m_dst.data(), slot.dest + first * stream.frame_bytes,
+                                               slot.frames - first);
+                }
+            }
+            ring.commit(slot.frames);
+
+            stream.published_frames += slot.frames;
+            stream.in_flight_frames -= slot.frames;
+            published += slot.frames;
+            stream.order.pop_front();
+            slot.busy = false;
+            slot.complete = false;
+            m_free_slots.push_back(slot_index);
+            --m_in_flight;
+        }
+    }
+    return published;
+}
+
+template <typename T>
+void AsyncFileReader<T>::checkStream(size_t stream) const {
+    if (stream >= m_streams.size()) {
+        throw std::out_of_range("Stream " + std::to_string(stream) + " out of range (" + std::to_string(m_streams.size()) + " streams).");
+    }
+}
+
+template <typename T>
+bool AsyncFileReader<T>::isFinished(size_t stream) const {
+    checkStream(stream);
+    return m_streams[stream].published_frames >= m_streams[stream].total_frames;
+}
+
+template <typename T>
+bool AsyncFileReader<T>::allFinished() const {
+    for (const Stream& stream : m_streams) {
+        if (stream.published_frames < stream.total_frames) return false;
+    }
+    return true;
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::getFramesPublished(size_t stream) const {
+    checkStream(stream);
+    return m_streams[stream].published_frames;
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::getTotalFrames(size_t stream) const {
+    checkStream(stream);
+    return m_streams[stream].total_frames;
+}
+
+template <typename T>
+size_t AsyncFileReader<T>::getNumStreams() const { return m_streams.size(); }
+
+template <typename T>
+size_t AsyncFileReader<T>::getReadsInFlight() const { return m_in_flight; }
+
+template <typename T>
+IngestBackend AsyncFileReader<T>::getBackend() const { return m_backend; }
+
+template <typename T>
+size_t AsyncFileReader<T>::getQueueDepth() const { return m_queue_depth; }
+
+template <typename T>
+size_t AsyncFileReader<T>::getChunkBytes() const { return m_chunk_bytes; }
+
+} // namespace JABuff
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <cstddef>      // For size_t
+#include <string>       // For std::to_string
+#include <cmath>        // For std::log10, std::pow, std::abs
+
+namespace JABuff {
+
+/**
+ * @brief A row-banded sparse matrix for projecting feature vectors (y = M * x).
+ *
+ * Each output row stores only its non-zero band [start, start + length) of input
+ * columns, and all bands are packed back to back in one coefficient array. apply()
+ * therefore walks the coefficients linearly and reads each input band
+ * contiguously, which suits filterbanks (mel, bark) where every row covers a
+ * short run of bins. Dense matrices (e.g. PCA) are the special case of one
+ * full-width band per row.
+ *
+ * Used by FramingRingBuffer3D::setReadProjection() and setWriteProjection().
+ *
+ * @tparam T The scalar type.
+ */
+template <typename T>
+class BandedMatrix {
+public:
+    BandedMatrix() = default;
+
+    /**
+     * @brief Construct an all-zero matrix of the given shape.
+     * @param output_dim The number of rows (size of y).
+     * @param input_dim The number of columns (size of x).
+     * @throws std::invalid_argument if either dimension is zero.
+     */
+    BandedMatrix(size_t output_dim, size_t input_dim);
+
+    /**
+     * @brief Sets the band of one row, replacing any previous band.
+     * @param row The output row.
+     * @param start The first input column of the band.
+     * @param coefficients The band values; columns [start, start + size).
+     * @throws std::out_of_range if the row or band is out of range.
+     */
+    void setRow(size_t row, size_t start, const std::vector<T>& coefficients);
+
+    /**
+     * @brief Builds a banded matrix from a dense one [output][input].
+     *
+     * Each row keeps the span from its first to its last entry with |value| > threshold.
+     *
+     * @throws std::invalid_argument if the matrix is empty or ragged.
+     */
+    static BandedMatrix fromDense(const std::vector<std::vector<T>>& dense, T threshold = 0);
+
+    /**
+     * @brief Builds a triangular mel filterbank (HTK mel scale, unnormalised).
+     *
+     * @param num_bins The number of FFT bins (fft_size / 2 + 1), i.e. the input dimension.
+     * @param num_mels The number of mel bands, i.e. the output dimension.
+     * @param sample_rate The sample rate in Hz.
+     * @param f_min The lower edge of the first band in Hz.
+     * @param f_max The upper edge of the last band in Hz (0 = Nyquist).
+     * @throws std::invalid_argument on an invalid configuration.
+     */
+    static BandedMatrix melFilterbank(size_t num_bins, size_t num_mels, double sample_rate, double f_min = 0.0, double f_max = 0.0);
+
+    /**
+     * @brief Computes y = M * x.
+     * @param x Input of size getInputDim().
+     * @param y Output of size getOutputDim(). Must not alias x.
+     */
+    void apply(const T* x, T* y) const;
+
+    size_t getOutputDim() const { return m_output_dim; }
+    size_t getInputDim() const { return m_input_dim; }
+    size_t getNonZeros() const { return m_coefficients.size(); }
+    bool empty() const { return m_output_dim == 0; }
+
+private:
+    size_t m_output_dim = 0;
+    size_t m_input_dim = 0;
+    std::vector<size_t> m_row_start;  // [row] first input column
+    std::vector<size_t> m_row_length; // [row] band length
+    std::vector<size_t> m_row_offset; // [row + 1] offsets into m_coefficients
+    std::vector<T> m_coefficients;    // All bands, packed row by row
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+BandedMatrix<T>::BandedMatrix(size_t output_dim, size_t input_dim)
+    : m_output_dim(output_dim),
+      m_input_dim(input_dim),
+      m_row_start(output_dim, 0),
+      m_row_length(output_dim, 0),
+      m_row_offset(output_dim + 1, 0) {
+
+    if (output_dim == 0 || input_dim == 0) {
+        throw std::invalid_argument("BandedMatrix dimensions must be non-zero.");
+    }
+}
+
+template <typename T>
+void BandedMatrix<T>::setRow(size_t row, size_t start, const std::vector<T>& coefficients) {
+    if (row >= m_output_dim) {
+        throw std::out_of_range("Row " + std::to_string(row) + " out of range.");
+    }
+    if (start + coefficients.size() > m_input_dim) {
+        throw std::out_of_range("Band [" + std::to_string(start) + ", " + std::to_string(start + coefficients.size()) +
+                                ") exceeds input dimension " + std::to_string(m_input_dim) + ".");
+    }
+
+    // Splice the new band into the packed array and shift the following offsets.
+    size_t old_length = m_row_length[row];
+    size_t offset = m_row_offset[row];
+    m_coefficients.erase(m_coefficients.begin() + static_cast<std::ptrdiff_t>(offset),
+                         m_coefficients.begin() + static_cast<std::ptrdiff_t>(offset + old_length));
+    m_coefficients.insert(m_coefficients.begin() + static_cast<std::ptrdiff_t>(offset), coefficients.begin(), coefficients.end());
+
+    m_row_start[row] = start;
+    m_row_length[row] = coefficients.size();
+    for (size_t r = row + 1; r <= m_output_dim; ++r) {
+        m_row_offset[r] = m_row_offset[r] - old_length + coefficients.size();
+    }
+}
+
+template <typename T>
+BandedMatrix<T> BandedMatrix<T>::fromDense(const std::vector<std::vector<T>>& dense, T threshold) {
+    if (dense.empty() || dense[0].empty()) {
+        throw std::invalid_argument("Dense matrix must be non-empty.");
+    }
+
+    BandedMatrix<T> m(dense.size(), dense[0].size());
+    for (size_t r = 0; r < dense.size(); ++r) {
+        if (dense[r].size() != m.m_input_dim) {
+            throw std::invalid_argument("Dense matrix row " + std::to_string(r) + " has the wrong size.");
+        }
+        size_t first = m.m_input_dim;
+        size_t last = 0;
+        for (size_t k = 0; k < m.m_input_dim; ++k) {
+            if (std::abs(dense[r][k]) > threshold) {
+                if (first == m.m_input_dim) first = k;
+                last = k;
+            }
+        }
+        if (first == m.m_input_dim) continue; // All-zero row
+
+        m.m_row_start[r] = first;
+        m.m_row_length[r] = last - first + 1;
+        m.m_coefficients.insert(m.m_coefficients.end(), dense[r].begin() + static_cast<std::ptrdiff_t>(first),
+                                dense[r].begin() + static_cast<std::ptrdiff_t>(last + 1));
+    }
+    for (size_t r = 0; r < m.m_output_dim; ++r) {
+        m.m_row_offset[r + 1] = m.m_row_offset[r] + m.m_row_length[r];
+    }
+    return m;
+}
+
+template <typename T>
+BandedMatrix<T> BandedMatrix<T>::melFilterbank(size_t num_bins, size_t num_mels, double sample_rate, double f_min, double f_max) {
+    if (num_bins < 2 || num_mels == 0 || sample_rate <= 0.0) {
+        throw std::invalid_argument("Mel filterbank needs num_bins >= 2, num_mels > 0 and a positive sample rate.");
+    }
+    double nyquist = sample_rate / 2.0;
+    if (f_max <= 0.0) f_max = nyquist;
+    if (f_min < 0.0 || f_min >= f_max || f_max > nyquist) {
+        throw std::invalid_argument("Mel filterbank needs 0 <= f_min < f_max <= sample_rate / 2.");
+    }
+
+    auto hz_to_mel = [](double hz) { return 2595.0 * std::log10(1.0 + hz / 700.0); };
+    auto mel_to_hz = [](double mel) { return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0); };
+
+    // num_mels + 2 equally spaced mel points give each band's left, centre and right edge.
+    std::vector<double> edges(num_mels + 2);
+    double mel_min = hz_to_mel(f_min);
+    double mel_max = hz_to_mel(f_max);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        edges[i] = mel_to_hz(mel_min + (mel_max - mel_min) * static_cast<double>(i) / static_cast<double>(num_mels + 1));
+    }
+
+    double bin_hz = nyquist / static_cast<double>(num_bins - 1);
+    std::vector<std::vector<T>> dense(num_mels, std::vector<T>(num_bins, static_cast<T>(0)));
+    for (size_t m = 0; m < num_mels; ++m) {
+        double left = edges[m], centre = edges[m + 1], right = edges[m + 2];
+        for (size_t k = 0; k < num_bins; ++k) {
+            double f = static_cast<double>(k) * bin_hz;
+            double w = 0.0;
+            if (f > left && f < right) {
+                w = (f <= centre) ? (f - left) / (centre - left) : (right - f) / (right - centre);
+            }
+            dense[m][k] = static_cast<T>(w);
+        }
+    }
+    return fromDense(dense);
+}
+
+template <typename T>
+void BandedMatrix<T>::apply(const T* x, T* y) const {
+    const T* coeff = m_coefficients.data();
+    for (size_t r = 0; r < m_output_dim; ++r) {
+        const T* in = x + m_row_start[r];
+        const size_t length = m_row_length[r];
+        T acc = 0;
+        for (size_t k = 0; k < length; ++k) {
+            acc += coeff[k] * in[k];
+        }
+        y[r] = acc;
+        coeff += length;
+    }
+}
+
+} // namespace JABuff
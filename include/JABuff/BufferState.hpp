@@ -0,0 +1,249 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::runtime_error
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstring>      // For std::memcpy, std::memcmp
+#include <string>       // For std::string, std::to_string
+#include <algorithm>    // For std::min
+#include <type_traits>  // For std::is_floating_point, std::is_integral, std::is_signed
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>    // For writev, struct iovec
+#include <climits>      // For IOV_MAX
+#define JABUFF_HAS_WRITEV 1
+#endif
+
+#include "FeatureStorage.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief One piece of a snapshot: size bytes at data (same fields as a POSIX iovec).
+ *
+ * saveState(std::vector<StateSegment>&) describes a snapshot as a list of segments
+ * that point into the buffer itself, so many sessions can be gathered into one
+ * writev() without first copying their samples together.
+ */
+struct StateSegment {
+    const void* data;
+    size_t size;
+};
+
+/**
+ * @brief Returns the total number of bytes described by segments.
+ */
+inline size_t getStateSize(const std::vector<StateSegment>& segments) {
+    size_t total = 0;
+    for (const StateSegment& segment : segments) total += segment.size;
+    return total;
+}
+
+/**
+ * @brief Concatenates segments onto out.
+ */
+inline void appendState(const std::vector<StateSegment>& segments, std::vector<std::uint8_t>& out) {
+    size_t pos = out.size();
+    out.resize(pos + getStateSize(segments));
+    for (const StateSegment& segment : segments) {
+        if (segment.size == 0) continue;
+        std::memcpy(out.data() + pos, segment.data, segment.size);
+        pos += segment.size;
+    }
+}
+
+#if defined(JABUFF_HAS_WRITEV)
+/**
+ * @brief Writes segments to a file descriptor with as few writev() calls as possible.
+ * @return true if every byte was written.
+ */
+inline bool writeState(int fd, const std::vector<StateSegment>& segments) {
+    std::vector<struct iovec> iov;
+    iov.reserve(segments.size());
+    for (const StateSegment& segment : segments) {
+        if (segment.size == 0) continue;
+        struct iovec v;
+        v.iov_base = const_cast<void*>(segment.data);
+        v.iov_len = segment.size;
+        iov.push_back(v);
+    }
+
+    size_t first = 0;
+    while (first < iov.size()) {
+        int n = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+        ssize_t written = ::writev(fd, iov.data() + first, n);
+        if (written <= 0) return false;
+
+        // Skip what was written; a short write leaves the rest of a segment pending.
+        size_t left = static_cast<size_t>(written);
+        while (first < iov.size() && left >= iov[first].iov_len) {
+            left -= iov[first].iov_len;
+            ++first;
+        }
+        if (left > 0) {
+            iov[first].iov_base = static_cast<std::uint8_t*>(iov[first].iov_base) + left;
+            iov[first].iov_len -= left;
+        }
+    }
+    return true;
+}
+#endif
+
+namespace detail {
+
+// Snapshot layout (host byte order):
+//   char[4]  magic        identifies the class ("JB2D", "JB3D", "JOLA")
+//   uint32   version      kStateVersion
+//   uint32   sample_bytes sizeof the stored sample type
+//   uint32   sample_type  StateSampleType of the stored sample type
+//   uint32   field_count  number of uint64 fields that follow
+//   uint32   reserved     zero
+//   uint64   total_bytes  size of the whole snapshot, header included
+//   uint64[field_count]   class-specific geometry and cursors
+//   ...                   class-specific sample payload
+constexpr std::uint32_t kStateVersion = 2;
+constexpr size_t kStatePreambleBytes = 4 + 4 + 4 + 4 + 4 + 4 + 8;
+
+// Identifies how stored samples are encoded, so equally sized types
+// (float / int32, Float16 / BFloat16) are not confused on load.
+enum class StateSampleType : std::uint32_t {
+    Other = 0,
+    Float = 1,
+    SignedInt = 2,
+    UnsignedInt = 3,
+    Float16 = 4,
+    BFloat16 = 5,
+    QInt8 = 6
+};
+
+template <typename E>
+struct StateSampleTypeOf {
+    static constexpr StateSampleType value =
+        std::is_floating_point<E>::value ? StateSampleType::Float :
+        std::is_integral<E>::value ? (std::is_signed<E>::value ? StateSampleType::SignedInt : StateSampleType::UnsignedInt) :
+        StateSampleType::Other;
+};
+template <> struct StateSampleTypeOf<Float16>  { static constexpr StateSampleType value = StateSampleType::Float16; };
+template <> struct StateSampleTypeOf<BFloat16> { static constexpr StateSampleType value = StateSampleType::BFloat16; };
+template <> struct StateSampleTypeOf<QInt8>    { static constexpr StateSampleType value = StateSampleType::QInt8; };
+
+// Builds the header of a snapshot.
+class StateHeaderWriter {
+public:
+    StateHeaderWriter(std::vector<std::uint8_t>& bytes, const char* magic, size_t sample_bytes, StateSampleType sample_type)
+        : m_bytes(bytes) {
+        m_bytes.assign(kStatePreambleBytes, 0);
+        std::memcpy(m_bytes.data(), magic, 4);
+        putAt(4, kStateVersion);
+        putAt(8, static_cast<std::uint32_t>(sample_bytes));
+        putAt(12, static_cast<std::uint32_t>(sample_type));
+    }
+
+    void put(std::uint64_t value) {
+        size_t pos = m_bytes.size();
+        m_bytes.resize(pos + sizeof(value));
+        std::memcpy(m_bytes.data() + pos, &value, sizeof(value));
+        ++m_fields;
+    }
+
+    // Completes the header once the payload size is known.
+    void finish(size_t payload_bytes) {
+        putAt(16, m_fields);
+        std::uint64_t total = static_cast<std::uint64_t>(m_bytes.size() + payload_bytes);
+        std::memcpy(m_bytes.data() + 24, &total, sizeof(total));
+    }
+
+private:
+    void putAt(size_t pos, std::uint32_t value) { std::memcpy(m_bytes.data() + pos, &value, sizeof(value)); }
+
+    std::vector<std::uint8_t>& m_bytes;
+    std::uint32_t m_fields = 0;
+};
+
+// Validates and walks a snapshot.
+class StateReader {
+public:
+    StateReader(const void* data, size_t size, const char* magic, size_t sample_bytes, StateSampleType sample_type,
+                std::uint32_t field_count)
+        : m_data(static_cast<const std::uint8_t*>(data)), m_size(size), m_pos(kStatePreambleBytes) {
+        if (m_data == nullptr || m_size < kStatePreambleBytes || std::memcmp(m_data, magic, 4) != 0) {
+            throw std::runtime_error("Not a " + std::string(magic, 4) + " snapshot.");
+        }
+        std::uint32_t version = getAt(4);
+        if (version != kStateVersion) {
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(version) + ".");
+        }
+        if (getAt(8) != sample_bytes) {
+            throw std::runtime_error("Snapshot sample size (" + std::to_string(getAt(8)) + " bytes) does not match the buffer (" +
+                                     std::to_string(sample_bytes) + " bytes).");
+        }
+        if (getAt(12) != static_cast<std::uint32_t>(sample_type)) {
+            throw std::runtime_error("Snapshot sample type (" + std::to_string(getAt(12)) + ") does not match the buffer (" +
+                                     std::to_string(static_cast<std::uint32_t>(sample_type)) + ").");
+        }
+        if (getAt(16) != field_count) {
+            throw std::runtime_error("Snapshot header is malformed.");
+        }
+        std::uint64_t total;
+        std::memcpy(&total, m_data + 24, sizeof(total));
+        if (total > m_size || total < kStatePreambleBytes + field_count * sizeof(std::uint64_t)) {
+            throw std::runtime_error("Snapshot is truncated (" + std::to_string(m_size) + " of " + std::to_string(total) + " bytes).");
+        }
+        m_size = static_cast<size_t>(total);
+    }
+
+    std::uint64_t get() {
+        std::uint64_t value;
+        std::memcpy(&value, take(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    const std::uint8_t* take(size_t bytes) {
+        if (bytes > m_size - m_pos) {
+            throw std::runtime_error("Snapshot payload is shorter than its header describes.");
+        }
+        const std::uint8_t* p = m_data + m_pos;
+        m_pos += bytes;
+        return p;
+    }
+
+    // Checks that the payload was consumed exactly; returns the snapshot size.
+    size_t finish() const {
+        if (m_pos != m_size) {
+            throw std::runtime_error("Snapshot payload is longer than its header describes.");
+        }
+        return m_size;
+    }
+
+private:
+    std::uint32_t getAt(size_t pos) const {
+        std::uint32_t value;
+        std::memcpy(&value, m_data + pos, sizeof(value));
+        return value;
+    }
+
+    const std::uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos;
+};
+
+// Appends the (up to two) segments covering count elements of a ring starting at start.
+template <typename E>
+inline void appendRingSegments(const E* ring, size_t capacity, size_t start, size_t count, std::vector<StateSegment>& segments) {
+    size_t first = std::min(count, capacity - start);
+    if (first > 0) segments.push_back({ring + start, first * sizeof(E)});
+    if (count > first) segments.push_back({ring, (count - first) * sizeof(E)});
+}
+
+// Copies count elements from src into a ring starting at start, wrapping around.
+template <typename E>
+inline void copyIntoRing(E* ring, size_t capacity, size_t start, const std::uint8_t* src, size_t count) {
+    size_t first = std::min(count, capacity - start);
+    std::memcpy(ring + start, src, first * sizeof(E));
+    std::memcpy(ring, src + first * sizeof(E), (count - first) * sizeof(E));
+}
+
+} // namespace detail
+
+} // namespace JABuff
@@ -0,0 +1,526 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument, std::runtime_error
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t
+#include <cstdlib>      // For std::free, std::malloc, posix_memalign
+#include <new>          // For std::bad_alloc
+#include <cstring>      // For std::memcpy
+#include <string>       // For std::string, std::to_string
+#include <algorithm>    // For std::min
+#include <atomic>       // For std::atomic
+#include <chrono>       // For std::chrono::steady_clock, std::chrono::milliseconds
+#include <thread>       // For std::thread, std::this_thread::sleep_for
+#include <type_traits>  // For std::is_floating_point
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>      // For open
+#include <unistd.h>     // For pwrite, close
+#define JABUFF_HAS_PWRITE 1
+#else
+#include <cstdio>       // For std::FILE, std::fopen, std::fseek, std::fwrite (fallback)
+#endif
+
+#include "FramingRingBuffer2D.hpp"
+#include "OLARingBuffer2D.hpp"
+#include "WriteObserver.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief File formats written by DiskTap.
+ */
+enum class TapFormat {
+    Wav,            // IEEE float WAV (32- or 64-bit), interleaved; blocks are concatenated
+    RawTimestamped  // Sequence of TapRecordHeader + channel-planar samples, one record per block
+};
+
+/**
+ * @brief Header preceding every block in a TapFormat::RawTimestamped file (host byte order).
+ *
+ * The header is followed by num_channels * count samples, channel after channel.
+ * A jump in position between consecutive records means blocks were dropped.
+ */
+struct TapRecordHeader {
+    std::uint64_t position;     // Index of the block's first sample since start()
+    std::uint64_t time_ns;      // steady_clock time of the write, in nanoseconds
+    std::uint32_t num_channels;
+    std::uint32_t count;        // Samples per channel
+};
+
+/**
+ * @brief Records everything written to a FramingRingBuffer2D or OLARingBuffer2D to disk.
+ *
+ * The tap attaches itself as a WriteObserver and is disabled until start().
+ * While recording, each written block costs the audio thread one memcpy per channel
+ * into a lock-free single-producer / single-consumer staging queue; nothing on that
+ * path allocates, locks or makes a system call. A background thread drains the
+ * queue, interleaves (WAV) or frames (raw) the blocks into a page-aligned batch
+ * buffer and writes it with one pwrite() per full batch at batch-aligned file offsets.
+ * The WAV header is padded to 4 KiB with a JUNK chunk so the sample data is aligned too.
+ *
+ * If the queue is full the block is dropped (never blocked on) and counted in
+ * getDroppedBlocks(); size the queue for the longest stall you expect from the disk.
+ * For an OLARingBuffer2D the tap records the resolved (spliced) output, as read() returns it.
+ *
+ * @tparam T The sample type of the buffer (float or double).
+ */
+template <typename T>
+class DiskTap : public WriteObserver<T> {
+    static_assert(std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "DiskTap writes IEEE float WAV and needs float or double samples.");
+
+public:
+    /**
+     * @brief Construct and attach to a framing buffer.
+     *
+     * @param buffer The buffer to record. Must outlive this object.
+     * @param path The file written by start(); truncated on every start().
+     * @param format The file format.
+     * @param sample_rate Written into the WAV header.
+     * @param queue_bytes Staging queue size (rounded up to a power of two).
+     * @param batch_bytes Bytes per write call; a multiple of 4096.
+     * @throws std::invalid_argument if batch_bytes is not a non-zero multiple of 4096 or the queue cannot hold one batch.
+     */
+    DiskTap(FramingRingBuffer2D<T>& buffer, const std::string& path, TapFormat format = TapFormat::Wav,
+            size_t sample_rate = 48000, size_t queue_bytes = 1 << 22, size_t batch_bytes = 1 << 18);
+
+    /**
+     * @brief Construct and attach to an OLA buffer (see the class notes).
+     */
+    DiskTap(OLARingBuffer2D<T>& buffer, const std::string& path, TapFormat format = TapFormat::Wav,
+            size_t sample_rate = 48000, size_t queue_bytes = 1 << 22, size_t batch_bytes = 1 << 18);
+
+    ~DiskTap() override;
+
+    DiskTap(const DiskTap&) = delete;
+    DiskTap& operator=(const DiskTap&) = delete;
+
+    void onWrite(const T* const* channels, size_t num_channels, size_t count) override;
+
+    /**
+     * @brief Opens (truncates) the file and starts recording. No effect if already recording.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    void start();
+
+    /**
+     * @brief Stops recording, writes out everything queued, finalises the header and closes the file.
+     * No effect if not recording.
+     * @throws std::runtime_error if a write failed while recording.
+     */
+    void stop();
+
+    bool isRecording() const;
+
+    /**
+     * @brief Returns the number of blocks dropped because the staging queue was full.
+     */
+    size_t getDroppedBlocks() const;
+
+    /**
+     * @brief Returns the number of samples per channel seen since start(), dropped ones included.
+     */
+    std::uint64_t getRecordedSamples() const;
+
+    size_t getNumChannels() const;
+    TapFormat getFormat() const;
+    const std::string& getPath() const;
+
+private:
+    static constexpr size_t kAlignment = 4096;
+    static constexpr size_t kWavHeaderBytes = 4096;
+
+    void init(size_t queue_bytes);
+    void workerLoop();
+    bool drain();
+    void append(const void* data, size_t bytes);
+    void writeBatch(size_t bytes);
+    void writeAt(const void* data, size_t bytes, std::uint64_t offset);
+    void writeWavHeader(std::uint64_t data_bytes);
+    void openFile();
+    void closeFile();
+
+    // Wrap-aware copies into / out of the staging queue
+    void pushBytes(size_t pos, const void* src, size_t bytes);
+    void popBytes(size_t pos, void* dst, size_t bytes) const;
+
+    FramingRingBuffer2D<T>* m_framing;
+    OLARingBuffer2D<T>* m_ola;
+    std::string m_path;
+    TapFormat m_format;
+    size_t m_num_channels;
+    size_t m_sample_rate;
+    size_t m_batch_bytes;
+
+    // Staging queue: m_head is written only by the audio thread, m_tail only by the worker
+    std::vector<std::uint8_t> m_queue;
+    size_t m_queue_mask;
+    std::atomic<std::uint64_t> m_head;
+    std::atomic<std::uint64_t> m_tail;
+
+    // Audio thread
+    std::atomic<bool> m_recording;
+    std::uint64_t m_position;
+    std::atomic<std::uint64_t> m_recorded;
+    std::atomic<size_t> m_dropped;
+
+    // Worker thread
+    std::uint8_t* m_batch;            // kAlignment-aligned, m_batch_bytes
+    size_t m_batch_fill;
+    std::uint64_t m_file_offset;      // Where the next batch goes
+    std::uint64_t m_data_bytes;       // Sample / record bytes written so far
+    std::vector<T> m_block;           // One dequeued block, channel-planar
+    std::vector<T> m_interleaved;
+    bool m_write_failed;
+#if defined(JABUFF_HAS_PWRITE)
+    int m_fd;
+#else
+    std::FILE* m_file;
+#endif
+
+    std::atomic<bool> m_stop;
+    std::thread m_worker;
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+DiskTap<T>::DiskTap(FramingRingBuffer2D<T>& buffer, const std::string& path, TapFormat format,
+                    size_t sample_rate, size_t queue_bytes, size_t batch_bytes)
+    : m_framing(&buffer),
+      m_ola(nullptr),
+      m_path(path),
+      m_format(format),
+      m_num_channels(buffer.getNumChannels()),
+      m_sample_rate(sample_rate),
+      m_batch_bytes(batch_bytes) {
+    init(queue_bytes);
+    m_framing->addObserver(this);
+}
+
+template <typename T>
+DiskTap<T>::DiskTap(OLARingBuffer2D<T>& buffer, const std::string& path, TapFormat format,
+                    size_t sample_rate, size_t queue_bytes, size_t batch_bytes)
+    : m_framing(nullptr),
+      m_ola(&buffer),
+      m_path(path),
+      m_format(format),
+      m_num_channels(buffer.getNumChannels()),
+      m_sample_rate(sample_rate),
+      m_batch_bytes(batch_bytes) {
+    init(queue_bytes);
+    m_ola->addObserver(this);
+}
+
+template <typename T>
+void DiskTap<T>::init(size_t queue_bytes) {
+    if (m_batch_bytes == 0 || m_batch_bytes % kAlignment != 0) {
+        throw std::invalid_argument("Batch size (" + std::to_string(m_batch_bytes) + ") must be a non-zero multiple of " +
+                                    std::to_string(kAlignment) + ".");
+    }
+    if (queue_bytes < m_batch_bytes) {
+        throw std::invalid_argument("Queue size (" + std::to_string(queue_bytes) + ") must hold at least one batch (" +
+                                    std::to_string(m_batch_bytes) + ").");
+    }
+
+    size_t capacity = 1;
+    while (capacity < queue_bytes) capacity <<= 1;
+    m_queue.assign(capacity, 0);
+    m_queue_mask = capacity - 1;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+
+    m_recording.store(false, std::memory_order_relaxed);
+    m_position = 0;
+    m_recorded.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+
+    m_batch = nullptr;
+    m_batch_fill = 0;
+    m_file_offset = 0;
+    m_data_bytes = 0;
+    m_write_failed = false;
+#if defined(JABUFF_HAS_PWRITE)
+    m_fd = -1;
+    void* batch = nullptr;
+    if (posix_memalign(&batch, kAlignment, m_batch_bytes) != 0) throw std::bad_alloc();
+    m_batch = static_cast<std::uint8_t*>(batch);
+#else
+    m_file = nullptr;
+    m_batch = static_cast<std::uint8_t*>(std::malloc(m_batch_bytes));
+    if (m_batch == nullptr) throw std::bad_alloc();
+#endif
+    m_stop.store(false, std::memory_order_relaxed);
+}
+
+template <typename T>
+DiskTap<T>::~DiskTap() {
+    if (m_framing) m_framing->removeObserver(this);
+    if (m_ola) m_ola->removeObserver(this);
+    try {
+        stop();
+    } catch (const std::runtime_error&) {
+        // Nothing sensible to report from a destructor.
+    }
+    std::free(m_batch);
+}
+
+template <typename T>
+void DiskTap<T>::pushBytes(size_t pos, const void* src, size_t bytes) {
+    size_t index = pos & m_queue_mask;
+    size_t first = std::min(bytes, m_queue.size() - index);
+    std::memcpy(m_queue.data() + index, src, first);
+    std::memcpy(m_queue.data(), static_cast<const std::uint8_t*>(src) + first, bytes - first);
+}
+
+template <typename T>
+void DiskTap<T>::popBytes(size_t pos, void* dst, size_t bytes) const {
+    size_t index = pos & m_queue_mask;
+    size_t first = std::min(bytes, m_queue.size() - index);
+    std::memcpy(dst, m_queue.data() + index, first);
+    std::memcpy(static_cast<std::uint8_t*>(dst) + first, m_queue.data(), bytes - first);
+}
+
+template <typename T>
+void DiskTap<T>::onWrite(const T* const* channels, size_t num_channels, size_t count) {
+    if (!m_recording.load(std::memory_order_acquire) || count == 0) return;
+
+    const std::uint64_t position = m_position;
+    m_position += count;
+    m_recorded.store(m_position, std::memory_order_relaxed);
+
+    const size_t channel_bytes = count * sizeof(T);
+    const size_t record_bytes = sizeof(TapRecordHeader) + num_channels * channel_bytes;
+    const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+    const std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+    if (record_bytes > m_queue.size() - static_cast<size_t>(head - tail)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TapRecordHeader header;
+    header.position = position;
+    header.time_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    header.num_channels = static_cast<std::uint32_t>(num_channels);
+    header.count = static_cast<std::uint32_t>(count);
+
+    size_t pos = static_cast<size_t>(head);
+    pushBytes(pos, &header, sizeof(header));
+    pos += sizeof(header);
+    for (size_t c = 0; c < num_channels; ++c) {
+        pushBytes(pos, channels[c], channel_bytes);
+        pos += channel_bytes;
+    }
+    m_head.store(head + record_bytes, std::memory_order_release);
+}
+
+template <typename T>
+void DiskTap<T>::start() {
+    if (m_recording.load(std::memory_order_relaxed)) return;
+
+    openFile();
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_position = 0;
+    m_recorded.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_batch_fill = 0;
+    m_data_bytes = 0;
+    m_write_failed = false;
+    m_file_offset = 0;
+
+    if (m_format == TapFormat::Wav) {
+        writeWavHeader(0);
+        m_file_offset = kWavHeaderBytes;
+    }
+
+    m_stop.store(false, std::memory_order_relaxed);
+    m_worker = std::thread(&DiskTap::workerLoop, this);
+    m_recording.store(true, std::memory_order_release);
+}
+
+template <typename T>
+void DiskTap<T>::stop() {
+    if (!m_recording.load(std::memory_order_relaxed)) return;
+
+    // The writer must not be inside onWrite() when stop() is called (same thread, or quiesced).
+    m_recording.store(false, std::memory_order_release);
+    m_stop.store(true, std::memory_order_release);
+    m_worker.join();
+
+    // Worker is gone: drain the rest and write the final partial batch here.
+    drain();
+    if (m_batch_fill > 0) writeBatch(m_batch_fill);
+    if (m_format == TapFormat::Wav) writeWavHeader(m_data_bytes);
+    closeFile();
+
+    if (m_write_failed) {
+        throw std::runtime_error("Writing '" + m_path + "' failed.");
+    }
+}
+
+template <typename T>
+void DiskTap<T>::workerLoop() {
+    while (!m_stop.load(std::memory_order_acquire)) {
+        if (!drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+template <typename T>
+bool DiskTap<T>::drain() {
+    std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = m_head.load(std::memory_order_acquire);
+    if (tail == head) return false;
+
+    while (tail != head) {
+        TapRecordHeader header;
+        popBytes(static_cast<size_t>(tail), &header, sizeof(header));
+        const size_t samples = static_cast<size_t>(header.num_channels) * header.count;
+        if (m_block.size() < samples) m_block.resize(samples);
+        popBytes(static_cast<size_t>(tail + sizeof(header)), m_block.data(), samples * sizeof(T));
+        tail += sizeof(header) + samples * sizeof(T);
+        // Release the queue space before the (possibly slow) file write.
+        m_tail.store(tail, std::memory_order_release);
+
+        if (m_format == TapFormat::RawTimestamped) {
+            append(&header, sizeof(header));
+            append(m_block.data(), samples * sizeof(T));
+        } else {
+            if (m_interleaved.size() < samples) m_interleaved.resize(samples);
+            for (size_t c = 0; c < header.num_channels; ++c) {
+                const T* src = m_block.data() + c * header.count;
+                for (size_t i = 0; i < header.count; ++i) {
+                    m_interleaved[i * header.num_channels + c] = src[i];
+                }
+            }
+            append(m_interleaved.data(), samples * sizeof(T));
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void DiskTap<T>::append(const void* data, size_t bytes) {
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+    m_data_bytes += bytes;
+    while (bytes > 0) {
+        size_t n = std::min(bytes, m_batch_bytes - m_batch_fill);
+        std::memcpy(m_batch + m_batch_fill, src, n);
+        m_batch_fill += n;
+        src += n;
+        bytes -= n;
+        if (m_batch_fill == m_batch_bytes) writeBatch(m_batch_bytes);
+    }
+}
+
+template <typename T>
+void DiskTap<T>::writeBatch(size_t bytes) {
+    writeAt(m_batch, bytes, m_file_offset);
+    m_file_offset += bytes;
+    m_batch_fill = 0;
+}
+
+template <typename T>
+void DiskTap<T>::writeAt(const void* data, size_t bytes, std::uint64_t offset) {
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+#if defined(JABUFF_HAS_PWRITE)
+    while (bytes > 0) {
+        ssize_t n = ::pwrite(m_fd, src, bytes, static_cast<off_t>(offset));
+        if (n <= 0) {
+            m_write_failed = true;
+            return;
+        }
+        src += n;
+        offset += static_cast<std::uint64_t>(n);
+        bytes -= static_cast<size_t>(n);
+    }
+#else
+    if (std::fseek(m_file, static_cast<long>(offset), SEEK_SET) != 0 || std::fwrite(src, 1, bytes, m_file) != bytes) {
+        m_write_failed = true;
+    }
+#endif
+}
+
+template <typename T>
+void DiskTap<T>::writeWavHeader(std::uint64_t data_bytes) {
+    // RIFF + fmt (IEEE float) + JUNK padding + data header = exactly kWavHeaderBytes.
+    std::vector<std::uint8_t> header(kWavHeaderBytes, 0);
+    auto put16 = [&](size_t at, std::uint16_t v) { header[at] = v & 0xFF; header[at + 1] = v >> 8; };
+    auto put32 = [&](size_t at, std::uint32_t v) { for (size_t b = 0; b < 4; ++b) header[at + b] = (v >> (8 * b)) & 0xFF; };
+
+    // WAV sizes are 32-bit; longer recordings keep the maximum (readers then use the file size).
+    const std::uint64_t max_data = 0xFFFFFFFFull - (kWavHeaderBytes - 8);
+    const std::uint32_t data_size = static_cast<std::uint32_t>(std::min(data_bytes, max_data));
+    const std::uint16_t block_align = static_cast<std::uint16_t>(m_num_channels * sizeof(T));
+
+    std::memcpy(&header[0], "RIFF", 4);
+    put32(4, static_cast<std::uint32_t>(kWavHeaderBytes - 8 + data_size));
+    std::memcpy(&header[8], "WAVE", 4);
+    std::memcpy(&header[12], "fmt ", 4);
+    put32(16, 16);
+    put16(20, 3); // WAVE_FORMAT_IEEE_FLOAT
+    put16(22, static_cast<std::uint16_t>(m_num_channels));
+    put32(24, static_cast<std::uint32_t>(m_sample_rate));
+    put32(28, static_cast<std::uint32_t>(m_sample_rate * block_align));
+    put16(32, block_align);
+    put16(34, static_cast<std::uint16_t>(8 * sizeof(T)));
+    std::memcpy(&header[36], "JUNK", 4);
+    put32(40, static_cast<std::uint32_t>(kWavHeaderBytes - 44 - 8));
+    std::memcpy(&header[kWavHeaderBytes - 8], "data", 4);
+    put32(kWavHeaderBytes - 4, data_size);
+
+    writeAt(header.data(), header.size(), 0);
+}
+
+template <typename T>
+void DiskTap<T>::openFile() {
+#if defined(JABUFF_HAS_PWRITE)
+    m_fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error("Cannot open '" + m_path + "' for writing.");
+    }
+#else
+    m_file = std::fopen(m_path.c_str(), "wb");
+    if (m_file == nullptr) {
+        throw std::runtime_error("Cannot open '" + m_path + "' for writing.");
+    }
+#endif
+}
+
+template <typename T>
+void DiskTap<T>::closeFile() {
+#if defined(JABUFF_HAS_PWRITE)
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+#else
+    if (m_file != nullptr) std::fclose(m_file);
+    m_file = nullptr;
+#endif
+}
+
+template <typename T>
+bool DiskTap<T>::isRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+template <typename T>
+size_t DiskTap<T>::getDroppedBlocks() const { return m_dropped.load(std::memory_order_relaxed); }
+
+template <typename T>
+std::uint64_t DiskTap<T>::getRecordedSamples() const { return m_recorded.load(std::memory_order_relaxed); }
+
+template <typename T>
+size_t DiskTap<T>::getNumChannels() const { return m_num_channels; }
+
+template <typename T>
+TapFormat DiskTap<T>::getFormat() const { return m_format; }
+
+template <typename T>
+const std::string& DiskTap<T>::getPath() const { return m_path; }
+
+} // namespace JABuff
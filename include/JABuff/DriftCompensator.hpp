@@ -0,0 +1,303 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument
+#include <cstddef>      // For size_t
+#include <string>       // For std::to_string
+#include <cmath>        // For std::floor, std::ceil
+#include <algorithm>    // For std::min, std::max
+#include <type_traits>  // For std::is_same
+
+#include "FramingRingBuffer2D.hpp"
+#include "OLARingBuffer2D.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief Holds a buffer's fill level at a set point when producer and consumer clocks drift.
+ *
+ * Sits on the write side of a FramingRingBuffer2D or OLARingBuffer2D. Before each
+ * write it measures the buffer's fill (getAvailableFeaturesRead() /
+ * getAvailableSamplesRead()), smooths it, and runs a PI controller on the error to
+ * the target. The controller output sets a resampling ratio within
+ * 1 +/- max_deviation; the incoming block is resampled by that ratio before it is
+ * written. A producer running fast therefore gets stretched down by a few ppm and
+ * the fill settles at the target instead of creeping towards overflow or underrun,
+ * so long sessions can run with small buffers.
+ *
+ * Resampling is linear interpolation, which is transparent at ppm-scale ratios.
+ * For FramingRingBuffer2D it is continuous across blocks. OLARingBuffer2D blocks
+ * overlap each other, so each block is stretched on its own (end points kept) such
+ * that its net advance scales by the ratio, with the fractional length carried to
+ * the next block.
+ *
+ * Tuning: with error e in samples, the correction is kp * e + ki * (integral of e
+ * over samples). The defaults give a damped loop with a time constant of a few
+ * seconds at 48 kHz. Lower them for noisier consumers.
+ *
+ * @tparam T The sample type.
+ * @tparam Buffer FramingRingBuffer2D (default) or OLARingBuffer2D.
+ */
+template <typename T, template <typename> class Buffer = FramingRingBuffer2D>
+class DriftCompensator {
+public:
+    /**
+     * @brief Construct a compensator writing into a buffer.
+     *
+     * @param buffer The buffer to write to. Must outlive this object.
+     * @param target_fill The fill level (in samples) to hold.
+     * @param kp Proportional gain (ratio change per sample of error).
+     * @param ki Integral gain (ratio change per sample of error per input sample).
+     * @param max_deviation Largest |ratio - 1| the controller may apply.
+     * @param fill_smoothing Weight of each new fill measurement in the running average (0, 1].
+     * @throws std::invalid_argument on an invalid configuration.
+     */
+    DriftCompensator(Buffer<T>& buffer, double target_fill, double kp = 1.5e-5, double ki = 1.1e-10,
+                     double max_deviation = 1e-3, double fill_smoothing = 0.05);
+
+    /**
+     * @brief Updates the controller and writes the resampled block.
+     *
+     * @param data_in Input data [channel][sample].
+     * @return The buffer's write() result. On false, the controller and resampler state are unchanged.
+     * @throws std::invalid_argument if the channel count mismatches or channels differ in length.
+     */
+    bool write(const std::vector<std::vector<T>>& data_in);
+
+    /**
+     * @brief Returns the current ratio (output samples per input sample).
+     */
+    double getRatio() const;
+
+    /**
+     * @brief Returns the estimated producer clock offset relative to the consumer, in ppm.
+     */
+    double getEstimatedDriftPpm() const;
+
+    /**
+     * @brief Returns the smoothed fill level the controller sees.
+     */
+    double getSmoothedFill() const;
+
+    double getTargetFill() const;
+    void setTargetFill(double target_fill);
+
+    /**
+     * @brief Resets the controller (ratio 1) and the resampler history.
+     */
+    void reset();
+
+private:
+    static constexpr bool kStreamResample = std::is_same<Buffer<T>, FramingRingBuffer2D<T>>::value;
+
+    double measureFill() const;
+    size_t resampleStream(const std::vector<std::vector<T>>& data_in, double step, double& position_out);
+    size_t stretchBlock(const std::vector<std::vector<T>>& data_in, double ratio, double& carry_out);
+
+    Buffer<T>& m_buffer;
+    size_t m_num_channels;
+    double m_target_fill;
+    double m_kp;
+    double m_ki;
+    double m_max_deviation;
+    double m_fill_smoothing;
+
+    double m_smoothed_fill;
+    bool m_have_fill;
+    double m_integral;   // Integral of the fill error over input samples
+    double m_ratio;
+
+    // Continuous resampler state (FramingRingBuffer2D)
+    std::vector<T> m_previous; // [channel] last input sample
+    double m_position;         // Next output position, in input samples after m_previous
+    // Block stretch state (OLARingBuffer2D)
+    double m_length_carry;
+
+    std::vector<std::vector<T>> m_staging;
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T, template <typename> class Buffer>
+DriftCompensator<T, Buffer>::DriftCompensator(Buffer<T>& buffer, double target_fill, double kp, double ki,
+                                              double max_deviation, double fill_smoothing)
+    : m_buffer(buffer),
+      m_num_channels(buffer.getNumChannels()),
+      m_target_fill(target_fill),
+      m_kp(kp),
+      m_ki(ki),
+      m_max_deviation(max_deviation),
+      m_fill_smoothing(fill_smoothing),
+      m_smoothed_fill(0.0),
+      m_have_fill(false),
+      m_integral(0.0),
+      m_ratio(1.0),
+      m_position(1.0),
+      m_length_carry(0.0) {
+
+    if (target_fill < 0.0 || target_fill > static_cast<double>(buffer.getCapacity())) {
+        throw std::invalid_argument("Target fill must be within [0, capacity].");
+    }
+    if (!(max_deviation > 0.0 && max_deviation < 0.5)) {
+        throw std::invalid_argument("max_deviation must be in (0, 0.5).");
+    }
+    if (!(fill_smoothing > 0.0 && fill_smoothing <= 1.0)) {
+        throw std::invalid_argument("fill_smoothing must be in (0, 1].");
+    }
+
+    m_previous.assign(m_num_channels, static_cast<T>(0));
+    m_staging.resize(m_num_channels);
+}
+
+template <typename T, template <typename> class Buffer>
+double DriftCompensator<T, Buffer>::measureFill() const {
+    if constexpr (kStreamResample) {
+        return static_cast<double>(m_buffer.getAvailableFeaturesRead());
+    } else {
+        return static_cast<double>(m_buffer.getAvailableSamplesRead());
+    }
+}
+
+template <typename T, template <typename> class Buffer>
+bool DriftCompensator<T, Buffer>::write(const std::vector<std::vector<T>>& data_in) {
+    if (data_in.empty()) return true;
+
+    if (data_in.size() != m_num_channels) {
+        throw std::invalid_argument("Input data channel count (" + std::to_string(data_in.size()) +
+                                    ") does not match buffer channels (" + std::to_string(m_num_channels) + ").");
+    }
+
+    const size_t input_len = data_in[0].size();
+    for (size_t c = 1; c < m_num_channels; ++c) {
+        if (data_in[c].size() != input_len) {
+            throw std::invalid_argument("Input data channels have inconsistent sizes.");
+        }
+    }
+    if (input_len == 0) return true;
+
+    // PI update on the smoothed fill error; computed on copies so a failed write changes nothing.
+    double fill = measureFill();
+    double smoothed = m_have_fill ? m_smoothed_fill + m_fill_smoothing * (fill - m_smoothed_fill) : fill;
+    double error = smoothed - m_target_fill;
+    double integral = m_integral + error * static_cast<double>(input_len);
+
+    double correction = m_kp * error + m_ki * integral;
+    if (correction > m_max_deviation || correction < -m_max_deviation) {
+        // Anti-windup: hold the integral while saturated.
+        integral = m_integral;
+        correction = std::max(-m_max_deviation, std::min(m_max_deviation, m_kp * error + m_ki * integral));
+    }
+    double ratio = 1.0 - correction;
+
+    bool ok;
+    if constexpr (kStreamResample) {
+        double position = 0.0;
+        size_t out_len = resampleStream(data_in, 1.0 / ratio, position);
+        ok = (out_len == 0) || m_buffer.write(m_staging, 0, out_len);
+        if (ok) {
+            m_position = position;
+            for (size_t c = 0; c < m_num_channels; ++c) m_previous[c] = data_in[c].back();
+        }
+    } else {
+        double carry = 0.0;
+        stretchBlock(data_in, ratio, carry);
+        ok = m_buffer.write(m_staging);
+        if (ok) m_length_carry = carry;
+    }
+
+    if (ok) {
+        m_smoothed_fill = smoothed;
+        m_have_fill = true;
+        m_integral = integral;
+        m_ratio = ratio;
+    }
+    return ok;
+}
+
+template <typename T, template <typename> class Buffer>
+size_t DriftCompensator<T, Buffer>::resampleStream(const std::vector<std::vector<T>>& data_in, double step, double& position_out) {
+    // Positions are in input samples: 0 = previous block's last sample, k = data_in[k - 1].
+    const size_t len = data_in[0].size();
+    const double end = static_cast<double>(len);
+    size_t out_len = (m_position < end) ? static_cast<size_t>(std::ceil((end - m_position) / step)) : 0;
+    // Guard against rounding at the boundary.
+    while (out_len > 0 && m_position + static_cast<double>(out_len - 1) * step >= end) --out_len;
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        std::vector<T>& out = m_staging[c];
+        if (out.size() < out_len) out.resize(out_len);
+        const T* x = data_in[c].data();
+        double p = m_position;
+        for (size_t n = 0; n < out_len; ++n, p += step) {
+            size_t i = static_cast<size_t>(p);
+            T frac = static_cast<T>(p - static_cast<double>(i));
+            T a = (i == 0) ? m_previous[c] : x[i - 1];
+            T b = x[i];
+            out[n] = a + frac * (b - a);
+        }
+    }
+
+    position_out = m_position + static_cast<double>(out_len) * step - end;
+    return out_len;
+}
+
+template <typename T, template <typename> class Buffer>
+size_t DriftCompensator<T, Buffer>::stretchBlock(const std::vector<std::vector<T>>& data_in, double ratio, double& carry_out) {
+    // Scale the net advance (block minus the overlap it shares with the next block).
+    const size_t len = data_in[0].size();
+    const double overlap = static_cast<double>(m_buffer.getOverlapSize());
+    double exact = overlap + (static_cast<double>(len) - overlap) * ratio + m_length_carry;
+    size_t out_len = static_cast<size_t>(std::floor(exact + 0.5));
+    if (out_len < 2) out_len = 2;
+    carry_out = exact - static_cast<double>(out_len);
+
+    const double scale = (len > 1) ? static_cast<double>(len - 1) / static_cast<double>(out_len - 1) : 0.0;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        std::vector<T>& out = m_staging[c];
+        out.resize(out_len);
+        const T* x = data_in[c].data();
+        for (size_t n = 0; n < out_len; ++n) {
+            double p = static_cast<double>(n) * scale;
+            size_t i = std::min(static_cast<size_t>(p), len - 1);
+            size_t j = std::min(i + 1, len - 1);
+            T frac = static_cast<T>(p - static_cast<double>(i));
+            out[n] = x[i] + frac * (x[j] - x[i]);
+        }
+    }
+    return out_len;
+}
+
+template <typename T, template <typename> class Buffer>
+double DriftCompensator<T, Buffer>::getRatio() const { return m_ratio; }
+
+template <typename T, template <typename> class Buffer>
+double DriftCompensator<T, Buffer>::getEstimatedDriftPpm() const { return (1.0 / m_ratio - 1.0) * 1e6; }
+
+template <typename T, template <typename> class Buffer>
+double DriftCompensator<T, Buffer>::getSmoothedFill() const { return m_smoothed_fill; }
+
+template <typename T, template <typename> class Buffer>
+double DriftCompensator<T, Buffer>::getTargetFill() const { return m_target_fill; }
+
+template <typename T, template <typename> class Buffer>
+void DriftCompensator<T, Buffer>::setTargetFill(double target_fill) {
+    if (target_fill < 0.0 || target_fill > static_cast<double>(m_buffer.getCapacity())) {
+        throw std::invalid_argument("Target fill must be within [0, capacity].");
+    }
+    m_target_fill = target_fill;
+}
+
+template <typename T, template <typename> class Buffer>
+void DriftCompensator<T, Buffer>::reset() {
+    m_smoothed_fill = 0.0;
+    m_have_fill = false;
+    m_integral = 0.0;
+    m_ratio = 1.0;
+    std::fill(m_previous.begin(), m_previous.end(), static_cast<T>(0));
+    m_position = 1.0;
+    m_length_carry = 0.0;
+}
+
+} // namespace JABuff
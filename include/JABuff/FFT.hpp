@@ -0,0 +1,260 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <complex>      // For std::complex
+#include <stdexcept>    // For std::invalid_argument
+#include <cstddef>      // For size_t
+#include <cmath>        // For std::cos, std::sin
+
+namespace JABuff {
+
+/**
+ * @brief A self-contained mixed-radix complex FFT (forward, unnormalised).
+ *
+ * Any size is supported. The size is factored into radix-4 and radix-2 stages
+ * first, then odd factors (3, 5, 7, ...), with a generic butterfly for the odd
+ * radices. All tables are built in the constructor; forward() does not allocate.
+ *
+ * @tparam T The real scalar type (float or double).
+ */
+template <typename T>
+class ComplexFFT {
+public:
+    using Complex = std::complex<T>;
+
+    /**
+     * @brief Construct a plan for transforms of size n.
+     * @throws std::invalid_argument if n is zero.
+     */
+    explicit ComplexFFT(size_t n);
+
+    /**
+     * @brief Computes out[k] = sum_j in[j] * exp(-2*pi*i*j*k/n).
+     * @param in Input of size n.
+     * @param out Output of size n. Must not alias in.
+     */
+    void forward(const Complex* in, Complex* out);
+
+    size_t size() const { return m_n; }
+
+private:
+    void work(Complex* out, const Complex* in, size_t fstride, const size_t* factors);
+    void butterfly2(Complex* out, size_t fstride, size_t m) const;
+    void butterfly4(Complex* out, size_t fstride, size_t m) const;
+    void butterflyGeneric(Complex* out, size_t fstride, size_t m, size_t p);
+
+    size_t m_n;
+    std::vector<size_t> m_factors;   // Pairs of (radix, remaining length)
+    std::vector<Complex> m_twiddles; // exp(-2*pi*i*k/n), k = 0..n-1
+    std::vector<Complex> m_scratch;  // Generic butterfly staging (size = largest radix)
+};
+
+/**
+ * @brief Forward FFT of a real signal, producing the n/2 + 1 non-negative frequency bins.
+ *
+ * Even sizes run a half-size complex FFT on the packed signal and split the
+ * result; odd sizes fall back to a full-size complex FFT.
+ *
+ * This is the default FFT of StreamingSTFT. Any class with the same
+ * constructor (size_t n) and forward(const T*, std::complex<T>*) signature
+ * can be plugged in instead.
+ *
+ * @tparam T The real scalar type (float or double).
+ */
+template <typename T>
+class RealFFT {
+public:
+    using Complex = std::complex<T>;
+
+    explicit RealFFT(size_t n);
+
+    /**
+     * @brief Computes bins 0..n/2 of the DFT of a real input.
+     * @param in Input of size n.
+     * @param out Output of size n/2 + 1.
+     */
+    void forward(const T* in, Complex* out);
+
+    size_t size() const { return m_n; }
+    size_t getNumBins() const { return m_n / 2 + 1; }
+
+private:
+    size_t m_n;
+    ComplexFFT<T> m_fft;             // Size n/2 (even n) or n (odd n)
+    std::vector<Complex> m_packed;   // FFT input
+    std::vector<Complex> m_spectrum; // FFT output
+    std::vector<Complex> m_split;    // exp(-2*pi*i*k/n), k = 0..n/2 (even n only)
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+ComplexFFT<T>::ComplexFFT(size_t n) : m_n(n) {
+    if (n == 0) {
+        throw std::invalid_argument("FFT size must be non-zero.");
+    }
+
+    // Factorise: 4s first, then 2, then odd factors.
+    size_t remaining = n;
+    size_t p = 4;
+    size_t max_radix = 1;
+    while (remaining > 1) {
+        while (remaining % p != 0) {
+            if (p == 4) p = 2;
+            else if (p == 2) p = 3;
+            else p += 2;
+            if (p * p > remaining) p = remaining;
+        }
+        remaining /= p;
+        m_factors.push_back(p);
+        m_factors.push_back(remaining);
+        if (p > max_radix) max_radix = p;
+    }
+
+    const double two_pi = 6.283185307179586476925286766559;
+    m_twiddles.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        double phase = -two_pi * static_cast<double>(k) / static_cast<double>(n);
+        m_twiddles[k] = Complex(static_cast<T>(std::cos(phase)), static_cast<T>(std::sin(phase)));
+    }
+
+    m_scratch.resize(max_radix);
+}
+
+template <typename T>
+void ComplexFFT<T>::forward(const Complex* in, Complex* out) {
+    if (m_n == 1) {
+        out[0] = in[0];
+        return;
+    }
+    work(out, in, 1, m_factors.data());
+}
+
+template <typename T>
+void ComplexFFT<T>::work(Complex* out, const Complex* in, size_t fstride, const size_t* factors) {
+    // Decimation in time: split into p interleaved sub-sequences, transform each, then combine.
+    const size_t p = factors[0];
+    const size_t m = factors[1];
+    Complex* const out_begin = out;
+    Complex* const out_end = out + p * m;
+
+    if (m == 1) {
+        do {
+            *out = *in;
+            in += fstride;
+        } while (++out != out_end);
+    } else {
+        do {
+            work(out, in, fstride * p, factors + 2);
+            in += fstride;
+        } while ((out += m) != out_end);
+    }
+
+    out = out_begin;
+    switch (p) {
+        case 2: butterfly2(out, fstride, m); break;
+        case 4: butterfly4(out, fstride, m); break;
+        default: butterflyGeneric(out, fstride, m, p); break;
+    }
+}
+
+template <typename T>
+void ComplexFFT<T>::butterfly2(Complex* out, size_t fstride, size_t m) const {
+    for (size_t k = 0; k < m; ++k) {
+        Complex t = out[k + m] * m_twiddles[k * fstride];
+        out[k + m] = out[k] - t;
+        out[k] += t;
+    }
+}
+
+template <typename T>
+void ComplexFFT<T>::butterfly4(Complex* out, size_t fstride, size_t m) const {
+    for (size_t k = 0; k < m; ++k) {
+        Complex s0 = out[k + m] * m_twiddles[k * fstride];
+        Complex s1 = out[k + 2 * m] * m_twiddles[2 * k * fstride];
+        Complex s2 = out[k + 3 * m] * m_twiddles[3 * k * fstride];
+
+        Complex s5 = out[k] - s1;
+        out[k] += s1;
+        Complex s3 = s0 + s2;
+        Complex s4 = s0 - s2;
+
+        out[k + 2 * m] = out[k] - s3;
+        out[k] += s3;
+        // Multiply s4 by -i for the forward transform
+        out[k + m] = Complex(s5.real() + s4.imag(), s5.imag() - s4.real());
+        out[k + 3 * m] = Complex(s5.real() - s4.imag(), s5.imag() + s4.real());
+    }
+}
+
+template <typename T>
+void ComplexFFT<T>::butterflyGeneric(Complex* out, size_t fstride, size_t m, size_t p) {
+    for (size_t u = 0; u < m; ++u) {
+        for (size_t q1 = 0; q1 < p; ++q1) {
+            m_scratch[q1] = out[u + q1 * m];
+        }
+
+        for (size_t q1 = 0; q1 < p; ++q1) {
+            size_t k = u + q1 * m;
+            size_t twiddle_index = 0;
+            Complex acc = m_scratch[0];
+            for (size_t q = 1; q < p; ++q) {
+                twiddle_index += fstride * k;
+                if (twiddle_index >= m_n) twiddle_index %= m_n;
+                acc += m_scratch[q] * m_twiddles[twiddle_index];
+            }
+            out[k] = acc;
+        }
+    }
+}
+
+template <typename T>
+RealFFT<T>::RealFFT(size_t n)
+    : m_n(n),
+      m_fft((n % 2 == 0 && n > 0) ? n / 2 : n) {
+
+    size_t inner = m_fft.size();
+    m_packed.resize(inner);
+    m_spectrum.resize(inner);
+
+    if (n % 2 == 0) {
+        const double two_pi = 6.283185307179586476925286766559;
+        m_split.resize(n / 2 + 1);
+        for (size_t k = 0; k <= n / 2; ++k) {
+            double phase = -two_pi * static_cast<double>(k) / static_cast<double>(n);
+            m_split[k] = Complex(static_cast<T>(std::cos(phase)), static_cast<T>(std::sin(phase)));
+        }
+    }
+}
+
+template <typename T>
+void RealFFT<T>::forward(const T* in, Complex* out) {
+    if (m_n % 2 != 0) {
+        for (size_t i = 0; i < m_n; ++i) m_packed[i] = Complex(in[i], 0);
+        m_fft.forward(m_packed.data(), m_spectrum.data());
+        for (size_t k = 0; k <= m_n / 2; ++k) out[k] = m_spectrum[k];
+        return;
+    }
+
+    // Pack even/odd samples as real/imaginary parts of a half-size signal.
+    const size_t half = m_n / 2;
+    for (size_t i = 0; i < half; ++i) {
+        m_packed[i] = Complex(in[2 * i], in[2 * i + 1]);
+    }
+    m_fft.forward(m_packed.data(), m_spectrum.data());
+
+    // Split: X[k] = E[k] + W^k * O[k], with E and O recovered from Z[k] and conj(Z[half - k]).
+    const T one_half = static_cast<T>(0.5);
+    for (size_t k = 0; k <= half; ++k) {
+        Complex zk = m_spectrum[k % half];
+        Complex znk = std::conj(m_spectrum[(half - k) % half]);
+        Complex even = (zk + znk) * one_half;
+        Complex diff = (zk - znk) * one_half;
+        Complex odd(diff.imag(), -diff.real()); // diff * (-i)
+        out[k] = even + m_split[k] * odd;
+    }
+}
+
+} // namespace JABuff
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <cstring>      // For std::memcpy
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint16_t, std::uint32_t, std::int8_t
+#include <cmath>        // For std::nearbyint
+#include <algorithm>    // For std::min, std::max
+
+#if defined(__F16C__) || defined(__AVX2__) || defined(__AVX512BF16__)
+#include <immintrin.h>
+#endif
+
+namespace JABuff {
+
+/**
+ * @brief IEEE 754 binary16 storage type.
+ *
+ * This is a storage-only type: it carries the raw bits and has no arithmetic.
+ * Use it as the StorageT parameter of FramingRingBuffer3D to keep a float API
+ * while halving the memory held by the ring.
+ */
+struct Float16 {
+    std::uint16_t bits;
+};
+
+/**
+ * @brief bfloat16 storage type (upper 16 bits of an IEEE 754 binary32).
+ *
+ * Same range as float with 8 bits of mantissa. Storage-only, like Float16.
+ */
+struct BFloat16 {
+    std::uint16_t bits;
+};
+
+/**
+ * @brief Asymmetric 8-bit quantised storage type.
+ *
+ * Each stored row (one time step of one channel) carries its own QuantParams,
+ * computed from the row's range at write time:
+ *   x ~= scale * (q - zero_point)
+ */
+struct QInt8 {
+    std::int8_t value;
+};
+
+/**
+ * @brief Per-row quantisation parameters for QInt8 storage.
+ */
+struct QuantParams {
+    float scale;
+    std::int32_t zero_point;
+};
+
+static_assert(sizeof(Float16) == 2, "Float16 must be 2 bytes");
+static_assert(sizeof(BFloat16) == 2, "BFloat16 must be 2 bytes");
+static_assert(sizeof(QInt8) == 1, "QInt8 must be 1 byte");
+
+namespace detail {
+
+// ===================================================================
+// --- Scalar Conversions ---
+// ===================================================================
+
+inline std::uint32_t floatBits(float f) {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    return x;
+}
+
+inline float bitsToFloat(std::uint32_t x) {
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+// Round-to-nearest-even float -> binary16, matching _mm256_cvtps_ph.
+inline std::uint16_t floatToHalfBits(float f) {
+    std::uint32_t x = floatBits(f);
+    std::uint32_t sign = (x >> 16) & 0x8000u;
+    std::uint32_t abs_bits = x & 0x7FFFFFFFu;
+
+    // Inf / NaN (keep NaN quiet and non-zero)
+    if (abs_bits >= 0x7F800000u) {
+        if (abs_bits == 0x7F800000u) return static_cast<std::uint16_t>(sign | 0x7C00u);
+        return static_cast<std::uint16_t>(sign | 0x7E00u | ((abs_bits >> 13) & 0x3FFu));
+    }
+
+    // Values >= 65520 round to Inf
+    if (abs_bits >= 0x477FF000u) {
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+
+    // Normal range of binary16 (>= 2^-14)
+    if (abs_bits >= 0x38800000u) {
+        std::uint32_t h = (abs_bits - 0x38000000u) >> 13;
+        std::uint32_t rem = abs_bits & 0x1FFFu;
+        if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h;
+        return static_cast<std::uint16_t>(sign | h);
+    }
+
+    // Below half the smallest subnormal -> signed zero
+    if (abs_bits < 0x33000000u) {
+        return static_cast<std::uint16_t>(sign);
+    }
+
+    // Subnormal range: value in units of 2^-24
+    std::uint32_t exponent = abs_bits >> 23;
+    std::uint32_t mantissa = (abs_bits & 0x7FFFFFu) | 0x800000u;
+    std::uint32_t shift = 126u - exponent;
+    std::uint32_t h = mantissa >> shift;
+    std::uint32_t rem = mantissa & ((1u << shift) - 1u);
+    std::uint32_t halfway = 1u << (shift - 1u);
+    if (rem > halfway || (rem == halfway && (h & 1u))) ++h;
+    return static_cast<std::uint16_t>(sign | h);
+}
+
+inline float halfBitsToFloat(std::uint16_t h) {
+    std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    std::uint32_t exponent = (h >> 10) & 0x1Fu;
+    std::uint32_t mantissa = h & 0x3FFu;
+
+    if (exponent == 0) {
+        // Zero or subnormal: mantissa * 2^-24
+        float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+        return bitsToFloat(floatBits(magnitude) | sign);
+    }
+    if (exponent == 31) {
+        return bitsToFloat(sign | 0x7F800000u | (mantissa << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+}
+
+// Round-to-nearest-even float -> bfloat16.
+inline std::uint16_t floatToBFloat16Bits(float f) {
+    std::uint32_t x = floatBits(f);
+    if ((x & 0x7FFFFFFFu) > 0x7F800000u) {
+        return static_cast<std::uint16_t>((x >> 16) | 0x0040u); // Quiet NaN
+    }
+    x += 0x7FFFu + ((x >> 16) & 1u);
+    return static_cast<std::uint16_t>(x >> 16);
+}
+
+inline float bfloat16BitsToFloat(std::uint16_t b) {
+    return bitsToFloat(static_cast<std::uint32_t>(b) << 16);
+}
+
+// ===================================================================
+// --- Block Kernels (SIMD where the target allows, scalar tail) ---
+// ===================================================================
+
+inline void convertFloatToHalf(const float* src, Float16* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(src + i);
+        __m128i h = _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i].bits = floatToHalfBits(src[i]);
+    }
+}
+
+inline void convertHalfToFloat(const Float16* src, float* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = halfBitsToFloat(src[i].bits);
+    }
+}
+
+inline void convertFloatToBFloat16(const float* src, BFloat16* dst, size_t n) {
+    size_t i = 0;
+#if defined(__AVX512BF16__)
+    // Note: vcvtneps2bf16 flushes float denormals to zero; the scalar path keeps them.
+    for (; i + 16 <= n; i += 16) {
+        __m256bh b = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+        std::memcpy(dst + i, &b, sizeof(b));
+    }
+#elif defined(__AVX2__)
+    const __m256i round_bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i quiet = _mm256_set1_epi32(0x0040);
+    for (; i + 16 <= n; i += 16) {
+        __m256i packed[2];
+        for (int half = 0; half < 2; ++half) {
+            __m256 v = _mm256_loadu_ps(src + i + 8 * half);
+            __m256i x = _mm256_castps_si256(v);
+            __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), one);
+            __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(round_bias, lsb)), 16);
+            __m256i nan_bits = _mm256_or_si256(_mm256_srli_epi32(x, 16), quiet);
+            __m256i is_nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+            packed[half] = _mm256_blendv_epi8(rounded, nan_bits, is_nan);
+        }
+        // packus interleaves 128-bit lanes; restore order with a 64-bit permute.
+        __m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi32(packed[0], packed[1]), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i].bits = floatToBFloat16Bits(src[i]);
+    }
+}
+
+inline void convertBFloat16ToFloat(const BFloat16* src, float* dst, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 8 <= n; i += 8) {
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m256i x = _mm256_slli_epi32(_mm256_cvtepu16_epi32(b), 16);
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(x));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = bfloat16BitsToFloat(src[i].bits);
+    }
+}
+
+// ===================================================================
+// --- Feature Codec ---
+// ===================================================================
+
+// Placeholder parameter type for codecs that need no per-row state.
+struct NoParams {};
+
+/**
+ * @brief Converts rows of features between the API type T and the storage type S.
+ *
+ * The primary template performs an element-wise static_cast. Identical types
+ * use a plain memcpy, and the half-precision storage types use the block
+ * kernels above.
+ *
+ * Codecs with kHasParams = true take a Params object per row: encode() fills it,
+ * decode() consumes it.
+ */
+template <typename T, typename S>
+struct FeatureCodec {
+    using Params = NoParams;
+    static constexpr bool kHasParams = false;
+    static void encode(const T* src, S* dst, size_t n) {
+        for (size_t i = 0; i < n; ++i) dst[i] = static_cast<S>(src[i]);
+    }
+    static void decode(const S* src, T* dst, size_t n) {
+        for (size_t i = 0; i < n; ++i) dst[i] = static_cast<T>(src[i]);
+    }
+};
+
+template <typename T>
+struct FeatureCodec<T, T> {
+    using Params = NoParams;
+    static constexpr bool kHasParams = false;
+    static void encode(const T* src, T* dst, size_t n) {
+        std::memcpy(dst, src, n * sizeof(T));
+    }
+    static void decode(const T* src, T* dst, size_t n) {
+        std::memcpy(dst, src, n * sizeof(T));
+    }
+};
+
+template <>
+struct FeatureCodec<float, Float16> {
+    using Params = NoParams;
+    static constexpr bool kHasParams = false;
+    static void encode(const float* src, Float16* dst, size_t n) { convertFloatToHalf(src, dst, n); }
+    static void decode(const Float16* src, float* dst, size_t n) { convertHalfToFloat(src, dst, n); }
+};
+
+template <>
+struct FeatureCodec<float, BFloat16> {
+    using Params = NoParams;
+    static constexpr bool kHasParams = false;
+    static void encode(const float* src, BFloat16* dst, size_t n) { convertFloatToBFloat16(src, dst, n); }
+    static void decode(const BFloat16* src, float* dst, size_t n) { convertBFloat16ToFloat(src, dst, n); }
+};
+
+template <typename T>
+struct FeatureCodec<T, QInt8> {
+    using Params = QuantParams;
+    static constexpr bool kHasParams = true;
+
+    static void encode(const T* src, QInt8* dst, size_t n, Params& params) {
+        // Range must include 0 so that zero (padding, silence) is exact.
+        T lo = 0;
+        T hi = 0;
+        for (size_t i = 0; i < n; ++i) {
+            lo = std::min(lo, src[i]);
+            hi = std::max(hi, src[i]);
+        }
+
+        if (hi == lo) {
+            params.scale = 1.0f;
+            params.zero_point = 0;
+            for (size_t i = 0; i < n; ++i) dst[i].value = 0;
+            return;
+        }
+
+        float scale = static_cast<float>(hi - lo) / 255.0f;
+        float inv_scale = 1.0f / scale;
+        std::int32_t zero_point = static_cast<std::int32_t>(std::nearbyint(-128.0f - static_cast<float>(lo) * inv_scale));
+        zero_point = std::min<std::int32_t>(127, std::max<std::int32_t>(-128, zero_point));
+
+        float zp = static_cast<float>(zero_point);
+        for (size_t i = 0; i < n; ++i) {
+            float q = std::nearbyint(static_cast<float>(src[i]) * inv_scale) + zp;
+            q = std::min(127.0f, std::max(-128.0f, q));
+            dst[i].value = static_cast<std::int8_t>(q);
+        }
+
+        params.scale = scale;
+        params.zero_point = zero_point;
+    }
+
+    static void decode(const QInt8* src, T* dst, size_t n, const Params& params) {
+        const T scale = static_cast<T>(params.scale);
+        const T zp = static_cast<T>(params.zero_point);
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = (static_cast<T>(src[i].value) - zp) * scale;
+        }
+    }
+};
+
+} // namespace detail
+
+} // namespace JABuff
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <cstddef>      // For size_t
+#include <string>       // For std::to_string
+#include <algorithm>    // For std::min
+
+#include "RingSpan.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief What FrameView does with samples after the last complete frame.
+ */
+enum class TailPolicy {
+    Drop,    // Only complete frames, exactly like FramingRingBuffer2D
+    ZeroPad  // Extra frames until every sample is covered, zero-padded past the end
+};
+
+/**
+ * @brief A 2-D strided view of frames: frame k of a channel is
+ * [data + k * hop_stride, data + k * hop_stride + frame_size).
+ */
+template <typename T>
+struct StridedFrames {
+    const T* data = nullptr;
+    size_t num_frames = 0;
+    size_t frame_size = 0;
+    size_t hop_stride = 0;
+
+    const T* frame(size_t k) const { return data + k * hop_stride; }
+};
+
+/**
+ * @brief Ring-free framing over a signal that is already in memory (or mmap'd).
+ *
+ * Offline counterpart of FramingRingBuffer2D: the same frame_size / hop_size /
+ * min_frames rules, but frames are simply strided windows into the caller's
+ * signal, so nothing is copied. frame() returns a RingSpan, the view type of the
+ * streaming peek(), so code written against streaming views runs unchanged on
+ * offline data. Complete frames are always one contiguous run; a zero-padded tail
+ * frame is the remaining signal followed by a run of zeros.
+ *
+ * The signal must outlive the view.
+ *
+ * @tparam T The sample type.
+ */
+template <typename T>
+class FrameView {
+public:
+    /**
+     * @brief Frames a single-channel signal.
+     *
+     * @param data The signal.
+     * @param length The number of samples.
+     * @param frame_size Samples per frame.
+     * @param hop_size Samples between frame starts.
+     * @param min_frames Fewer frames than this yield none (as a streaming read would fail).
+     * @param tail What to do with samples after the last complete frame.
+     * @throws std::invalid_argument if frame_size or hop_size is 0.
+     */
+    FrameView(const T* data, size_t length, size_t frame_size, size_t hop_size, size_t min_frames = 1,
+              TailPolicy tail = TailPolicy::Drop);
+
+    /**
+     * @brief Frames a multi-channel signal [channel][sample] (all channels the same length).
+     * @throws std::invalid_argument if the signal is empty, ragged, or frame / hop size is 0.
+     */
+    FrameView(const std::vector<std::vector<T>>& signal, size_t frame_size, size_t hop_size, size_t min_frames = 1,
+              TailPolicy tail = TailPolicy::Drop);
+
+    /**
+     * @brief Returns the number of frames: getNumFullFrames() plus any padded tail frames.
+     */
+    size_t getNumFrames() const;
+
+    /**
+     * @brief Returns the number of frames that lie entirely inside the signal.
+     */
+    size_t getNumFullFrames() const;
+
+    /**
+     * @brief Returns a zero-copy view of one frame of one channel.
+     * @throws std::out_of_range if channel or frame_index is out of range.
+     */
+    RingSpan<const T> frame(size_t channel, size_t frame_index) const;
+
+    /**
+     * @brief Returns the block a streaming read(num_frames) would return from first_frame on.
+     *
+     * Covers (num_frames - 1) * hop + frame_size samples; contiguous unless it reaches into the padded tail.
+     * @throws std::out_of_range if the frames are out of range.
+     */
+    RingSpan<const T> block(size_t channel, size_t first_frame, size_t num_frames) const;
+
+    /**
+     * @brief Returns the complete frames of a channel as one strided 2-D view.
+     * @throws std::out_of_range if channel is out of range.
+     */
+    StridedFrames<T> strided(size_t channel) const;
+
+    size_t getNumChannels() const;
+    size_t getLength() const;
+    size_t getFrameSize() const;
+    size_t getHopSize() const;
+    size_t getMinFrames() const;
+    TailPolicy getTailPolicy() const;
+
+private:
+    void init();
+    void checkChannel(size_t channel) const;
+    RingSpan<const T> range(size_t channel, size_t start, size_t count) const;
+
+    std::vector<const T*> m_channels;
+    size_t m_length;
+    size_t m_frame_size;
+    size_t m_hop_size;
+    size_t m_min_frames;
+    TailPolicy m_tail;
+    size_t m_full_frames;
+    size_t m_num_frames;
+    std::vector<T> m_zeros; // Padding source for tail frames
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+FrameView<T>::FrameView(const T* data, size_t length, size_t frame_size, size_t hop_size, size_t min_frames, TailPolicy tail)
+    : m_channels(1, data),
+      m_length(length),
+      m_frame_size(frame_size),
+      m_hop_size(hop_size),
+      m_min_frames(min_frames),
+      m_tail(tail),
+      m_full_frames(0),
+      m_num_frames(0) {
+    init();
+}
+
+template <typename T>
+FrameView<T>::FrameView(const std::vector<std::vector<T>>& signal, size_t frame_size, size_t hop_size, size_t min_frames, TailPolicy tail)
+    : m_length(0),
+      m_frame_size(frame_size),
+      m_hop_size(hop_size),
+      m_min_frames(min_frames),
+      m_tail(tail),
+      m_full_frames(0),
+      m_num_frames(0) {
+
+    if (signal.empty()) {
+        throw std::invalid_argument("Signal must have at least one channel.");
+    }
+    m_length = signal[0].size();
+    for (const auto& channel : signal) {
+        if (channel.size() != m_length) {
+            throw std::invalid_argument("Signal channels have inconsistent sizes.");
+        }
+        m_channels.push_back(channel.data());
+    }
+    init();
+}
+
+template <typename T>
+void FrameView<T>::init() {
+    if (m_frame_size == 0 || m_hop_size == 0) {
+        throw std::invalid_argument("Frame size and hop size must be non-zero.");
+    }
+
+    // Same count as FramingRingBuffer2D::getAvailableFramesRead() with the whole signal written.
+    m_full_frames = (m_length < m_frame_size) ? 0 : 1 + (m_length - m_frame_size) / m_hop_size;
+    m_num_frames = m_full_frames;
+
+    if (m_tail == TailPolicy::ZeroPad && m_length > 0) {
+        // Smallest n with (n - 1) * hop + frame_size >= length.
+        m_num_frames = (m_length <= m_frame_size) ? 1 : 1 + (m_length - m_frame_size + m_hop_size - 1) / m_hop_size;
+        m_zeros.assign(m_frame_size, static_cast<T>(0));
+    }
+
+    if (m_num_frames < m_min_frames) {
+        m_full_frames = 0;
+        m_num_frames = 0;
+    }
+}
+
+template <typename T>
+void FrameView<T>::checkChannel(size_t channel) const {
+    if (channel >= m_channels.size()) {
+        throw std::out_of_range("Channel " + std::to_string(channel) + " out of range (" + std::to_string(m_channels.size()) + " channels).");
+    }
+}
+
+template <typename T>
+RingSpan<const T> FrameView<T>::range(size_t channel, size_t start, size_t count) const {
+    // Signal samples first, then zeros for anything past the end.
+    RingSpan<const T> view;
+    size_t valid = (start < m_length) ? std::min(count, m_length - start) : 0;
+    view.first = (valid > 0) ? m_channels[channel] + start : m_zeros.data();
+    view.first_size = (valid > 0) ? valid : count;
+    view.second = m_zeros.data();
+    view.second_size = (valid > 0) ? count - valid : 0;
+    return view;
+}
+
+template <typename T>
+RingSpan<const T> FrameView<T>::frame(size_t channel, size_t frame_index) const {
+    checkChannel(channel);
+    if (frame_index >= m_num_frames) {
+        throw std::out_of_range("Frame " + std::to_string(frame_index) + " out of range (" + std::to_string(m_num_frames) + " frames).");
+    }
+    return range(channel, frame_index * m_hop_size, m_frame_size);
+}
+
+template <typename T>
+RingSpan<const T> FrameView<T>::block(size_t channel, size_t first_frame, size_t num_frames) const {
+    checkChannel(channel);
+    if (num_frames == 0 || first_frame + num_frames > m_num_frames) {
+        throw std::out_of_range("Frames [" + std::to_string(first_frame) + ", " + std::to_string(first_frame + num_frames) +
+                                ") out of range (" + std::to_string(m_num_frames) + " frames).");
+    }
+
+    size_t count = (num_frames - 1) * m_hop_size + m_frame_size;
+    size_t start = first_frame * m_hop_size;
+    if (start + count > m_length && start + count - m_length > m_frame_size) {
+        // Only a tail frame's worth of zeros is kept; blocks spanning more padding cannot be viewed.
+        throw std::out_of_range("Block reaches further into the padding than one frame.");
+    }
+    return range(channel, start, count);
+}
+
+template <typename T>
+StridedFrames<T> FrameView<T>::strided(size_t channel) const {
+    checkChannel(channel);
+    StridedFrames<T> view;
+    view.data = m_channels[channel];
+    view.num_frames = m_full_frames;
+    view.frame_size = m_frame_size;
+    view.hop_stride = m_hop_size;
+    return view;
+}
+
+template <typename T>
+size_t FrameView<T>::getNumFrames() const { return m_num_frames; }
+
+template <typename T>
+size_t FrameView<T>::getNumFullFrames() const { return m_full_frames; }
+
+template <typename T>
+size_t FrameView<T>::getNumChannels() const { return m_channels.size(); }
+
+template <typename T>
+size_t FrameView<T>::getLength() const { return m_length; }
+
+template <typename T>
+size_t FrameView<T>::getFrameSize() const { return m_frame_size; }
+
+template <typename T>
+size_t FrameView<T>::getHopSize() const { return m_hop_size; }
+
+template <typename T>
+size_t FrameView<T>::getMinFrames() const { return m_min_frames; }
+
+template <typename T>
+TailPolicy FrameView<T>::getTailPolicy() const { return m_tail; }
+
+} // namespace JABuff
@@ -1,11 +1,19 @@
 #pragma once
 
 #include <vector>       // For std::vector
-#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range, std::logic_error
 #include <cstring>      // For std::memcpy
 #include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint64_t
+#include <cmath>        // For std::sqrt
 #include <string>       // For std::to_string
-#include <algorithm>    // For std::min
+#include <algorithm>    // For std::min, std::find, std::remove, std::fill
+#include <numeric>      // For std::gcd
+
+#include "RingSpan.hpp"
+#include "WriteObserver.hpp"
+#include "TensorExport.hpp"
+#include "BufferState.hpp"
 
 namespace JABuff {
 
@@ -57,6 +65,32 @@ public:
      */
     bool push(const std::vector<T>& frame_data);
 
+    /**
+     * @brief Reserves space for count samples per channel at the write head.
+     *
+     * Returns one writable view per channel (two runs if the space wraps, see RingSpan).
+     * Produce the samples straight into the views, then call commit(). Nothing becomes
+     * readable until then, and a new reserve() simply replaces an uncommitted one.
+     * write(), push(), clear() and loadState() discard an uncommitted reservation.
+     *
+     * @param count The number of samples per channel.
+     * @param spans_out One view per channel. Resized automatically.
+     * @return true if the space is available, false if the buffer is too full.
+     */
+    bool reserve(size_t count, std::vector<RingSpan<T>>& spans_out);
+
+    /**
+     * @brief Publishes count samples per channel written into reserved space.
+     *
+     * Updates running statistics and notifies observers like write().
+     *
+     * The reservation shrinks by count, so a reservation can be committed in pieces.
+     *
+     * @param count The number of samples to publish (<= the reserved count).
+     * @throws std::out_of_range if count exceeds what is still reserved.
+     */
+    void commit(size_t count);
+
     /**
      * @brief Primes the buffer with enough samples (default 0) so that the next write of 'hop_size'
      * samples will make the buffer ready to read 'min_frames'.
@@ -84,6 +118,8 @@ public:
      * It returns a single continuous vector representing the union of the requested frames.
      * * Total output size = (num_frames - 1) * hop_size + frame_size.
      * To access Frame 'i' from this buffer, read starting at index (i * hop_size).
+     * With a fractional hop (setFractionalHop()), frame 'i' starts at getFrameOffset(i),
+     * queried before the read.
      * * @param buffer_out Output vector [channel][samples]. Resized automatically.
      * @param num_frames The number of frames to read. 
      * If 0, reads ALL available frames.
@@ -93,6 +129,233 @@ public:
      */
     bool read(std::vector<std::vector<T>>& buffer_out, size_t num_frames = 1);
 
+    /**
+     * @brief Returns zero-copy views of the block read() would return, without consuming it.
+     *
+     * Same frame selection rules as read(). Each view covers
+     * (num_frames - 1) * hop_size + frame_size samples of one channel and may wrap
+     * (see RingSpan). Views stay valid until the next write.
+     * Pair with advance() to consume the frames afterwards.
+     *
+     * @param views_out One view per channel. Resized automatically.
+     * @param num_frames The number of frames to view. 0 = all available.
+     * @return true if the frames are available.
+     */
+    bool peek(std::vector<RingSpan<const T>>& views_out, size_t num_frames = 1) const;
+
+    /**
+     * @brief Reads like read(), copying only the listed channels, in the listed order.
+     *
+     * buffer_out[i] receives channel channels[i]. Channels not listed are not touched,
+     * so the copy cost scales with channels.size(). Indices may repeat.
+     * Frame selection and consumption are the same as read().
+     *
+     * @param buffer_out Output vector [selected channel][samples]. Resized automatically.
+     * @param channels The channel indices to read.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @return true if the frames were successfully read.
+     * @throws std::out_of_range if a channel index is out of range.
+     */
+    bool read(std::vector<std::vector<T>>& buffer_out, const std::vector<size_t>& channels, size_t num_frames = 1);
+
+    /**
+     * @brief Returns zero-copy views of the listed channels, in the listed order (see peek()).
+     * @throws std::out_of_range if a channel index is out of range.
+     */
+    bool peek(std::vector<RingSpan<const T>>& views_out, const std::vector<size_t>& channels, size_t num_frames = 1) const;
+
+    /**
+     * @brief Reads like read(), mixing the channels down with a matrix while copying.
+     *
+     * buffer_out[m][i] = sum_n matrix[m][n] * x[n][i], e.g. a mono downmix, a fixed
+     * delay-and-sum beam or an ambisonic decode. The block is processed in cache-sized
+     * tiles, so every input sample is read from the ring once and every output sample
+     * written once; zero coefficients are skipped.
+     *
+     * @param matrix Mixing matrix [output][input channel].
+     * @param buffer_out Output vector [output][samples]. Resized automatically.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @return true if the frames were successfully read.
+     * @throws std::invalid_argument if the matrix is empty or a row does not have one entry per channel.
+     */
+    bool readMixed(const std::vector<std::vector<T>>& matrix, std::vector<std::vector<T>>& buffer_out, size_t num_frames = 1);
+
+    /**
+     * @brief Consumes frames exactly as read() would, without copying anything.
+     *
+     * Honors keep_frames, so peek(n) followed by advance(n) is equivalent to read(n).
+     *
+     * @param num_frames The number of frames to consume. 0 = all available.
+     * @return true if the frames were available.
+     */
+    bool advance(size_t num_frames = 1);
+
+    /**
+     * @brief Reads frames unfolded into a GEMM-ready matrix (im2col).
+     *
+     * Row i holds frame i of every channel back to back:
+     * [ch0 frame i | ch1 frame i | ...], i.e. channels * frame_size values, followed
+     * by zero padding up to row_stride. A strided 1-D conv with kernel = frame_size and
+     * stride = hop_size is then a single GEMM of this matrix with the weights.
+     * Overlapping samples are duplicated across rows. Frame selection and
+     * consumption are the same as read().
+     *
+     * @param matrix_out Caller tensor of at least num_frames * row_stride elements.
+     * @param row_stride Elements per row. Must be >= channels * frame_size.
+     * @param num_frames The number of frames (rows) to read. Must be > 0.
+     * @return true if the frames were successfully read.
+     * @throws std::invalid_argument if num_frames is 0 or row_stride is too small.
+     */
+    bool readUnfolded(T* matrix_out, size_t row_stride, size_t num_frames);
+
+    /**
+     * @brief Reads frames unfolded into a vector (see readUnfolded(T*, ...)).
+     *
+     * @param matrix_out Output [frames * row_stride]. Resized automatically.
+     * @param row_stride_out Receives the row stride: channels * frame_size rounded up to simd_width.
+     * @param num_frames The number of frames to read. 0 = all available.
+     * @param simd_width Row padding multiple in elements (e.g. 16 floats = 64 bytes).
+     * @return true if the frames were successfully read.
+     */
+    bool readUnfolded(std::vector<T>& matrix_out, size_t& row_stride_out, size_t num_frames = 1, size_t simd_width = 16);
+
+    /**
+     * @brief Returns channels * frame_size rounded up to a multiple of simd_width.
+     */
+    size_t getUnfoldedRowStride(size_t simd_width = 16) const;
+
+    /**
+     * @brief Exports the block read() would return as a DLPack tensor, without consuming it.
+     *
+     * The tensor has shape [channels][samples] with strides [capacity, 1], where
+     * samples = (num_frames - 1) * hop_size + frame_size. If the block does not wrap
+     * it points into ring storage and pins it: writes that would overwrite it are
+     * refused (getAvailableWrite() shrinks) until the tensor is released, even after
+     * advance(). A wrapped block is copied into the tensor instead.
+     *
+     * @param out The tensor to fill. Any previous export it held is released first.
+     * @param num_frames The number of frames to export. 0 = all available.
+     * @return true if the frames are available.
+     */
+    bool exportFrames(ExportedTensor<T>& out, size_t num_frames = 1);
+
+    /**
+     * @brief Returns true while any exported tensor pins ring storage.
+     */
+    bool isPinned() const;
+
+    /**
+     * @brief Sets a rational hop of numerator / denominator samples (e.g. 441 / 2 = 220.5).
+     *
+     * Frame starts are tracked with an exact integer accumulator, so there is no drift:
+     * frame k starts at k * numerator / denominator samples past the first frame. By
+     * default each start is rounded to the nearest sample. With interpolate = true,
+     * readUnfolded() instead produces each frame at its exact fractional start by
+     * linear interpolation (frames then need one extra sample of lookahead); the other
+     * reads return the covering block, with frames at the integer part of their start.
+     *
+     * getAvailableFramesRead() stays O(1). getHopSizeFeatures() returns the hop rounded down.
+     * The fractional phase restarts at the current read position.
+     *
+     * @param numerator The hop numerator.
+     * @param denominator The hop denominator.
+     * @param interpolate Interpolate fractional frame starts in readUnfolded().
+     * @throws std::invalid_argument if either is 0 or the hop is below one sample.
+     */
+    void setFractionalHop(size_t numerator, size_t denominator, bool interpolate = false);
+
+    size_t getHopNumerator() const;
+    size_t getHopDenominator() const;
+    bool isHopInterpolated() const;
+
+    /**
+     * @brief Returns where available frame 'frame_index' starts, in samples past the read position.
+     *
+     * This is its index in the block the next read() returns: frame_index * hop_size
+     * for an integer hop, the rounded (or, when interpolating, truncated) exact start
+     * for a fractional one.
+     */
+    size_t getFrameOffset(size_t frame_index) const;
+
+    /**
+     * @brief Keeps the most recently consumed samples from being overwritten.
+     *
+     * Up to history_samples samples behind the read position stay in the ring after
+     * they are consumed, so extractHistory() can look back before the read cursor
+     * (e.g. the 2 s preceding a wake word). Retention only limits how far the write
+     * head may advance (getAvailableWrite() shrinks by the retained amount); reads
+     * and writes copy nothing extra. 0 disables retention.
+     *
+     * @param history_samples The number of consumed samples to keep per channel.
+     * @throws std::invalid_argument if history_samples + frame_size exceeds capacity.
+     */
+    void setHistoryRetention(size_t history_samples);
+    size_t getHistoryRetention() const;
+
+    /**
+     * @brief Absolute stream positions (samples per channel since construction or clear()).
+     *
+     * Read position: the first unconsumed sample. Write position: one past the newest
+     * sample. Oldest retained position: the oldest sample extractHistory() can return.
+     */
+    std::uint64_t getReadPosition() const;
+    std::uint64_t getWritePosition() const;
+    std::uint64_t getOldestRetainedPosition() const;
+
+    /**
+     * @brief Returns zero-copy views of the samples [from_sample, to_sample) by absolute position.
+     *
+     * The range may cover retained history and unread samples alike. Views stay
+     * valid until the next write.
+     *
+     * @param from_sample The absolute position of the first sample.
+     * @param to_sample The absolute position one past the last sample.
+     * @param views_out One view per channel. Resized automatically.
+     * @return true if the whole range is held, false if part of it was overwritten or not yet written.
+     * @throws std::invalid_argument if from_sample > to_sample.
+     */
+    bool extractHistory(std::uint64_t from_sample, std::uint64_t to_sample, std::vector<RingSpan<const T>>& views_out) const;
+
+    /**
+     * @brief Copies the samples [from_sample, to_sample) by absolute position (see the view overload).
+     *
+     * @param buffer_out Output vector [channel][samples]. Resized automatically.
+     */
+    bool extractHistory(std::uint64_t from_sample, std::uint64_t to_sample, std::vector<std::vector<T>>& buffer_out) const;
+
+    /**
+     * @brief Appends a snapshot of the buffer to out (versioned binary, see BufferState.hpp).
+     *
+     * The snapshot holds the geometry, the cursors (absolute position, fractional hop phase),
+     * the hop and history settings and every held sample: unread ones and retained history.
+     */
+    void saveState(std::vector<std::uint8_t>& out) const;
+
+    /**
+     * @brief Appends the same snapshot as gather segments (for writeState() / writev()).
+     *
+     * The samples are not copied: the segments point into the ring and an internal header,
+     * and stay valid until the buffer is modified or saved again.
+     */
+    void saveState(std::vector<StateSegment>& segments_out) const;
+
+    /**
+     * @brief Restores a snapshot taken by saveState(), replacing the contents and cursors.
+     *
+     * The buffer is ready to read immediately (no priming needed). Statistics are rebuilt if
+     * enabled. Observers get onClear() followed by onWrite() of the restored samples, oldest
+     * first, as if they had just been written; anything older than the snapshot holds reads as
+     * zero to them, as after clear().
+     *
+     * @param data The snapshot; may be followed by further data (e.g. the next session's snapshot).
+     * @param size The bytes available at data.
+     * @return The size of the snapshot consumed.
+     * @throws std::runtime_error if the snapshot is malformed, truncated, of another version or sample type.
+     * @throws std::invalid_argument if its channels, capacity, frame size, min or keep frames differ from this buffer's.
+     * @throws std::logic_error if exported tensors pin the buffer.
+     */
+    size_t loadState(const void* data, size_t size);
+
     size_t getAvailableFramesRead() const;
     size_t getAvailableFeaturesRead() const;
     size_t getAvailableWrite() const;
@@ -106,21 +369,160 @@ public:
     bool isEmpty() const;
     void clear();
 
+    /**
+     * @brief Attaches an observer that is notified of every accepted write (see WriteObserver).
+     * The buffer does not take ownership. Attaching the same observer twice has no effect.
+     */
+    void addObserver(WriteObserver<T>* observer);
+
+    /**
+     * @brief Detaches a previously attached observer.
+     */
+    void removeObserver(WriteObserver<T>* observer);
+
+    /**
+     * @brief Starts maintaining per-channel prefix sums of x and x^2 (in double).
+     *
+     * Once enabled, the sum, energy, mean and variance of any available frame are
+     * O(1) queries. Every write costs one extra pass over the new samples. Samples
+     * already in the buffer are included. To limit floating-point drift the prefix
+     * sums are rebuilt from the stored samples once per 'capacity' samples written
+     * (amortised O(1) per sample).
+     *
+     * Memory: 2 * (capacity + 1) doubles per channel.
+     */
+    void enableRunningStats();
+
+    /**
+     * @brief Stops maintaining running statistics and frees their memory.
+     */
+    void disableRunningStats();
+
+    bool isRunningStatsEnabled() const;
+
+    /**
+     * @brief Sum of the samples of an available frame.
+     * @param channel The channel index.
+     * @param frame_index The frame, counted from the next frame read() would return (0).
+     * @throws std::logic_error if running statistics are not enabled.
+     * @throws std::out_of_range if channel or frame_index is out of range.
+     */
+    double getFrameSum(size_t channel, size_t frame_index = 0) const;
+
+    /**
+     * @brief Energy (sum of x^2) of an available frame. See getFrameSum() for parameters.
+     */
+    double getFrameEnergy(size_t channel, size_t frame_index = 0) const;
+
+    /**
+     * @brief Mean of an available frame. See getFrameSum() for parameters.
+     */
+    double getFrameMean(size_t channel, size_t frame_index = 0) const;
+
+    /**
+     * @brief Population variance of an available frame. See getFrameSum() for parameters.
+     */
+    double getFrameVariance(size_t channel, size_t frame_index = 0) const;
+
+    /**
+     * @brief Root mean square of an available frame. See getFrameSum() for parameters.
+     */
+    double getFrameRms(size_t channel, size_t frame_index = 0) const;
+
+    /**
+     * @brief Configures the energy gate used by readGated().
+     *
+     * A frame is silent when its mean square (over all channels and samples) is
+     * below power_threshold. Silent frames still pass the gate when they fall
+     * within hangover_frames after a loud frame (keeps speech tails), or when one
+     * of the next lookahead_frames already-available frames is loud (keeps onsets).
+     *
+     * @param power_threshold Mean-square threshold (linear, e.g. 1e-4 for -40 dBFS).
+     * @param hangover_frames Frames kept after the last loud frame.
+     * @param lookahead_frames Available frames inspected ahead for an onset.
+     */
+    void setEnergyGate(double power_threshold, size_t hangover_frames = 0, size_t lookahead_frames = 0);
+
+    /**
+     * @brief Reads the next frame through the energy gate.
+     *
+     * Consumes one frame exactly like read(buffer_out, 1). Silent frames are
+     * consumed without being copied: buffer_out is left untouched and is_silent is
+     * set. Frame energy comes from the running statistics when enabled (O(1)),
+     * otherwise from a read-only sum-of-squares pass over the ring.
+     *
+     * @param buffer_out Output vector [channel][samples] (written only for non-silent frames).
+     * @param is_silent Set to true if the frame was gated.
+     * @return true if a frame was consumed, false if no frame was available.
+     */
+    bool readGated(std::vector<std::vector<T>>& buffer_out, bool& is_silent);
+
+    /**
+     * @brief Returns the mean square (over all channels) of an available frame.
+     * @throws std::out_of_range if frame_index is not available.
+     */
+    double getFramePower(size_t frame_index = 0) const;
+
 private:
     // --- Helpers ---
     void validateWriteInput(const std::vector<std::vector<T>>& data_in, size_t offset, size_t num_to_write, size_t& calculated_write_size) const;
+    bool resolveReadCount(size_t num_frames, size_t& count_to_read) const;
+    void consumeFrames(size_t count_read);
+    void validateChannels(const std::vector<size_t>& channels) const;
+    void copyChannelBlock(size_t channel, T* dest, size_t count) const;
+    RingSpan<const T> channelView(size_t channel, size_t count) const;
+    void mixRun(const std::vector<std::vector<T>>& matrix, size_t ring_pos, size_t count, std::vector<std::vector<T>>& buffer_out, size_t out_pos) const;
+    void unfoldFrames(T* matrix_out, size_t row_stride, size_t count) const;
+    size_t framesSpanFeatures(size_t num_frames) const;
+    size_t frameOffset(size_t frame_index) const;
+    T frameFraction(size_t frame_index) const;
+    void notifyObservers(const T* const* channels, size_t count);
+    void updateRunningStats(const T* const* channels, size_t count);
+    void rebuildRunningStats();
+    void frameRangeSums(size_t channel, size_t frame_index, double& sum, double& sum_sq) const;
+    static double sumOfSquares(const T* data, size_t count);
+    T* channelData(size_t channel) { return m_buffer.data() + channel * m_capacity_features; }
+    const T* channelData(size_t channel) const { return m_buffer.data() + channel * m_capacity_features; }
 
     // --- Member Variables ---
-    std::vector<std::vector<T>> m_buffer; 
+    detail::PinRegistry m_pins; // Read positions of zero-copy exported tensors
+
+    // Layout: [channel][capacity] in one allocation (channel c starts at c * capacity)
+    std::vector<T> m_buffer; 
     size_t m_num_channels;
     size_t m_capacity_features;
     size_t m_frame_size_features;
     size_t m_hop_size_features;
+    // Hop = m_hop_num / m_hop_den samples; the read position's fractional part is m_hop_phase / m_hop_den
+    size_t m_hop_num;
+    size_t m_hop_den;
+    size_t m_hop_phase;
+    bool m_hop_interpolate;
     size_t m_min_frames;
     size_t m_keep_frames;
     size_t m_write_index_features;
     size_t m_read_index_features;
     size_t m_available_features;
+    std::uint64_t m_total_written_features; // Absolute stream position of the write head
+    size_t m_history_retention; // Consumed samples protected from being overwritten
+    size_t m_reserved;          // Samples reserved at the write head and not yet committed
+
+    std::vector<WriteObserver<T>*> m_observers;
+    std::vector<const T*> m_observer_ptrs; // [channel], scratch for notifications
+
+    mutable std::vector<std::uint8_t> m_state_header; // Header segment of the last saveState()
+
+    // Running statistics: exclusive prefix sums indexed by absolute position mod (capacity + 1)
+    bool m_stats_enabled;
+    std::vector<std::vector<double>> m_prefix_sum;    // [channel][capacity + 1]
+    std::vector<std::vector<double>> m_prefix_sum_sq; // [channel][capacity + 1]
+    size_t m_stats_since_rebuild;
+
+    // Energy gate
+    double m_gate_threshold;
+    size_t m_gate_hangover_frames;
+    size_t m_gate_lookahead_frames;
+    size_t m_gate_hangover_left;
 };
 
 // ===================================================================
@@ -133,11 +535,24 @@ FramingRingBuffer2D<T>::FramingRingBuffer2D(size_t num_channels, size_t capacity
       m_capacity_features(capacity_features),
       m_frame_size_features(frame_size_features),
       m_hop_size_features(hop_size_features),
+      m_hop_num(hop_size_features),
+      m_hop_den(1),
+      m_hop_phase(0),
+      m_hop_interpolate(false),
       m_min_frames(min_frames),
       m_keep_frames(keep_frames),
       m_write_index_features(0),
       m_read_index_features(0),
-      m_available_features(0) {
+      m_available_features(0),
+      m_total_written_features(0),
+      m_history_retention(0),
+      m_reserved(0),
+      m_stats_enabled(false),
+      m_stats_since_rebuild(0),
+      m_gate_threshold(0.0),
+      m_gate_hangover_frames(0),
+      m_gate_lookahead_frames(0),
+      m_gate_hangover_left(0) {
 
     if (num_channels == 0 || capacity_features == 0) {
         throw std::invalid_argument("Channels and capacity must be non-zero.");
@@ -149,10 +564,8 @@ FramingRingBuffer2D<T>::FramingRingBuffer2D(size_t num_channels, size_t capacity
         throw std::invalid_argument("Hop size must be non-zero.");
     }
 
-    m_buffer.resize(m_num_channels);
-    for (size_t c = 0; c < m_num_channels; ++c) {
-        m_buffer[c].resize(m_capacity_features);
-    }
+    m_buffer.resize(m_num_channels * m_capacity_features);
+    m_observer_ptrs.resize(m_num_channels);
 }
 
 template <typename T>
@@ -208,7 +621,7 @@ bool FramingRingBuffer2D<T>::write(const std::vector<std::vector<T>>& data_in, s
     // 3. Perform Write
     for (size_t c = 0; c < m_num_channels; ++c) {
         const T* source_data = data_in[c].data() + offset;
-        T* buffer_data = m_buffer[c].data();
+        T* buffer_data = channelData(c);
 
         size_t write_pos = m_write_index_features;
         size_t space_to_end = m_capacity_features - write_pos;
@@ -222,7 +635,17 @@ bool FramingRingBuffer2D<T>::write(const std::vector<std::vector<T>>& data_in, s
     }
 
     m_write_index_features = (m_write_index_features + actual_write_size) % m_capacity_features;
+    m_reserved = 0;
     m_available_features += actual_write_size;
+    m_total_written_features += actual_write_size;
+
+    if (m_stats_enabled || !m_observers.empty()) {
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            m_observer_ptrs[c] = data_in[c].data() + offset;
+        }
+        if (m_stats_enabled) updateRunningStats(m_observer_ptrs.data(), actual_write_size);
+        notifyObservers(m_observer_ptrs.data(), actual_write_size);
+    }
 
     return true;
 }
@@ -242,19 +665,78 @@ bool FramingRingBuffer2D<T>::push(const std::vector<T>& frame_data) {
 
     // 3. Perform Write
     for (size_t c = 0; c < m_num_channels; ++c) {
-        m_buffer[c][m_write_index_features] = frame_data[c];
+        channelData(c)[m_write_index_features] = frame_data[c];
     }
 
     m_write_index_features = (m_write_index_features + 1) % m_capacity_features;
+    m_reserved = 0;
     m_available_features++;
+    m_total_written_features++;
+
+    if (m_stats_enabled || !m_observers.empty()) {
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            m_observer_ptrs[c] = &frame_data[c];
+        }
+        if (m_stats_enabled) updateRunningStats(m_observer_ptrs.data(), 1);
+        notifyObservers(m_observer_ptrs.data(), 1);
+    }
 
     return true;
 }
 
+template <typename T>
+bool FramingRingBuffer2D<T>::reserve(size_t count, std::vector<RingSpan<T>>& spans_out) {
+    if (count > getAvailableWrite()) {
+        return false;
+    }
+
+    size_t first = std::min(count, m_capacity_features - m_write_index_features);
+    m_reserved = count;
+    spans_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        RingSpan<T>& span = spans_out[c];
+        span.first = channelData(c) + m_write_index_features;
+        span.first_size = first;
+        span.second = channelData(c);
+        span.second_size = count - first;
+    }
+    return true;
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::commit(size_t count) {
+    // Anything past the reservation was never produced: publishing it would expose stale samples.
+    if (count > m_reserved) {
+        throw std::out_of_range("Commit of " + std::to_string(count) + " samples exceeds the " +
+                                std::to_string(m_reserved) + " reserved.");
+    }
+    m_reserved -= count;
+
+    // Publish run by run so statistics and observers see contiguous blocks.
+    while (count > 0) {
+        size_t run = std::min(count, m_capacity_features - m_write_index_features);
+        size_t run_start = m_write_index_features;
+
+        m_write_index_features = (m_write_index_features + run) % m_capacity_features;
+        m_available_features += run;
+        m_total_written_features += run;
+
+        if (m_stats_enabled || !m_observers.empty()) {
+            for (size_t c = 0; c < m_num_channels; ++c) {
+                m_observer_ptrs[c] = channelData(c) + run_start;
+            }
+            if (m_stats_enabled) updateRunningStats(m_observer_ptrs.data(), run);
+            notifyObservers(m_observer_ptrs.data(), run);
+        }
+
+        count -= run;
+    }
+}
+
 template <typename T>
 void FramingRingBuffer2D<T>::prime(T value) {
     // Calculate total features needed to satisfy min_frames requirement
-    size_t target_features = (m_min_frames - 1) * m_hop_size_features + m_frame_size_features;
+    size_t target_features = framesSpanFeatures(m_min_frames);
     
     // We want the NEXT hop to make it ready, so we need (Target - Hop) now.
     size_t samples_to_prime = 0;
@@ -278,9 +760,7 @@ bool FramingRingBuffer2D<T>::ready() const {
 }
 
 template <typename T>
-bool FramingRingBuffer2D<T>::read(std::vector<std::vector<T>>& buffer_out, size_t num_frames) {
-    // Use the new ready() method logic internally if appropriate, 
-    // but read() also needs to check if *num_frames* are available if > 0.
+bool FramingRingBuffer2D<T>::resolveReadCount(size_t num_frames, size_t& count_to_read) const {
     size_t available = getAvailableFramesRead();
 
     // Check minimum frames requirement
@@ -288,8 +768,6 @@ bool FramingRingBuffer2D<T>::read(std::vector<std::vector<T>>& buffer_out, size_
         return false;
     }
 
-    size_t count_to_read = 0;
-
     // Logic for "Read All" vs "Read Specific Amount"
     if (num_frames == 0) {
         count_to_read = available;
@@ -301,59 +779,593 @@ bool FramingRingBuffer2D<T>::read(std::vector<std::vector<T>>& buffer_out, size_
         count_to_read = num_frames;
     }
 
+    return true;
+}
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::frameOffset(size_t frame_index) const {
+    if (m_hop_den == 1) return frame_index * m_hop_num;
+
+    // Exact start = (phase + k * num) / den samples; round to nearest unless interpolating.
+    std::uint64_t exact = static_cast<std::uint64_t>(m_hop_phase) + static_cast<std::uint64_t>(frame_index) * m_hop_num;
+    std::uint64_t bias = m_hop_interpolate ? 0 : m_hop_den;
+    return static_cast<size_t>((2 * exact + bias) / (2 * static_cast<std::uint64_t>(m_hop_den)));
+}
+
+template <typename T>
+T FramingRingBuffer2D<T>::frameFraction(size_t frame_index) const {
+    if (!m_hop_interpolate) return static_cast<T>(0);
+    std::uint64_t exact = static_cast<std::uint64_t>(m_hop_phase) + static_cast<std::uint64_t>(frame_index) * m_hop_num;
+    return static_cast<T>(static_cast<double>(exact % m_hop_den) / static_cast<double>(m_hop_den));
+}
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::framesSpanFeatures(size_t num_frames) const {
+    // Size = start of the last frame + frame_size (+ 1 interpolation sample)
+    return frameOffset(num_frames - 1) + m_frame_size_features + (m_hop_interpolate ? 1 : 0);
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::consumeFrames(size_t count_read) {
+    // Update actual member variables based on consumption logic (hop size & keep frames)
+    size_t frames_consumed = 0;
+    if (count_read > m_keep_frames) {
+        frames_consumed = count_read - m_keep_frames;
+    }
+
+    // The read position moves by the integer part of the exact advance; the rest stays in the phase.
+    size_t exact = m_hop_phase + frames_consumed * m_hop_num;
+    size_t features_consumed = exact / m_hop_den;
+    m_hop_phase = exact % m_hop_den;
+
+    m_read_index_features = (m_read_index_features + features_consumed) % m_capacity_features;
+    m_available_features -= features_consumed;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::read(std::vector<std::vector<T>>& buffer_out, size_t num_frames) {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read)) {
+        return false;
+    }
+
     if (count_to_read == 0) {
         buffer_out.clear();
         return false;
     }
 
     // Calculate total continuous samples needed to cover these frames
-    // Size = (N-1) * hop + frame_size
     // This creates a contiguous block of memory with NO duplicates.
-    size_t total_samples_per_channel = (count_to_read - 1) * m_hop_size_features + m_frame_size_features;
+    size_t total_samples_per_channel = framesSpanFeatures(count_to_read);
     
     buffer_out.resize(m_num_channels);
     for(size_t c = 0; c < m_num_channels; ++c) {
         buffer_out[c].resize(total_samples_per_channel);
-        
-        T* dest_data = buffer_out[c].data();
-        const T* buffer_data = m_buffer[c].data();
+        copyChannelBlock(c, buffer_out[c].data(), total_samples_per_channel);
+    }
 
-        size_t space_to_end = m_capacity_features - m_read_index_features;
+    consumeFrames(count_to_read);
 
-        // Perform single continuous copy (with wrap check)
-        if (total_samples_per_channel > space_to_end) {
-            std::memcpy(dest_data, buffer_data + m_read_index_features, space_to_end * sizeof(T));
-            std::memcpy(dest_data + space_to_end, buffer_data, (total_samples_per_channel - space_to_end) * sizeof(T));
-        } else {
-            std::memcpy(dest_data, buffer_data + m_read_index_features, total_samples_per_channel * sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::peek(std::vector<RingSpan<const T>>& views_out, size_t num_frames) const {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total = framesSpanFeatures(count_to_read);
+
+    views_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        views_out[c] = channelView(c, total);
+    }
+
+    return true;
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::validateChannels(const std::vector<size_t>& channels) const {
+    for (size_t c : channels) {
+        if (c >= m_num_channels) {
+            throw std::out_of_range("Channel " + std::to_string(c) + " out of range (" + std::to_string(m_num_channels) + " channels).");
         }
     }
+}
 
-    // Update actual member variables based on consumption logic (hop size & keep frames)
-    size_t frames_consumed = 0;
-    if (count_to_read > m_keep_frames) {
-        frames_consumed = count_to_read - m_keep_frames;
+template <typename T>
+void FramingRingBuffer2D<T>::copyChannelBlock(size_t channel, T* dest, size_t count) const {
+    const T* buffer_data = channelData(channel);
+    size_t space_to_end = m_capacity_features - m_read_index_features;
+
+    // Perform single continuous copy (with wrap check)
+    if (count > space_to_end) {
+        std::memcpy(dest, buffer_data + m_read_index_features, space_to_end * sizeof(T));
+        std::memcpy(dest + space_to_end, buffer_data, (count - space_to_end) * sizeof(T));
+    } else {
+        std::memcpy(dest, buffer_data + m_read_index_features, count * sizeof(T));
     }
+}
+
+template <typename T>
+RingSpan<const T> FramingRingBuffer2D<T>::channelView(size_t channel, size_t count) const {
+    size_t space_to_end = m_capacity_features - m_read_index_features;
+    RingSpan<const T> view;
+    view.first = channelData(channel) + m_read_index_features;
+    view.first_size = std::min(count, space_to_end);
+    view.second = channelData(channel);
+    view.second_size = count - view.first_size;
+    return view;
+}
 
-    size_t features_consumed = frames_consumed * m_hop_size_features;
+template <typename T>
+bool FramingRingBuffer2D<T>::read(std::vector<std::vector<T>>& buffer_out, const std::vector<size_t>& channels, size_t num_frames) {
+    validateChannels(channels);
 
-    m_read_index_features = (m_read_index_features + features_consumed) % m_capacity_features;
-    m_available_features -= features_consumed;
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total = framesSpanFeatures(count_to_read);
+
+    buffer_out.resize(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        buffer_out[i].resize(total);
+        copyChannelBlock(channels[i], buffer_out[i].data(), total);
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::peek(std::vector<RingSpan<const T>>& views_out, const std::vector<size_t>& channels, size_t num_frames) const {
+    validateChannels(channels);
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total = framesSpanFeatures(count_to_read);
+
+    views_out.resize(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        views_out[i] = channelView(channels[i], total);
+    }
+
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::readMixed(const std::vector<std::vector<T>>& matrix, std::vector<std::vector<T>>& buffer_out, size_t num_frames) {
+    if (matrix.empty()) {
+        throw std::invalid_argument("Mixing matrix must have at least one row.");
+    }
+    for (const auto& row : matrix) {
+        if (row.size() != m_num_channels) {
+            throw std::invalid_argument("Mixing matrix row size (" + std::to_string(row.size()) +
+                                        ") does not match buffer channels (" + std::to_string(m_num_channels) + ").");
+        }
+    }
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total = framesSpanFeatures(count_to_read);
+    buffer_out.resize(matrix.size());
+    for (auto& out : buffer_out) {
+        out.resize(total);
+    }
+
+    // At most two contiguous runs (wrap)
+    size_t first = std::min(total, m_capacity_features - m_read_index_features);
+    mixRun(matrix, m_read_index_features, first, buffer_out, 0);
+    if (first < total) {
+        mixRun(matrix, 0, total - first, buffer_out, first);
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::mixRun(const std::vector<std::vector<T>>& matrix, size_t ring_pos, size_t count,
+                                    std::vector<std::vector<T>>& buffer_out, size_t out_pos) const {
+    // Tiles keep the N input slices in L1 while the M outputs are accumulated.
+    const size_t kTile = 256;
+    for (size_t start = 0; start < count; start += kTile) {
+        const size_t len = std::min(kTile, count - start);
+        for (size_t m = 0; m < matrix.size(); ++m) {
+            T* out = buffer_out[m].data() + out_pos + start;
+            std::fill(out, out + len, static_cast<T>(0));
+            for (size_t n = 0; n < m_num_channels; ++n) {
+                const T w = matrix[m][n];
+                if (w == static_cast<T>(0)) continue;
+                const T* in = channelData(n) + ring_pos + start;
+                for (size_t i = 0; i < len; ++i) {
+                    out[i] += w * in[i];
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::advance(size_t num_frames) {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::getUnfoldedRowStride(size_t simd_width) const {
+    size_t row = m_num_channels * m_frame_size_features;
+    if (simd_width <= 1) return row;
+    return (row + simd_width - 1) / simd_width * simd_width;
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::unfoldFrames(T* matrix_out, size_t row_stride, size_t count) const {
+    const size_t row = m_num_channels * m_frame_size_features;
+    for (size_t i = 0; i < count; ++i) {
+        T* dst = matrix_out + i * row_stride;
+        size_t start = (m_read_index_features + frameOffset(i)) % m_capacity_features;
+        size_t first = std::min(m_frame_size_features, m_capacity_features - start);
+        const T frac = frameFraction(i);
+
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            const T* src = channelData(c);
+            if (frac == static_cast<T>(0)) {
+                std::memcpy(dst, src + start, first * sizeof(T));
+                if (first < m_frame_size_features) {
+                    std::memcpy(dst + first, src, (m_frame_size_features - first) * sizeof(T));
+                }
+            } else {
+                // Linear interpolation between neighbouring samples at the fractional start.
+                size_t pos = start;
+                for (size_t k = 0; k < m_frame_size_features; ++k) {
+                    size_t next = (pos + 1 == m_capacity_features) ? 0 : pos + 1;
+                    dst[k] = src[pos] + frac * (src[next] - src[pos]);
+                    pos = next;
+                }
+            }
+            dst += m_frame_size_features;
+        }
+
+        if (row_stride > row) {
+            std::fill(dst, dst + (row_stride - row), static_cast<T>(0));
+        }
+    }
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::readUnfolded(T* matrix_out, size_t row_stride, size_t num_frames) {
+    if (num_frames == 0) {
+        throw std::invalid_argument("readUnfolded into a caller tensor needs an explicit frame count.");
+    }
+    if (row_stride < m_num_channels * m_frame_size_features) {
+        throw std::invalid_argument("Row stride (" + std::to_string(row_stride) + ") is smaller than channels * frame_size (" +
+                                    std::to_string(m_num_channels * m_frame_size_features) + ").");
+    }
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    unfoldFrames(matrix_out, row_stride, count_to_read);
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::readUnfolded(std::vector<T>& matrix_out, size_t& row_stride_out, size_t num_frames, size_t simd_width) {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    row_stride_out = getUnfoldedRowStride(simd_width);
+    matrix_out.resize(count_to_read * row_stride_out);
+    unfoldFrames(matrix_out.data(), row_stride_out, count_to_read);
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::exportFrames(ExportedTensor<T>& out, size_t num_frames) {
+    out.release();
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total = framesSpanFeatures(count_to_read);
+    std::int64_t shape[2] = {static_cast<std::int64_t>(m_num_channels), static_cast<std::int64_t>(total)};
+
+    if (m_read_index_features + total <= m_capacity_features) {
+        std::int64_t strides[2] = {static_cast<std::int64_t>(m_capacity_features), 1};
+        std::uint64_t read_abs = m_total_written_features - m_available_features;
+        out.set(channelData(0) + m_read_index_features, 2, shape, strides, count_to_read, &m_pins, read_abs);
+    } else {
+        // Wrapped: gather into the tensor's own storage.
+        T* dst = out.staging(m_num_channels * total);
+        size_t first = m_capacity_features - m_read_index_features;
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            std::memcpy(dst + c * total, channelData(c) + m_read_index_features, first * sizeof(T));
+            std::memcpy(dst + c * total + first, channelData(c), (total - first) * sizeof(T));
+        }
+        std::int64_t strides[2] = {static_cast<std::int64_t>(total), 1};
+        out.set(dst, 2, shape, strides, count_to_read, nullptr, 0);
+    }
+
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::isPinned() const { return !m_pins.empty(); }
+
+template <typename T>
+void FramingRingBuffer2D<T>::setFractionalHop(size_t numerator, size_t denominator, bool interpolate) {
+    if (numerator == 0 || denominator == 0) {
+        throw std::invalid_argument("Hop numerator and denominator must be non-zero.");
+    }
+    if (numerator < denominator) {
+        throw std::invalid_argument("Hop must be at least one sample.");
+    }
+
+    size_t g = std::gcd(numerator, denominator);
+    m_hop_num = numerator / g;
+    m_hop_den = denominator / g;
+    m_hop_phase = 0;
+    m_hop_interpolate = interpolate;
+    m_hop_size_features = m_hop_num / m_hop_den;
+}
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::getHopNumerator() const { return m_hop_num; }
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::getHopDenominator() const { return m_hop_den; }
+
+template <typename T>
+bool FramingRingBuffer2D<T>::isHopInterpolated() const { return m_hop_interpolate; }
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::getFrameOffset(size_t frame_index) const { return frameOffset(frame_index); }
+
+template <typename T>
+void FramingRingBuffer2D<T>::setHistoryRetention(size_t history_samples) {
+    if (history_samples + m_frame_size_features > m_capacity_features) {
+        throw std::invalid_argument("History retention (" + std::to_string(history_samples) + ") plus frame size exceeds capacity (" +
+                                    std::to_string(m_capacity_features) + ").");
+    }
+    m_history_retention = history_samples;
+}
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::getHistoryRetention() const { return m_history_retention; }
+
+template <typename T>
+std::uint64_t FramingRingBuffer2D<T>::getReadPosition() const { return m_total_written_features - m_available_features; }
+
+template <typename T>
+std::uint64_t FramingRingBuffer2D<T>::getWritePosition() const { return m_total_written_features; }
+
+template <typename T>
+std::uint64_t FramingRingBuffer2D<T>::getOldestRetainedPosition() const {
+    std::uint64_t read_abs = getReadPosition();
+    std::uint64_t oldest = read_abs - std::min<std::uint64_t>(m_history_retention, read_abs);
+    // Retention enabled late cannot bring back samples the write head already lapped.
+    if (m_total_written_features > m_capacity_features) {
+        oldest = std::max<std::uint64_t>(oldest, m_total_written_features - m_capacity_features);
+    }
+    return oldest;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::extractHistory(std::uint64_t from_sample, std::uint64_t to_sample, std::vector<RingSpan<const T>>& views_out) const {
+    if (from_sample > to_sample) {
+        throw std::invalid_argument("History range start (" + std::to_string(from_sample) + ") is after its end (" +
+                                    std::to_string(to_sample) + ").");
+    }
+    if (from_sample < getOldestRetainedPosition() || to_sample > m_total_written_features) {
+        return false;
+    }
+
+    // The write index is the write position mod capacity.
+    size_t count = static_cast<size_t>(to_sample - from_sample);
+    size_t back = static_cast<size_t>(m_total_written_features - from_sample);
+    size_t start = (m_write_index_features + m_capacity_features - back) % m_capacity_features;
+    size_t first = std::min(count, m_capacity_features - start);
+
+    views_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        RingSpan<const T>& view = views_out[c];
+        view.first = channelData(c) + start;
+        view.first_size = first;
+        view.second = channelData(c);
+        view.second_size = count - first;
+    }
+    return true;
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::extractHistory(std::uint64_t from_sample, std::uint64_t to_sample, std::vector<std::vector<T>>& buffer_out) const {
+    std::vector<RingSpan<const T>> views;
+    if (!extractHistory(from_sample, to_sample, views)) {
+        return false;
+    }
 
+    buffer_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        buffer_out[c].resize(views[c].size());
+        views[c].copyTo(buffer_out[c].data());
+    }
     return true;
 }
 
+template <typename T>
+void FramingRingBuffer2D<T>::saveState(std::vector<std::uint8_t>& out) const {
+    std::vector<StateSegment> segments;
+    saveState(segments);
+    appendState(segments, out);
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::saveState(std::vector<StateSegment>& segments_out) const {
+    const size_t held = static_cast<size_t>(m_total_written_features - getOldestRetainedPosition());
+
+    detail::StateHeaderWriter header(m_state_header, "JB2D", sizeof(T), detail::StateSampleTypeOf<T>::value);
+    header.put(m_num_channels);
+    header.put(m_capacity_features);
+    header.put(m_frame_size_features);
+    header.put(m_min_frames);
+    header.put(m_keep_frames);
+    header.put(m_hop_num);
+    header.put(m_hop_den);
+    header.put(m_hop_phase);
+    header.put(m_hop_interpolate ? 1 : 0);
+    header.put(m_history_retention);
+    header.put(m_total_written_features);
+    header.put(m_available_features);
+    header.put(held);
+    header.finish(m_num_channels * held * sizeof(T));
+
+    segments_out.push_back({m_state_header.data(), m_state_header.size()});
+    const size_t start = (m_write_index_features + m_capacity_features - held) % m_capacity_features;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        detail::appendRingSegments(channelData(c), m_capacity_features, start, held, segments_out);
+    }
+}
+
+template <typename T>
+size_t FramingRingBuffer2D<T>::loadState(const void* data, size_t size) {
+    if (!m_pins.empty()) {
+        throw std::logic_error("Cannot load state while exported tensors pin the buffer.");
+    }
+
+    detail::StateReader reader(data, size, "JB2D", sizeof(T), detail::StateSampleTypeOf<T>::value, 13);
+    const std::uint64_t channels = reader.get();
+    const std::uint64_t capacity = reader.get();
+    const std::uint64_t frame_size = reader.get();
+    const std::uint64_t min_frames = reader.get();
+    const std::uint64_t keep_frames = reader.get();
+    if (channels != m_num_channels || capacity != m_capacity_features || frame_size != m_frame_size_features ||
+        min_frames != m_min_frames || keep_frames != m_keep_frames) {
+        throw std::invalid_argument("Snapshot geometry (" + std::to_string(channels) + " channels, capacity " + std::to_string(capacity) +
+                                    ", frame " + std::to_string(frame_size) + ") does not match this buffer.");
+    }
+
+    const std::uint64_t hop_num = reader.get();
+    const std::uint64_t hop_den = reader.get();
+    const std::uint64_t hop_phase = reader.get();
+    const std::uint64_t hop_interpolate = reader.get();
+    const std::uint64_t retention = reader.get();
+    const std::uint64_t total = reader.get();
+    const std::uint64_t available = reader.get();
+    const std::uint64_t held = reader.get();
+    if (hop_num == 0 || hop_den == 0 || hop_num < hop_den || std::gcd(hop_num, hop_den) != 1 || hop_phase >= hop_den || retention + m_frame_size_features > m_capacity_features ||
+        available > held || held > m_capacity_features || held > total) {
+        throw std::runtime_error("Snapshot cursors are inconsistent.");
+    }
+    const std::uint8_t* samples = reader.take(static_cast<size_t>(m_num_channels * held * sizeof(T)));
+    const size_t consumed = reader.finish();
+
+    m_hop_num = static_cast<size_t>(hop_num);
+    m_hop_den = static_cast<size_t>(hop_den);
+    m_hop_phase = static_cast<size_t>(hop_phase);
+    m_hop_interpolate = hop_interpolate != 0;
+    m_hop_size_features = m_hop_num / m_hop_den;
+    m_history_retention = static_cast<size_t>(retention);
+    m_total_written_features = total;
+    m_available_features = static_cast<size_t>(available);
+    m_write_index_features = static_cast<size_t>(total % m_capacity_features);
+    m_reserved = 0;
+    m_read_index_features = (m_write_index_features + m_capacity_features - m_available_features) % m_capacity_features;
+    m_gate_hangover_left = 0;
+
+    const size_t start = (m_write_index_features + m_capacity_features - static_cast<size_t>(held)) % m_capacity_features;
+    const size_t channel_bytes = static_cast<size_t>(held) * sizeof(T);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        detail::copyIntoRing(channelData(c), m_capacity_features, start, samples + c * channel_bytes, static_cast<size_t>(held));
+    }
+
+    if (m_stats_enabled) {
+        rebuildRunningStats();
+    }
+
+    // Replay the restored samples run by run, with the write position advancing as in commit().
+    m_total_written_features = total - held;
+    for (WriteObserver<T>* observer : m_observers) {
+        observer->onClear();
+    }
+    size_t pos = start;
+    size_t left = static_cast<size_t>(held);
+    while (left > 0 && !m_observers.empty()) {
+        size_t run = std::min(left, m_capacity_features - pos);
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            m_observer_ptrs[c] = channelData(c) + pos;
+        }
+        m_total_written_features += run;
+        notifyObservers(m_observer_ptrs.data(), run);
+        pos = (pos + run) % m_capacity_features;
+        left -= run;
+    }
+    m_total_written_features = total;
+    return consumed;
+}
+
 template <typename T>
 size_t FramingRingBuffer2D<T>::getAvailableFramesRead() const {
-    if (m_available_features < m_frame_size_features) return 0;
-    return 1 + (m_available_features - m_frame_size_features) / m_hop_size_features;
+    const size_t needed = m_frame_size_features + (m_hop_interpolate ? 1 : 0);
+    if (m_available_features < needed) return 0;
+    if (m_hop_den == 1 && !m_hop_interpolate) {
+        return 1 + (m_available_features - m_frame_size_features) / m_hop_num;
+    }
+
+    // Count k with frameOffset(k) <= available - needed, i.e. 2 * (phase + k * num) + bias < limit.
+    const std::uint64_t den2 = 2 * static_cast<std::uint64_t>(m_hop_den);
+    const std::uint64_t limit = den2 * (m_available_features - needed + 1);
+    const std::uint64_t base = 2 * static_cast<std::uint64_t>(m_hop_phase) + (m_hop_interpolate ? 0 : m_hop_den);
+    if (base >= limit) return 0;
+    return static_cast<size_t>(1 + (limit - 1 - base) / (2 * static_cast<std::uint64_t>(m_hop_num)));
 }
 
 template <typename T>
 size_t FramingRingBuffer2D<T>::getAvailableFeaturesRead() const { return m_available_features; }
 
 template <typename T>
-size_t FramingRingBuffer2D<T>::getAvailableWrite() const { return m_capacity_features - m_available_features; }
+size_t FramingRingBuffer2D<T>::getAvailableWrite() const {
+    size_t free_features = m_capacity_features - m_available_features;
+    if (m_history_retention > 0) {
+        std::uint64_t read_abs = m_total_written_features - m_available_features;
+        size_t held = static_cast<size_t>(std::min<std::uint64_t>(m_history_retention, read_abs));
+        free_features -= std::min(free_features, held);
+    }
+    if (m_pins.empty()) return free_features;
+
+    // The write head may not lap the oldest pinned read position.
+    std::uint64_t limit = m_pins.oldest() + m_capacity_features;
+    size_t pinned_free = static_cast<size_t>(limit - m_total_written_features);
+    return std::min(free_features, pinned_free);
+}
 
 template <typename T>
 size_t FramingRingBuffer2D<T>::getCapacity() const { return m_capacity_features; }
@@ -381,9 +1393,256 @@ bool FramingRingBuffer2D<T>::isEmpty() const { return getAvailableFeaturesRead()
 
 template <typename T>
 void FramingRingBuffer2D<T>::clear() {
+    if (!m_pins.empty()) {
+        throw std::logic_error("Cannot clear while exported tensors pin the buffer.");
+    }
+
     m_write_index_features = 0;
     m_read_index_features = 0;
+    m_reserved = 0;
     m_available_features = 0;
+    m_total_written_features = 0;
+    m_hop_phase = 0;
+    m_gate_hangover_left = 0;
+
+    if (m_stats_enabled) {
+        rebuildRunningStats();
+    }
+
+    for (WriteObserver<T>* observer : m_observers) {
+        observer->onClear();
+    }
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::addObserver(WriteObserver<T>* observer) {
+    if (observer == nullptr) return;
+    if (std::find(m_observers.begin(), m_observers.end(), observer) == m_observers.end()) {
+        m_observers.push_back(observer);
+    }
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::removeObserver(WriteObserver<T>* observer) {
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), observer), m_observers.end());
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::notifyObservers(const T* const* channels, size_t count) {
+    for (WriteObserver<T>* observer : m_observers) {
+        observer->onWrite(channels, m_num_channels, count);
+    }
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::enableRunningStats() {
+    if (m_stats_enabled) return;
+    m_prefix_sum.assign(m_num_channels, std::vector<double>(m_capacity_features + 1, 0.0));
+    m_prefix_sum_sq.assign(m_num_channels, std::vector<double>(m_capacity_features + 1, 0.0));
+    m_stats_enabled = true;
+    rebuildRunningStats();
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::disableRunningStats() {
+    m_stats_enabled = false;
+    std::vector<std::vector<double>>().swap(m_prefix_sum);
+    std::vector<std::vector<double>>().swap(m_prefix_sum_sq);
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::isRunningStatsEnabled() const { return m_stats_enabled; }
+
+template <typename T>
+void FramingRingBuffer2D<T>::updateRunningStats(const T* const* channels, size_t count) {
+    // Called after the write head was advanced past the 'count' new samples.
+    const size_t modulus = m_capacity_features + 1;
+    std::uint64_t block_start = m_total_written_features - count;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        double* prefix = m_prefix_sum[c].data();
+        double* prefix_sq = m_prefix_sum_sq[c].data();
+        size_t slot = static_cast<size_t>(block_start % modulus);
+        double sum = prefix[slot];
+        double sum_sq = prefix_sq[slot];
+        for (size_t i = 0; i < count; ++i) {
+            double x = static_cast<double>(channels[c][i]);
+            sum += x;
+            sum_sq += x * x;
+            if (++slot == modulus) slot = 0;
+            prefix[slot] = sum;
+            prefix_sq[slot] = sum_sq;
+        }
+    }
+
+    // Re-anchor once per capacity worth of samples to bound drift
+    m_stats_since_rebuild += count;
+    if (m_stats_since_rebuild >= m_capacity_features) {
+        rebuildRunningStats();
+    }
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::rebuildRunningStats() {
+    // Recompute from the stored samples, anchored at 0 on the read head.
+    const size_t modulus = m_capacity_features + 1;
+    std::uint64_t read_abs = m_total_written_features - m_available_features;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        const T* data = channelData(c);
+        double* prefix = m_prefix_sum[c].data();
+        double* prefix_sq = m_prefix_sum_sq[c].data();
+        size_t slot = static_cast<size_t>(read_abs % modulus);
+        size_t pos = m_read_index_features;
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        prefix[slot] = 0.0;
+        prefix_sq[slot] = 0.0;
+        for (size_t i = 0; i < m_available_features; ++i) {
+            double x = static_cast<double>(data[pos]);
+            sum += x;
+            sum_sq += x * x;
+            if (++pos == m_capacity_features) pos = 0;
+            if (++slot == modulus) slot = 0;
+            prefix[slot] = sum;
+            prefix_sq[slot] = sum_sq;
+        }
+    }
+    m_stats_since_rebuild = 0;
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::frameRangeSums(size_t channel, size_t frame_index, double& sum, double& sum_sq) const {
+    if (!m_stats_enabled) {
+        throw std::logic_error("Running statistics are not enabled.");
+    }
+    if (channel >= m_num_channels) {
+        throw std::out_of_range("Channel " + std::to_string(channel) + " out of range.");
+    }
+    if (frame_index >= getAvailableFramesRead()) {
+        throw std::out_of_range("Frame " + std::to_string(frame_index) + " is not available (" +
+                                std::to_string(getAvailableFramesRead()) + " frames available).");
+    }
+
+    const size_t modulus = m_capacity_features + 1;
+    std::uint64_t start = m_total_written_features - m_available_features + frameOffset(frame_index);
+    size_t begin_slot = static_cast<size_t>(start % modulus);
+    size_t end_slot = static_cast<size_t>((start + m_frame_size_features) % modulus);
+    sum = m_prefix_sum[channel][end_slot] - m_prefix_sum[channel][begin_slot];
+    sum_sq = m_prefix_sum_sq[channel][end_slot] - m_prefix_sum_sq[channel][begin_slot];
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::getFrameSum(size_t channel, size_t frame_index) const {
+    double sum = 0.0, sum_sq = 0.0;
+    frameRangeSums(channel, frame_index, sum, sum_sq);
+    return sum;
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::getFrameEnergy(size_t channel, size_t frame_index) const {
+    double sum = 0.0, sum_sq = 0.0;
+    frameRangeSums(channel, frame_index, sum, sum_sq);
+    return sum_sq < 0.0 ? 0.0 : sum_sq;
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::getFrameMean(size_t channel, size_t frame_index) const {
+    return getFrameSum(channel, frame_index) / static_cast<double>(m_frame_size_features);
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::getFrameVariance(size_t channel, size_t frame_index) const {
+    double sum = 0.0, sum_sq = 0.0;
+    frameRangeSums(channel, frame_index, sum, sum_sq);
+    double n = static_cast<double>(m_frame_size_features);
+    double mean = sum / n;
+    double variance = sum_sq / n - mean * mean;
+    return variance < 0.0 ? 0.0 : variance;
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::getFrameRms(size_t channel, size_t frame_index) const {
+    return std::sqrt(getFrameEnergy(channel, frame_index) / static_cast<double>(m_frame_size_features));
+}
+
+template <typename T>
+void FramingRingBuffer2D<T>::setEnergyGate(double power_threshold, size_t hangover_frames, size_t lookahead_frames) {
+    m_gate_threshold = power_threshold;
+    m_gate_hangover_frames = hangover_frames;
+    m_gate_lookahead_frames = lookahead_frames;
+    m_gate_hangover_left = 0;
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::sumOfSquares(const T* data, size_t count) {
+    // Independent accumulators so the loop vectorises without -ffast-math
+    T acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        for (size_t k = 0; k < 8; ++k) {
+            acc[k] += data[i + k] * data[i + k];
+        }
+    }
+    double total = 0.0;
+    for (size_t k = 0; k < 8; ++k) total += static_cast<double>(acc[k]);
+    for (; i < count; ++i) total += static_cast<double>(data[i]) * static_cast<double>(data[i]);
+    return total;
+}
+
+template <typename T>
+double FramingRingBuffer2D<T>::getFramePower(size_t frame_index) const {
+    if (frame_index >= getAvailableFramesRead()) {
+        throw std::out_of_range("Frame " + std::to_string(frame_index) + " is not available (" +
+                                std::to_string(getAvailableFramesRead()) + " frames available).");
+    }
+
+    double energy = 0.0;
+    if (m_stats_enabled) {
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            energy += getFrameEnergy(c, frame_index);
+        }
+    } else {
+        size_t start = (m_read_index_features + frameOffset(frame_index)) % m_capacity_features;
+        size_t first_run = std::min(m_frame_size_features, m_capacity_features - start);
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            const T* data = channelData(c);
+            energy += sumOfSquares(data + start, first_run);
+            energy += sumOfSquares(data, m_frame_size_features - first_run);
+        }
+    }
+
+    return energy / static_cast<double>(m_num_channels * m_frame_size_features);
+}
+
+template <typename T>
+bool FramingRingBuffer2D<T>::readGated(std::vector<std::vector<T>>& buffer_out, bool& is_silent) {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(1, count_to_read)) {
+        return false;
+    }
+
+    bool loud = getFramePower(0) >= m_gate_threshold;
+    if (loud) {
+        m_gate_hangover_left = m_gate_hangover_frames;
+    } else if (m_gate_hangover_left > 0) {
+        --m_gate_hangover_left;
+        loud = true;
+    } else {
+        size_t available = getAvailableFramesRead();
+        for (size_t f = 1; f <= m_gate_lookahead_frames && f < available; ++f) {
+            if (getFramePower(f) >= m_gate_threshold) {
+                loud = true;
+                break;
+            }
+        }
+    }
+
+    is_silent = !loud;
+    if (is_silent) {
+        consumeFrames(1);
+        return true;
+    }
+
+    return read(buffer_out, 1);
 }
 
 } // namespace JABuff
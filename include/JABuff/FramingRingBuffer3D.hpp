@@ -1,11 +1,19 @@
 #pragma once
 
 #include <vector>
-#include <stdexcept>
+#include <stdexcept>  // For std::invalid_argument, std::out_of_range, std::logic_error
 #include <cstring>
 #include <cstddef>
 #include <string>
 #include <algorithm> // For std::min
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+
+#include "FeatureStorage.hpp"
+#include "BandedMatrix.hpp"
+#include "TensorExport.hpp"
+#include "BufferState.hpp"
 
 namespace JABuff {
 
@@ -18,9 +26,15 @@ namespace JABuff {
  *
  * It allows writing blocks of 'time' steps and reading overlapping frames.
  *
- * @tparam T The data type to be stored (e.g., float, double).
+ * The API always speaks T. Internally each time step is stored as StorageT,
+ * converted on write and on read. Using JABuff::Float16 or JABuff::BFloat16
+ * with T = float halves the memory of the ring (and the bytes touched per read).
+ * JABuff::QInt8 quarters it, with a scale/zero-point computed per time step.
+ *
+ * @tparam T The data type of the API (e.g., float, double).
+ * @tparam StorageT The data type held in the ring. Defaults to T (plain memcpy).
  */
-template <typename T>
+template <typename T, typename StorageT = T>
 class FramingRingBuffer3D {
 public:
     /**
@@ -56,6 +70,19 @@ public:
      */
     bool push(const std::vector<std::vector<T>>& time_step_data);
 
+    /**
+     * @brief Writes a single time step by letting a callback fill each channel in place.
+     *
+     * fill(size_t channel, T* features) is called once per channel and must write
+     * feature_dim values. When StorageT == T the pointer refers directly to ring
+     * storage (no intermediate copy); otherwise it is a scratch row encoded afterwards.
+     *
+     * @param fill Callable with signature void(size_t, T*).
+     * @return true if write succeeded, false if buffer full (fill is not called).
+     */
+    template <typename Fill>
+    bool pushInPlace(Fill&& fill);
+
     /**
      * @brief Primes the buffer with enough time steps (default 0) so that the next write of 'hop_size'
      * time steps will make the buffer ready to read 'min_frames'.
@@ -89,6 +116,129 @@ public:
      */
     bool read(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames = 1);
 
+    /**
+     * @brief Reads the raw quantised data without dequantising (QInt8 storage only).
+     *
+     * Same frame selection and consumption rules as read(). The output is
+     * laid out for int8 inference kernels:
+     * - data_out [channel][time * feature_dim], row-major per time step.
+     * - params_out [channel][time], where x ~= scale * (q - zero_point).
+     *
+     * @param data_out Quantised features. Resized automatically.
+     * @param params_out Per-time-step quantisation parameters. Resized automatically.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @return true if the frames were successfully read.
+     */
+    bool readQuantized(std::vector<std::vector<std::int8_t>>& data_out, std::vector<std::vector<QuantParams>>& params_out, size_t num_frames = 1);
+
+    /**
+     * @brief Reads like read(), stacking each time step with its neighbours (splicing).
+     *
+     * Row t of the output is [x(t - left_context), ..., x(t), ..., x(t + right_context)]
+     * for every time step t of the read union, copied straight from ring storage.
+     *
+     * Neighbours come only from the read union itself and, on the left, from the
+     * consumed steps kept by setHistoryRetention(); beyond that the edge step is
+     * repeated (edge replication). The output therefore depends only on the stream
+     * and the sequence of reads, never on how far ahead the writer is or how its
+     * writes were chunked. Rows whose right context runs past the union are edge
+     * replicated; with keep_frames covering right_context steps, those frames are
+     * read again (with their full context) by the next read. Set the history
+     * retention to at least left_context to give the first rows real left context.
+     *
+     * @param buffer_out Output vector [channel][time][(left + 1 + right) * feature]. Resized automatically.
+     * @param left_context Number of past neighbours per row.
+     * @param right_context Number of future neighbours per row.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @return true if the frames were successfully read.
+     */
+    bool readSpliced(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t left_context, size_t right_context, size_t num_frames = 1);
+
+    /**
+     * @brief Reads like read(), appending delta (and delta-delta) features to every row.
+     *
+     * Row t of the output is [x(t), d(t)] (order 1) or [x(t), d(t), dd(t)] (order 2), with
+     * the regression formula
+     *
+     *   d(t) = sum_{n=1..N} n * (x(t+n) - x(t-n)) / (2 * sum_{n=1..N} n^2)
+     *
+     * and dd computed the same way from d. Neighbours follow the same context and
+     * edge-replication rules as readSpliced() (order * N steps of context per side).
+     *
+     * @param buffer_out Output vector [channel][time][(order + 1) * feature]. Resized automatically.
+     * @param order 1 for deltas, 2 for deltas and delta-deltas.
+     * @param delta_window N, the regression half-width.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @return true if the frames were successfully read.
+     * @throws std::invalid_argument if order is not 1 or 2, or delta_window is 0.
+     */
+    bool readWithDeltas(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t order = 2, size_t delta_window = 2, size_t num_frames = 1);
+
+    /**
+     * @brief Registers a projection applied by pushProjected() before storage.
+     *
+     * Storing the projected features (e.g. 80 mel bands instead of 257 FFT bins)
+     * shrinks the ring and saves a pass after reading.
+     *
+     * @param projection The matrix. Its output dimension must equal feature_dim.
+     * @throws std::invalid_argument on a dimension mismatch.
+     */
+    void setWriteProjection(const BandedMatrix<T>& projection);
+
+    /**
+     * @brief Registers a projection applied by readProjected() while copying out.
+     * @param projection The matrix. Its input dimension must equal feature_dim.
+     * @throws std::invalid_argument on a dimension mismatch.
+     */
+    void setReadProjection(const BandedMatrix<T>& projection);
+
+    /**
+     * @brief Removes both projections.
+     */
+    void clearProjections();
+
+    /**
+     * @brief Pushes a single time step after projecting it with the write projection.
+     *
+     * The projection writes straight into ring storage (see pushInPlace()).
+     *
+     * @param time_step_data Input data [channel][write projection input dim].
+     * @return true if write succeeded, false if buffer full.
+     * @throws std::logic_error if no write projection is set.
+     * @throws std::invalid_argument if the channel count or feature size mismatches.
+     */
+    bool pushProjected(const std::vector<std::vector<T>>& time_step_data);
+
+    /**
+     * @brief Reads like read(), projecting every time step with the read projection.
+     *
+     * @param buffer_out Output vector [channel][time][read projection output dim]. Resized automatically.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @return true if the frames were successfully read.
+     * @throws std::logic_error if no read projection is set.
+     */
+    bool readProjected(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames = 1);
+
+    /**
+     * @brief Exports the block read() would return as a DLPack tensor, without consuming it.
+     *
+     * The tensor has shape [channels][time][feature] with strides
+     * [capacity * feature_dim, feature_dim, 1] and the storage dtype (float16 / bfloat16
+     * for half storage). If the block does not wrap it points into ring storage and
+     * pins it (see FramingRingBuffer2D::exportFrames()); a wrapped block is copied.
+     * Not available for storage with per-step parameters (QInt8; use readQuantized()).
+     *
+     * @param out The tensor to fill. Any previous export it held is released first.
+     * @param num_frames The number of frames to export. 0 = all available.
+     * @return true if the frames are available.
+     */
+    bool exportFrames(ExportedTensor<StorageT>& out, size_t num_frames = 1);
+
+    /**
+     * @brief Returns true while any exported tensor pins ring storage.
+     */
+    bool isPinned() const;
+
     size_t getAvailableFramesRead() const;
     size_t getAvailableTimeRead() const;
     size_t getAvailableWrite() const;
@@ -103,12 +253,129 @@ public:
     bool isEmpty() const;
     void clear();
 
+    /**
+     * @brief Keeps the most recently consumed time steps from being overwritten.
+     *
+     * Up to history_steps steps behind the read position stay in the ring after they
+     * are consumed and serve as left context for readSpliced() and readWithDeltas().
+     * Like FramingRingBuffer2D::setHistoryRetention(), retention only limits how far
+     * the write head may advance (getAvailableWrite() shrinks by the retained amount).
+     * 0 disables retention.
+     *
+     * @param history_steps The number of consumed time steps to keep per channel.
+     * @throws std::invalid_argument if history_steps + frame_size exceeds capacity.
+     */
+    void setHistoryRetention(size_t history_steps);
+    size_t getHistoryRetention() const;
+
+    /**
+     * @brief Returns the number of bytes held by the ring storage (all channels),
+     * including per-time-step quantisation parameters if the storage has them.
+     */
+    size_t getStorageBytes() const;
+
+    /**
+     * @brief Appends a snapshot of the buffer to out (versioned binary, see BufferState.hpp).
+     *
+     * The snapshot holds the geometry, the cursors and every time step still in the ring
+     * (unread steps and the consumed ones used for context, deltas and CMVN), in StorageT
+     * together with any per-step quantisation parameters, so nothing is re-encoded.
+     */
+    void saveState(std::vector<std::uint8_t>& out) const;
+
+    /**
+     * @brief Appends the same snapshot as gather segments (for writeState() / writev()).
+     *
+     * The segments point into the ring and an internal header, and stay valid until the
+     * buffer is modified or saved again.
+     */
+    void saveState(std::vector<StateSegment>& segments_out) const;
+
+    /**
+     * @brief Restores a snapshot taken by saveState(), replacing the contents and cursors.
+     *
+     * The buffer is ready to read immediately (no priming needed). CMVN statistics are rebuilt if enabled.
+     *
+     * @param data The snapshot; may be followed by further data.
+     * @param size The bytes available at data.
+     * @return The size of the snapshot consumed.
+     * @throws std::runtime_error if the snapshot is malformed, truncated, of another version or storage type.
+     * @throws std::invalid_argument if its geometry differs from this buffer's.
+     * @throws std::logic_error if exported tensors pin the buffer.
+     */
+    size_t loadState(const void* data, size_t size);
+
+    /**
+     * @brief Starts maintaining per-feature running statistics for CMVN.
+     *
+     * Per channel and feature, the sums of x and x^2 over the most recent
+     * window_time written time steps are kept in double. They are updated as
+     * steps are written and as steps leave the window (O(F) per time step), and
+     * rebuilt from the ring once per 'capacity' time steps to bound drift.
+     * Steps already in the ring are included.
+     *
+     * @param window_time The number of most recent time steps the statistics cover.
+     * @param epsilon Added to the variance before the square root in readNormalized().
+     * @throws std::invalid_argument if window_time is 0 or larger than the capacity.
+     */
+    void enableCMVN(size_t window_time, T epsilon = static_cast<T>(1e-5));
+
+    /**
+     * @brief Stops maintaining CMVN statistics.
+     */
+    void disableCMVN();
+
+    bool isCMVNEnabled() const;
+
+    /**
+     * @brief Reads like read(), applying (x - mean) / std while copying out.
+     *
+     * mean and std are the current per-channel, per-feature window statistics
+     * (see enableCMVN()). Frame selection and consumption are identical to read().
+     *
+     * @param buffer_out Output vector [channel][time][feature]. Resized automatically.
+     * @param num_frames The number of frames to read (0 = all available).
+     * @param normalize_variance If false, only the mean is removed.
+     * @return true if the frames were successfully read.
+     * @throws std::logic_error if CMVN is not enabled.
+     */
+    bool readNormalized(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames = 1, bool normalize_variance = true);
+
+    /**
+     * @brief Returns the current CMVN mean and standard deviation of one channel.
+     * @throws std::logic_error if CMVN is not enabled.
+     * @throws std::out_of_range if channel is out of range.
+     */
+    void getCMVNStats(size_t channel, std::vector<T>& mean_out, std::vector<T>& std_out) const;
+
 private:
+    using Codec = detail::FeatureCodec<T, StorageT>;
+    using StepParams = typename Codec::Params;
+
     // --- Helpers ---
     void validateWriteInput(const std::vector<std::vector<std::vector<T>>>& data_in, size_t offset_time, size_t num_time_steps, size_t& calculated_write_size) const;
+    StorageT* stepPtr(size_t channel, size_t time_pos);
+    const StorageT* stepPtr(size_t channel, size_t time_pos) const;
+    void encodeStep(const T* src, size_t channel, size_t time_pos);
+    void decodeStep(size_t channel, size_t time_pos, T* dst) const;
+    bool resolveReadCount(size_t num_frames, size_t& count_to_read) const;
+    void consumeFrames(size_t count_read);
+    void commitSteps(size_t count);
+    size_t heldBehindRead() const;
+    size_t contextBehindRead() const;
+    size_t contextPos(std::ptrdiff_t rel, std::ptrdiff_t lo, std::ptrdiff_t hi) const;
+    const T* decodedStep(size_t channel, size_t time_pos, T* scratch) const;
+    void cmvnRemoveLeaving(size_t channel, std::uint64_t new_step_abs);
+    void cmvnAddStep(size_t channel, std::uint64_t step_abs);
+    void rebuildCMVN();
 
     // --- Member Variables ---
-    std::vector<std::vector<std::vector<T>>> m_buffers; 
+    detail::PinRegistry m_pins; // Read positions of zero-copy exported tensors
+
+    // Layout: [channel][time][feature] in one allocation (channel stride = capacity * feature_dim)
+    std::vector<StorageT> m_buffers; 
+    std::vector<std::vector<StepParams>> m_step_params; // [channel][time], only sized if Codec::kHasParams
+    std::vector<T> m_scratch_step; // [feature], staging row for non-identity storage
     size_t m_num_channels;
     size_t m_feature_dim;
     size_t m_capacity_time;
@@ -116,17 +383,41 @@ private:
     size_t m_hop_size_time;
     size_t m_min_frames;
     size_t m_keep_frames;        
+    size_t m_history_retention; // Consumed steps protected from being overwritten
     size_t m_write_index_time;
     size_t m_read_index_time;
     size_t m_available_time;
+    std::uint64_t m_total_written_time; // Absolute position of the write head (== write index mod capacity)
+    mutable std::vector<std::uint8_t> m_state_header; // Header segment of the last saveState()
+
+    // CMVN statistics over the most recent m_cmvn_window written steps
+    bool m_cmvn_enabled;
+    size_t m_cmvn_window;
+    T m_cmvn_epsilon;
+    std::uint64_t m_cmvn_first_abs;  // Oldest step included in the sums
+    size_t m_cmvn_since_rebuild;
+    std::vector<std::vector<double>> m_cmvn_shift;  // [channel][feature], oldest step at the last rebuild
+    std::vector<std::vector<double>> m_cmvn_sum;    // [channel][feature], sum of (x - shift)
+    std::vector<std::vector<double>> m_cmvn_sum_sq; // [channel][feature], sum of (x - shift)^2
+    std::vector<T> m_cmvn_scratch;                  // [feature]
+    std::vector<T> m_cmvn_mean;                     // [feature], readNormalized() staging
+    std::vector<T> m_cmvn_inv_std;                  // [feature], readNormalized() staging
+
+    BandedMatrix<T> m_write_projection;
+    BandedMatrix<T> m_read_projection;
+    std::vector<T> m_projection_scratch; // [feature], readProjected() staging
+
+    // readWithDeltas() staging, [time][feature]
+    std::vector<T> m_context_rows;
+    std::vector<T> m_delta_rows;
 };
 
 // ===================================================================
 // --- Implementation ---
 // ===================================================================
 
-template <typename T>
-FramingRingBuffer3D<T>::FramingRingBuffer3D(size_t num_channels, size_t feature_dim, size_t capacity_time, size_t frame_size_time, size_t hop_size_time, size_t min_frames, size_t keep_frames)
+template <typename T, typename StorageT>
+FramingRingBuffer3D<T, StorageT>::FramingRingBuffer3D(size_t num_channels, size_t feature_dim, size_t capacity_time, size_t frame_size_time, size_t hop_size_time, size_t min_frames, size_t keep_frames)
     : m_num_channels(num_channels),
       m_feature_dim(feature_dim),
       m_capacity_time(capacity_time),
@@ -134,9 +425,16 @@ FramingRingBuffer3D<T>::FramingRingBuffer3D(size_t num_channels, size_t feature_
       m_hop_size_time(hop_size_time),
       m_min_frames(min_frames),
       m_keep_frames(keep_frames),
+      m_history_retention(0),
       m_write_index_time(0),
       m_read_index_time(0),
-      m_available_time(0) {
+      m_available_time(0),
+      m_total_written_time(0),
+      m_cmvn_enabled(false),
+      m_cmvn_window(0),
+      m_cmvn_epsilon(0),
+      m_cmvn_first_abs(0),
+      m_cmvn_since_rebuild(0) {
     
     if (num_channels == 0 || feature_dim == 0 || capacity_time == 0) {
         throw std::invalid_argument("Channels, feature dim, and capacity must be non-zero.");
@@ -148,17 +446,46 @@ FramingRingBuffer3D<T>::FramingRingBuffer3D(size_t num_channels, size_t feature_
         throw std::invalid_argument("Hop size must be non-zero.");
     }
 
-    m_buffers.resize(m_num_channels);
-    for (size_t c = 0; c < m_num_channels; ++c) {
-        m_buffers[c].resize(m_capacity_time);
-        for (size_t t = 0; t < m_capacity_time; ++t) {
-            m_buffers[c][t].resize(m_feature_dim);
-        }
+    m_buffers.resize(m_num_channels * m_capacity_time * m_feature_dim);
+
+    if (Codec::kHasParams) {
+        m_step_params.assign(m_num_channels, std::vector<StepParams>(m_capacity_time));
+    }
+    if (!std::is_same<T, StorageT>::value) {
+        m_scratch_step.resize(m_feature_dim);
+    }
+}
+
+template <typename T, typename StorageT>
+StorageT* FramingRingBuffer3D<T, StorageT>::stepPtr(size_t channel, size_t time_pos) {
+    return m_buffers.data() + (channel * m_capacity_time + time_pos) * m_feature_dim;
+}
+
+template <typename T, typename StorageT>
+const StorageT* FramingRingBuffer3D<T, StorageT>::stepPtr(size_t channel, size_t time_pos) const {
+    return m_buffers.data() + (channel * m_capacity_time + time_pos) * m_feature_dim;
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::encodeStep(const T* src, size_t channel, size_t time_pos) {
+    if constexpr (Codec::kHasParams) {
+        Codec::encode(src, stepPtr(channel, time_pos), m_feature_dim, m_step_params[channel][time_pos]);
+    } else {
+        Codec::encode(src, stepPtr(channel, time_pos), m_feature_dim);
+    }
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::decodeStep(size_t channel, size_t time_pos, T* dst) const {
+    if constexpr (Codec::kHasParams) {
+        Codec::decode(stepPtr(channel, time_pos), dst, m_feature_dim, m_step_params[channel][time_pos]);
+    } else {
+        Codec::decode(stepPtr(channel, time_pos), dst, m_feature_dim);
     }
 }
 
-template <typename T>
-void FramingRingBuffer3D<T>::validateWriteInput(const std::vector<std::vector<std::vector<T>>>& data_in, size_t offset_time, size_t num_time_steps, size_t& calculated_write_size) const {
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::validateWriteInput(const std::vector<std::vector<std::vector<T>>>& data_in, size_t offset_time, size_t num_time_steps, size_t& calculated_write_size) const {
     if (data_in.size() != m_num_channels) {
         throw std::invalid_argument("Input data channel count (" + std::to_string(data_in.size()) + 
                                     ") does not match buffer channels (" + std::to_string(m_num_channels) + ").");
@@ -206,8 +533,8 @@ void FramingRingBuffer3D<T>::validateWriteInput(const std::vector<std::vector<st
     }
 }
 
-template <typename T>
-bool FramingRingBuffer3D<T>::write(const std::vector<std::vector<std::vector<T>>>& data_in, size_t offset_time, size_t num_time_steps) {
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::write(const std::vector<std::vector<std::vector<T>>>& data_in, size_t offset_time, size_t num_time_steps) {
     if (data_in.empty()) return true;
 
     // 1. Validate (Logic Error -> Exception)
@@ -228,20 +555,19 @@ bool FramingRingBuffer3D<T>::write(const std::vector<std::vector<std::vector<T>>
             
             size_t write_pos_time = (m_write_index_time + t) % m_capacity_time;
             
-            T* dest_ptr = m_buffers[c][write_pos_time].data();
-            const T* src_ptr = data_in[c][input_index].data();
-            std::memcpy(dest_ptr, src_ptr, m_feature_dim * sizeof(T));
+            if (m_cmvn_enabled) cmvnRemoveLeaving(c, m_total_written_time + t);
+            encodeStep(data_in[c][input_index].data(), c, write_pos_time);
+            if (m_cmvn_enabled) cmvnAddStep(c, m_total_written_time + t);
         }
     }
 
-    m_write_index_time = (m_write_index_time + actual_write_time) % m_capacity_time;
-    m_available_time += actual_write_time;
+    commitSteps(actual_write_time);
 
     return true;
 }
 
-template <typename T>
-bool FramingRingBuffer3D<T>::push(const std::vector<std::vector<T>>& time_step_data) {
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::push(const std::vector<std::vector<T>>& time_step_data) {
     // 1. Validate sizes
     if (time_step_data.size() != m_num_channels) {
         throw std::invalid_argument("Input channel count (" + std::to_string(time_step_data.size()) + 
@@ -259,19 +585,55 @@ bool FramingRingBuffer3D<T>::push(const std::vector<std::vector<T>>& time_step_d
             throw std::invalid_argument("Feature dimension mismatch at Ch " + std::to_string(c) + ".");
         }
         
-        T* dest_ptr = m_buffers[c][m_write_index_time].data();
-        const T* src_ptr = time_step_data[c].data();
-        std::memcpy(dest_ptr, src_ptr, m_feature_dim * sizeof(T));
+        if (m_cmvn_enabled) cmvnRemoveLeaving(c, m_total_written_time);
+        encodeStep(time_step_data[c].data(), c, m_write_index_time);
+        if (m_cmvn_enabled) cmvnAddStep(c, m_total_written_time);
     }
 
-    m_write_index_time = (m_write_index_time + 1) % m_capacity_time;
-    m_available_time++;
+    commitSteps(1);
 
     return true;
 }
 
-template <typename T>
-void FramingRingBuffer3D<T>::prime(T value) {
+template <typename T, typename StorageT>
+template <typename Fill>
+bool FramingRingBuffer3D<T, StorageT>::pushInPlace(Fill&& fill) {
+    if (getAvailableWrite() < 1) {
+        return false;
+    }
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        if (m_cmvn_enabled) cmvnRemoveLeaving(c, m_total_written_time);
+        if constexpr (std::is_same<T, StorageT>::value) {
+            fill(c, stepPtr(c, m_write_index_time));
+        } else {
+            fill(c, m_scratch_step.data());
+            encodeStep(m_scratch_step.data(), c, m_write_index_time);
+        }
+        if (m_cmvn_enabled) cmvnAddStep(c, m_total_written_time);
+    }
+
+    commitSteps(1);
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::commitSteps(size_t count) {
+    m_write_index_time = (m_write_index_time + count) % m_capacity_time;
+    m_available_time += count;
+    m_total_written_time += count;
+
+    if (m_cmvn_enabled) {
+        m_cmvn_since_rebuild += count;
+        if (m_cmvn_since_rebuild >= m_capacity_time) {
+            rebuildCMVN();
+        }
+    }
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::prime(T value) {
     // Calculate total time steps needed to satisfy min_frames requirement
     size_t target_time = (m_min_frames - 1) * m_hop_size_time + m_frame_size_time;
     
@@ -294,13 +656,13 @@ void FramingRingBuffer3D<T>::prime(T value) {
     }
 }
 
-template <typename T>
-bool FramingRingBuffer3D<T>::ready() const {
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::ready() const {
     return getAvailableFramesRead() >= m_min_frames;
 }
 
-template <typename T>
-bool FramingRingBuffer3D<T>::read(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames) {
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::resolveReadCount(size_t num_frames, size_t& count_to_read) const {
     size_t available = getAvailableFramesRead();
 
     // Check minimum frames requirement
@@ -308,8 +670,6 @@ bool FramingRingBuffer3D<T>::read(std::vector<std::vector<std::vector<T>>>& buff
         return false;
     }
 
-    size_t count_to_read = 0;
-
     // Logic for "Read All" vs "Read Specific Amount"
     if (num_frames == 0) {
         count_to_read = available;
@@ -321,6 +681,30 @@ bool FramingRingBuffer3D<T>::read(std::vector<std::vector<std::vector<T>>>& buff
         count_to_read = num_frames;
     }
 
+    return true;
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::consumeFrames(size_t count_read) {
+    // Update actual member variables based on keep_frames
+    size_t frames_consumed = 0;
+    if (count_read > m_keep_frames) {
+        frames_consumed = count_read - m_keep_frames;
+    }
+
+    size_t time_consumed = frames_consumed * m_hop_size_time;
+
+    m_read_index_time = (m_read_index_time + time_consumed) % m_capacity_time;
+    m_available_time -= time_consumed;
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::read(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames) {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read)) {
+        return false;
+    }
+
     if (count_to_read == 0) {
         buffer_out.clear();
         return false;
@@ -344,70 +728,641 @@ bool FramingRingBuffer3D<T>::read(std::vector<std::vector<std::vector<T>>>& buff
         for (size_t t = 0; t < total_time_steps; ++t) {
             size_t read_pos_time = (m_read_index_time + t) % m_capacity_time;
             
-            T* dest_feature = buffer_out[c][t].data();
-            const T* src_feature = m_buffers[c][read_pos_time].data();
-            std::memcpy(dest_feature, src_feature, m_feature_dim * sizeof(T));
+            decodeStep(c, read_pos_time, buffer_out[c][t].data());
         }
     }
 
-    // Update actual member variables based on keep_frames
-    size_t frames_consumed = 0;
-    if (count_to_read > m_keep_frames) {
-        frames_consumed = count_to_read - m_keep_frames;
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::readQuantized(std::vector<std::vector<std::int8_t>>& data_out, std::vector<std::vector<QuantParams>>& params_out, size_t num_frames) {
+    static_assert(std::is_same<StorageT, QInt8>::value, "readQuantized() requires QInt8 storage.");
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
     }
 
-    size_t time_consumed = frames_consumed * m_hop_size_time;
+    size_t total_time_steps = (count_to_read - 1) * m_hop_size_time + m_frame_size_time;
 
-    m_read_index_time = (m_read_index_time + time_consumed) % m_capacity_time;
-    m_available_time -= time_consumed;
+    data_out.resize(m_num_channels);
+    params_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        data_out[c].resize(total_time_steps * m_feature_dim);
+        params_out[c].resize(total_time_steps);
+
+        // Copy in at most two contiguous runs (before and after the wrap)
+        size_t first_run = std::min(total_time_steps, m_capacity_time - m_read_index_time);
+        std::memcpy(data_out[c].data(), stepPtr(c, m_read_index_time), first_run * m_feature_dim);
+        std::memcpy(params_out[c].data(), m_step_params[c].data() + m_read_index_time, first_run * sizeof(QuantParams));
+        if (total_time_steps > first_run) {
+            size_t second_run = total_time_steps - first_run;
+            std::memcpy(data_out[c].data() + first_run * m_feature_dim, stepPtr(c, 0), second_run * m_feature_dim);
+            std::memcpy(params_out[c].data() + first_run, m_step_params[c].data(), second_run * sizeof(QuantParams));
+        }
+    }
+
+    consumeFrames(count_to_read);
 
     return true;
 }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getAvailableFramesRead() const {
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::saveState(std::vector<std::uint8_t>& out) const {
+    std::vector<StateSegment> segments;
+    saveState(segments);
+    appendState(segments, out);
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::saveState(std::vector<StateSegment>& segments_out) const {
+    const size_t held = m_available_time + heldBehindRead();
+    const size_t step_bytes = m_feature_dim * sizeof(StorageT) + (Codec::kHasParams ? sizeof(StepParams) : 0);
+
+    detail::StateHeaderWriter header(m_state_header, "JB3D", sizeof(StorageT), detail::StateSampleTypeOf<StorageT>::value);
+    header.put(m_num_channels);
+    header.put(m_feature_dim);
+    header.put(m_capacity_time);
+    header.put(m_frame_size_time);
+    header.put(m_hop_size_time);
+    header.put(m_min_frames);
+    header.put(m_keep_frames);
+    header.put(m_history_retention);
+    header.put(m_total_written_time);
+    header.put(m_available_time);
+    header.put(held);
+    header.finish(m_num_channels * held * step_bytes);
+
+    segments_out.push_back({m_state_header.data(), m_state_header.size()});
+    // Steps are contiguous per channel, so a wrapped range is two segments per channel.
+    const size_t start = (m_write_index_time + m_capacity_time - held) % m_capacity_time;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        const StorageT* channel = m_buffers.data() + c * m_capacity_time * m_feature_dim;
+        size_t first = std::min(held, m_capacity_time - start);
+        if (first > 0) segments_out.push_back({channel + start * m_feature_dim, first * m_feature_dim * sizeof(StorageT)});
+        if (held > first) segments_out.push_back({channel, (held - first) * m_feature_dim * sizeof(StorageT)});
+    }
+    if (Codec::kHasParams) {
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            detail::appendRingSegments(m_step_params[c].data(), m_capacity_time, start, held, segments_out);
+        }
+    }
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::loadState(const void* data, size_t size) {
+    if (!m_pins.empty()) {
+        throw std::logic_error("Cannot load state while exported tensors pin the buffer.");
+    }
+
+    detail::StateReader reader(data, size, "JB3D", sizeof(StorageT), detail::StateSampleTypeOf<StorageT>::value, 11);
+    const std::uint64_t channels = reader.get();
+    const std::uint64_t feature_dim = reader.get();
+    const std::uint64_t capacity = reader.get();
+    const std::uint64_t frame_size = reader.get();
+    const std::uint64_t hop_size = reader.get();
+    const std::uint64_t min_frames = reader.get();
+    const std::uint64_t keep_frames = reader.get();
+    const std::uint64_t retention = reader.get();
+    if (channels != m_num_channels || feature_dim != m_feature_dim || capacity != m_capacity_time || frame_size != m_frame_size_time ||
+        hop_size != m_hop_size_time || min_frames != m_min_frames || keep_frames != m_keep_frames) {
+        throw std::invalid_argument("Snapshot geometry (" + std::to_string(channels) + " x " + std::to_string(feature_dim) +
+                                    ", capacity " + std::to_string(capacity) + ", frame " + std::to_string(frame_size) +
+                                    ", hop " + std::to_string(hop_size) + ") does not match this buffer.");
+    }
+
+    const std::uint64_t total = reader.get();
+    const std::uint64_t available = reader.get();
+    const std::uint64_t held = reader.get();
+    if (available > held || held > m_capacity_time || held > total || retention + m_frame_size_time > m_capacity_time) {
+        throw std::runtime_error("Snapshot cursors are inconsistent.");
+    }
+    const size_t steps = static_cast<size_t>(held);
+    const size_t channel_bytes = steps * m_feature_dim * sizeof(StorageT);
+    const std::uint8_t* samples = reader.take(m_num_channels * channel_bytes);
+    const std::uint8_t* params = Codec::kHasParams ? reader.take(m_num_channels * steps * sizeof(StepParams)) : nullptr;
+    const size_t consumed = reader.finish();
+
+    m_history_retention = static_cast<size_t>(retention);
+    m_total_written_time = total;
+    m_available_time = static_cast<size_t>(available);
+    m_write_index_time = static_cast<size_t>(total % m_capacity_time);
+    m_read_index_time = (m_write_index_time + m_capacity_time - m_available_time) % m_capacity_time;
+
+    const size_t start = (m_write_index_time + m_capacity_time - steps) % m_capacity_time;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        StorageT* channel = m_buffers.data() + c * m_capacity_time * m_feature_dim;
+        size_t first = std::min(steps, m_capacity_time - start);
+        const std::uint8_t* src = samples + c * channel_bytes;
+        std::memcpy(channel + start * m_feature_dim, src, first * m_feature_dim * sizeof(StorageT));
+        std::memcpy(channel, src + first * m_feature_dim * sizeof(StorageT), (steps - first) * m_feature_dim * sizeof(StorageT));
+    }
+    if (Codec::kHasParams) {
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            detail::copyIntoRing(m_step_params[c].data(), m_capacity_time, start, params + c * steps * sizeof(StepParams), steps);
+        }
+    }
+
+    if (m_cmvn_enabled) {
+        rebuildCMVN();
+    }
+    return consumed;
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getAvailableFramesRead() const {
     if (m_available_time < m_frame_size_time) return 0;
     return 1 + (m_available_time - m_frame_size_time) / m_hop_size_time;
 }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getAvailableTimeRead() const { return m_available_time; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getAvailableTimeRead() const { return m_available_time; }
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getAvailableWrite() const {
+    size_t free_time = m_capacity_time - m_available_time;
+    if (m_history_retention > 0) {
+        std::uint64_t read_abs = m_total_written_time - m_available_time;
+        size_t held = static_cast<size_t>(std::min<std::uint64_t>(m_history_retention, read_abs));
+        free_time -= std::min(free_time, held);
+    }
+    if (m_pins.empty()) return free_time;
+
+    // The write head may not lap the oldest pinned read position.
+    std::uint64_t limit = m_pins.oldest() + m_capacity_time;
+    return std::min(free_time, static_cast<size_t>(limit - m_total_written_time));
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getCapacity() const { return m_capacity_time; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getAvailableWrite() const { return m_capacity_time - m_available_time; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getNumChannels() const { return m_num_channels; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getCapacity() const { return m_capacity_time; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getFeatureDim() const { return m_feature_dim; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getNumChannels() const { return m_num_channels; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getFrameSizeTime() const { return m_frame_size_time; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getFeatureDim() const { return m_feature_dim; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getHopSizeTime() const { return m_hop_size_time; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getFrameSizeTime() const { return m_frame_size_time; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getMinFrames() const { return m_min_frames; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getHopSizeTime() const { return m_hop_size_time; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getKeepFrames() const { return m_keep_frames; }
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::setHistoryRetention(size_t history_steps) {
+    if (history_steps + m_frame_size_time > m_capacity_time) {
+        throw std::invalid_argument("History retention (" + std::to_string(history_steps) + ") plus frame size exceeds capacity (" +
+                                    std::to_string(m_capacity_time) + ").");
+    }
+    m_history_retention = history_steps;
+}
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getMinFrames() const { return m_min_frames; }
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getHistoryRetention() const { return m_history_retention; }
 
-template <typename T>
-size_t FramingRingBuffer3D<T>::getKeepFrames() const { return m_keep_frames; }
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::isFull() const { return getAvailableWrite() == 0; }
 
-template <typename T>
-bool FramingRingBuffer3D<T>::isFull() const { return getAvailableWrite() == 0; }
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::isEmpty() const { return getAvailableTimeRead() == 0; }
 
-template <typename T>
-bool FramingRingBuffer3D<T>::isEmpty() const { return getAvailableTimeRead() == 0; }
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::clear() {
+    if (!m_pins.empty()) {
+        throw std::logic_error("Cannot clear while exported tensors pin the buffer.");
+    }
 
-template <typename T>
-void FramingRingBuffer3D<T>::clear() {
     m_write_index_time = 0;
     m_read_index_time = 0;
     m_available_time = 0;
+    m_total_written_time = 0;
+
+    if (m_cmvn_enabled) {
+        rebuildCMVN();
+    }
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::getStorageBytes() const {
+    size_t bytes = m_num_channels * m_capacity_time * m_feature_dim * sizeof(StorageT);
+    if (Codec::kHasParams) {
+        bytes += m_num_channels * m_capacity_time * sizeof(StepParams);
+    }
+    return bytes;
+}
+
+template <typename T, typename StorageT>
+const T* FramingRingBuffer3D<T, StorageT>::decodedStep(size_t channel, size_t time_pos, T* scratch) const {
+    if constexpr (std::is_same<T, StorageT>::value) {
+        (void)scratch;
+        return stepPtr(channel, time_pos);
+    } else {
+        decodeStep(channel, time_pos, scratch);
+        return scratch;
+    }
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::enableCMVN(size_t window_time, T epsilon) {
+    if (window_time == 0 || window_time > m_capacity_time) {
+        throw std::invalid_argument("CMVN window (" + std::to_string(window_time) + ") must be in [1, capacity].");
+    }
+    m_cmvn_window = window_time;
+    m_cmvn_epsilon = epsilon;
+    m_cmvn_shift.assign(m_num_channels, std::vector<double>(m_feature_dim, 0.0));
+    m_cmvn_sum.assign(m_num_channels, std::vector<double>(m_feature_dim, 0.0));
+    m_cmvn_sum_sq.assign(m_num_channels, std::vector<double>(m_feature_dim, 0.0));
+    m_cmvn_scratch.resize(m_feature_dim);
+    m_cmvn_mean.resize(m_feature_dim);
+    m_cmvn_inv_std.resize(m_feature_dim);
+    m_cmvn_enabled = true;
+    rebuildCMVN();
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::disableCMVN() {
+    m_cmvn_enabled = false;
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::isCMVNEnabled() const { return m_cmvn_enabled; }
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::cmvnRemoveLeaving(size_t channel, std::uint64_t new_step_abs) {
+    // Called before the new step overwrites its slot (which may hold the leaving step).
+    if (new_step_abs < m_cmvn_first_abs + m_cmvn_window) return;
+
+    std::uint64_t leaving_abs = new_step_abs - m_cmvn_window;
+    const T* x = decodedStep(channel, static_cast<size_t>(leaving_abs % m_capacity_time), m_cmvn_scratch.data());
+    const double* shift = m_cmvn_shift[channel].data();
+    double* sum = m_cmvn_sum[channel].data();
+    double* sum_sq = m_cmvn_sum_sq[channel].data();
+    for (size_t f = 0; f < m_feature_dim; ++f) {
+        double v = static_cast<double>(x[f]) - shift[f];
+        sum[f] -= v;
+        sum_sq[f] -= v * v;
+    }
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::cmvnAddStep(size_t channel, std::uint64_t step_abs) {
+    // Add the value as stored, so lossy storage adds and removes the same amount.
+    const T* x = decodedStep(channel, static_cast<size_t>(step_abs % m_capacity_time), m_cmvn_scratch.data());
+    double* shift = m_cmvn_shift[channel].data();
+    double* sum = m_cmvn_sum[channel].data();
+    double* sum_sq = m_cmvn_sum_sq[channel].data();
+    if (step_abs == m_cmvn_first_abs) {
+        // First step since the last rebuild: accumulate around it, so the sums stay near
+        // the spread of the data rather than its magnitude and the variance does not cancel.
+        for (size_t f = 0; f < m_feature_dim; ++f) shift[f] = static_cast<double>(x[f]);
+    }
+    for (size_t f = 0; f < m_feature_dim; ++f) {
+        double v = static_cast<double>(x[f]) - shift[f];
+        sum[f] += v;
+        sum_sq[f] += v * v;
+    }
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::rebuildCMVN() {
+    // Recompute from the (at most window) most recent steps still in the ring.
+    std::uint64_t held = std::min<std::uint64_t>(m_total_written_time, m_capacity_time);
+    std::uint64_t count = std::min<std::uint64_t>(held, m_cmvn_window);
+    m_cmvn_first_abs = m_total_written_time - count;
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        std::fill(m_cmvn_sum[c].begin(), m_cmvn_sum[c].end(), 0.0);
+        std::fill(m_cmvn_sum_sq[c].begin(), m_cmvn_sum_sq[c].end(), 0.0);
+        for (std::uint64_t a = m_cmvn_first_abs; a < m_total_written_time; ++a) {
+            cmvnAddStep(c, a);
+        }
+    }
+    m_cmvn_since_rebuild = 0;
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::getCMVNStats(size_t channel, std::vector<T>& mean_out, std::vector<T>& std_out) const {
+    if (!m_cmvn_enabled) {
+        throw std::logic_error("CMVN is not enabled.");
+    }
+    if (channel >= m_num_channels) {
+        throw std::out_of_range("Channel " + std::to_string(channel) + " out of range.");
+    }
+
+    std::uint64_t count = std::min<std::uint64_t>(m_total_written_time - m_cmvn_first_abs, m_cmvn_window);
+    double n = count > 0 ? static_cast<double>(count) : 1.0;
+
+    mean_out.resize(m_feature_dim);
+    std_out.resize(m_feature_dim);
+    for (size_t f = 0; f < m_feature_dim; ++f) {
+        // Shifted sums: d = x - shift, mean = shift + sum(d) / n, var = (sum(d^2) - sum(d)^2 / n) / n.
+        double sum = m_cmvn_sum[channel][f];
+        double mean = m_cmvn_shift[channel][f] + sum / n;
+        double variance = count > 1 ? (m_cmvn_sum_sq[channel][f] - sum * sum / n) / n : 0.0;
+        if (variance < 0.0) variance = 0.0;
+        mean_out[f] = static_cast<T>(mean);
+        std_out[f] = static_cast<T>(std::sqrt(variance));
+    }
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::readNormalized(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames, bool normalize_variance) {
+    if (!m_cmvn_enabled) {
+        throw std::logic_error("CMVN is not enabled.");
+    }
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total_time_steps = (count_to_read - 1) * m_hop_size_time + m_frame_size_time;
+
+    buffer_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        // O(F) per channel: derive mean and 1/std once, then normalise while copying.
+        getCMVNStats(c, m_cmvn_mean, m_cmvn_inv_std);
+        for (size_t f = 0; f < m_feature_dim; ++f) {
+            T sd = m_cmvn_inv_std[f];
+            m_cmvn_inv_std[f] = normalize_variance ? static_cast<T>(1) / std::sqrt(sd * sd + m_cmvn_epsilon) : static_cast<T>(1);
+        }
+
+        const T* mean = m_cmvn_mean.data();
+        const T* inv_std = m_cmvn_inv_std.data();
+
+        buffer_out[c].resize(total_time_steps);
+        for (size_t t = 0; t < total_time_steps; ++t) {
+            std::vector<T>& row = buffer_out[c][t];
+            row.resize(m_feature_dim);
+            decodeStep(c, (m_read_index_time + t) % m_capacity_time, row.data());
+            T* x = row.data();
+            for (size_t f = 0; f < m_feature_dim; ++f) {
+                x[f] = (x[f] - mean[f]) * inv_std[f];
+            }
+        }
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::heldBehindRead() const {
+    // Consumed steps stay in the free region until the write head reaches them.
+    std::uint64_t consumed = m_total_written_time - m_available_time;
+    return static_cast<size_t>(std::min<std::uint64_t>(consumed, m_capacity_time - m_available_time));
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::contextBehindRead() const {
+    // Only retained steps: what else survives depends on how far the writer is ahead.
+    // (Retention enabled late cannot bring back steps the write head already reused.)
+    std::uint64_t consumed = m_total_written_time - m_available_time;
+    size_t retained = static_cast<size_t>(std::min<std::uint64_t>(consumed, m_history_retention));
+    return std::min(retained, heldBehindRead());
+}
+
+template <typename T, typename StorageT>
+size_t FramingRingBuffer3D<T, StorageT>::contextPos(std::ptrdiff_t rel, std::ptrdiff_t lo, std::ptrdiff_t hi) const {
+    // rel is relative to the read head; clamp to the context range [lo, hi).
+    if (rel < lo) rel = lo;
+    if (rel >= hi) rel = hi - 1;
+    std::ptrdiff_t cap = static_cast<std::ptrdiff_t>(m_capacity_time);
+    return static_cast<size_t>((static_cast<std::ptrdiff_t>(m_read_index_time) + rel + cap) % cap);
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::readSpliced(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t left_context, size_t right_context, size_t num_frames) {
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total_time_steps = (count_to_read - 1) * m_hop_size_time + m_frame_size_time;
+    size_t row_size = (left_context + 1 + right_context) * m_feature_dim;
+
+    const std::ptrdiff_t lo = -static_cast<std::ptrdiff_t>(contextBehindRead());
+    const std::ptrdiff_t hi = static_cast<std::ptrdiff_t>(total_time_steps);
+    const std::ptrdiff_t left = static_cast<std::ptrdiff_t>(left_context);
+
+    buffer_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        buffer_out[c].resize(total_time_steps);
+        for (size_t t = 0; t < total_time_steps; ++t) {
+            std::vector<T>& row = buffer_out[c][t];
+            row.resize(row_size);
+            T* dst = row.data();
+            std::ptrdiff_t first = static_cast<std::ptrdiff_t>(t) - left;
+            for (size_t j = 0; j <= left_context + right_context; ++j) {
+                decodeStep(c, contextPos(first + static_cast<std::ptrdiff_t>(j), lo, hi), dst + j * m_feature_dim);
+            }
+        }
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::readWithDeltas(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t order, size_t delta_window, size_t num_frames) {
+    if (order < 1 || order > 2) {
+        throw std::invalid_argument("Delta order (" + std::to_string(order) + ") must be 1 or 2.");
+    }
+    if (delta_window == 0) {
+        throw std::invalid_argument("Delta window must be non-zero.");
+    }
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total_time_steps = (count_to_read - 1) * m_hop_size_time + m_frame_size_time;
+    const size_t F = m_feature_dim;
+    const std::ptrdiff_t N = static_cast<std::ptrdiff_t>(delta_window);
+
+    // Rows needed, relative to the read head: retained history on the left, the union on the right.
+    const std::ptrdiff_t reach = static_cast<std::ptrdiff_t>(order) * N;
+    const std::ptrdiff_t lo = std::max(-static_cast<std::ptrdiff_t>(contextBehindRead()), -reach);
+    const std::ptrdiff_t hi = static_cast<std::ptrdiff_t>(total_time_steps);
+    const size_t num_rows = static_cast<size_t>(hi - lo);
+
+    T denom = 0;
+    for (std::ptrdiff_t n = 1; n <= N; ++n) denom += static_cast<T>(n * n);
+    const T scale = static_cast<T>(1) / (static_cast<T>(2) * denom);
+
+    m_context_rows.resize(num_rows * F);
+    if (order == 2) m_delta_rows.resize(num_rows * F);
+
+    // d(rows)[r] over [lo, hi), written to dst; index clamping matches the context range edges.
+    auto regress = [&](const T* rows, T* dst, std::ptrdiff_t r) {
+        std::fill(dst, dst + F, static_cast<T>(0));
+        for (std::ptrdiff_t n = 1; n <= N; ++n) {
+            std::ptrdiff_t ahead = std::min(r + n, hi - 1) - lo;
+            std::ptrdiff_t behind = std::max(r - n, lo) - lo;
+            const T* xa = rows + static_cast<size_t>(ahead) * F;
+            const T* xb = rows + static_cast<size_t>(behind) * F;
+            const T w = static_cast<T>(n) * scale;
+            for (size_t f = 0; f < F; ++f) {
+                dst[f] += w * (xa[f] - xb[f]);
+            }
+        }
+    };
+
+    buffer_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        T* rows = m_context_rows.data();
+        for (size_t r = 0; r < num_rows; ++r) {
+            decodeStep(c, contextPos(lo + static_cast<std::ptrdiff_t>(r), lo, hi), rows + r * F);
+        }
+        if (order == 2) {
+            for (size_t r = 0; r < num_rows; ++r) {
+                regress(rows, m_delta_rows.data() + r * F, lo + static_cast<std::ptrdiff_t>(r));
+            }
+        }
+
+        buffer_out[c].resize(total_time_steps);
+        for (size_t t = 0; t < total_time_steps; ++t) {
+            std::vector<T>& row = buffer_out[c][t];
+            row.resize((order + 1) * F);
+            std::ptrdiff_t r = static_cast<std::ptrdiff_t>(t);
+            std::memcpy(row.data(), rows + static_cast<size_t>(r - lo) * F, F * sizeof(T));
+            if (order == 2) {
+                std::memcpy(row.data() + F, m_delta_rows.data() + static_cast<size_t>(r - lo) * F, F * sizeof(T));
+                regress(m_delta_rows.data(), row.data() + 2 * F, r);
+            } else {
+                regress(rows, row.data() + F, r);
+            }
+        }
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::setWriteProjection(const BandedMatrix<T>& projection) {
+    if (projection.getOutputDim() != m_feature_dim) {
+        throw std::invalid_argument("Write projection output dimension (" + std::to_string(projection.getOutputDim()) +
+                                    ") does not match feature_dim (" + std::to_string(m_feature_dim) + ").");
+    }
+    m_write_projection = projection;
+}
+
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::setReadProjection(const BandedMatrix<T>& projection) {
+    if (projection.getInputDim() != m_feature_dim) {
+        throw std::invalid_argument("Read projection input dimension (" + std::to_string(projection.getInputDim()) +
+                                    ") does not match feature_dim (" + std::to_string(m_feature_dim) + ").");
+    }
+    m_read_projection = projection;
+    m_projection_scratch.resize(m_feature_dim);
 }
 
+template <typename T, typename StorageT>
+void FramingRingBuffer3D<T, StorageT>::clearProjections() {
+    m_write_projection = BandedMatrix<T>();
+    m_read_projection = BandedMatrix<T>();
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::pushProjected(const std::vector<std::vector<T>>& time_step_data) {
+    if (m_write_projection.empty()) {
+        throw std::logic_error("No write projection is set.");
+    }
+    if (time_step_data.size() != m_num_channels) {
+        throw std::invalid_argument("Input data channel count (" + std::to_string(time_step_data.size()) +
+                                    ") does not match buffer channels (" + std::to_string(m_num_channels) + ").");
+    }
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        if (time_step_data[c].size() != m_write_projection.getInputDim()) {
+            throw std::invalid_argument("Input feature size (" + std::to_string(time_step_data[c].size()) +
+                                        ") does not match projection input dimension (" +
+                                        std::to_string(m_write_projection.getInputDim()) + ").");
+        }
+    }
+
+    return pushInPlace([this, &time_step_data](size_t c, T* features) {
+        m_write_projection.apply(time_step_data[c].data(), features);
+    });
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::readProjected(std::vector<std::vector<std::vector<T>>>& buffer_out, size_t num_frames) {
+    if (m_read_projection.empty()) {
+        throw std::logic_error("No read projection is set.");
+    }
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total_time_steps = (count_to_read - 1) * m_hop_size_time + m_frame_size_time;
+    size_t output_dim = m_read_projection.getOutputDim();
+
+    buffer_out.resize(m_num_channels);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        buffer_out[c].resize(total_time_steps);
+        for (size_t t = 0; t < total_time_steps; ++t) {
+            buffer_out[c][t].resize(output_dim);
+            const T* x = decodedStep(c, (m_read_index_time + t) % m_capacity_time, m_projection_scratch.data());
+            m_read_projection.apply(x, buffer_out[c][t].data());
+        }
+    }
+
+    consumeFrames(count_to_read);
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::exportFrames(ExportedTensor<StorageT>& out, size_t num_frames) {
+    static_assert(!Codec::kHasParams, "exportFrames() needs storage without per-step parameters; use readQuantized().");
+    out.release();
+
+    size_t count_to_read = 0;
+    if (!resolveReadCount(num_frames, count_to_read) || count_to_read == 0) {
+        return false;
+    }
+
+    size_t total_time_steps = (count_to_read - 1) * m_hop_size_time + m_frame_size_time;
+    std::int64_t shape[3] = {static_cast<std::int64_t>(m_num_channels), static_cast<std::int64_t>(total_time_steps),
+                             static_cast<std::int64_t>(m_feature_dim)};
+
+    if (m_read_index_time + total_time_steps <= m_capacity_time) {
+        std::int64_t strides[3] = {static_cast<std::int64_t>(m_capacity_time * m_feature_dim), static_cast<std::int64_t>(m_feature_dim), 1};
+        std::uint64_t read_abs = m_total_written_time - m_available_time;
+        out.set(stepPtr(0, m_read_index_time), 3, shape, strides, count_to_read, &m_pins, read_abs);
+    } else {
+        // Wrapped: gather into the tensor's own storage.
+        size_t block = total_time_steps * m_feature_dim;
+        StorageT* dst = out.staging(m_num_channels * block);
+        size_t first = m_capacity_time - m_read_index_time;
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            std::memcpy(dst + c * block, stepPtr(c, m_read_index_time), first * m_feature_dim * sizeof(StorageT));
+            std::memcpy(dst + c * block + first * m_feature_dim, stepPtr(c, 0), (total_time_steps - first) * m_feature_dim * sizeof(StorageT));
+        }
+        std::int64_t strides[3] = {static_cast<std::int64_t>(block), static_cast<std::int64_t>(m_feature_dim), 1};
+        out.set(dst, 3, shape, strides, count_to_read, nullptr, 0);
+    }
+
+    return true;
+}
+
+template <typename T, typename StorageT>
+bool FramingRingBuffer3D<T, StorageT>::isPinned() const { return !m_pins.empty(); }
+
 } // namespace JABuff
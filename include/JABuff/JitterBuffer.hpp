@@ -0,0 +1,376 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <map>          // For std::map
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint64_t
+#include <cstring>      // For std::memmove
+#include <string>       // For std::to_string
+#include <algorithm>    // For std::min, std::max, std::fill
+#include <iterator>     // For std::prev
+
+#include "FramingRingBuffer2D.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief How JitterBuffer fills samples that never arrived before their deadline.
+ */
+enum class ConcealMode {
+    Silence,    // Zeros
+    RepeatFade  // Repeat the last fade_length samples, fading linearly to silence
+};
+
+/**
+ * @brief Reorders timestamped packets straight into a FramingRingBuffer2D.
+ *
+ * Packets carry an absolute sample timestamp (e.g. an RTP timestamp). insert()
+ * writes each packet at its place in the ring's uncommitted space past the write
+ * head (reserve()), whatever order it arrives in, and records which ranges have
+ * been received. The run of received samples starting at the write head is
+ * committed as soon as it is complete, so frames only become readable once every
+ * sample in them is there. No separate reorder queue, no second copy.
+ *
+ * Holes are released by a deadline: flush(until) conceals every missing sample
+ * before until (ConcealMode) and commits through it. With setPlayoutDelay(d),
+ * each insert() also flushes up to newest_timestamp - d, so a lost packet stalls
+ * the stream for at most d samples of later arrivals. Changing d at run time is
+ * how adaptive playout delay is applied.
+ *
+ * Packets (or parts of packets) before the write head are too late and dropped.
+ * Packets ending beyond the ring's free space are refused. Re-inserting an
+ * already received range simply overwrites it.
+ *
+ * The JitterBuffer must be the only writer of its target.
+ *
+ * @tparam T The sample type.
+ */
+template <typename T>
+class JitterBuffer {
+public:
+    /**
+     * @brief Construct a jitter buffer feeding a ring.
+     *
+     * @param target The buffer to write to. Must outlive this object.
+     * @param start_timestamp The timestamp of the first sample to be played.
+     * @param mode How missing samples are concealed.
+     * @param fade_length Samples repeated and faded by ConcealMode::RepeatFade.
+     * @throws std::invalid_argument if RepeatFade is used with fade_length 0 or > capacity.
+     */
+    JitterBuffer(FramingRingBuffer2D<T>& target, std::uint64_t start_timestamp = 0,
+                 ConcealMode mode = ConcealMode::Silence, size_t fade_length = 0);
+
+    /**
+     * @brief Places a packet at its timestamp and commits any run it completes.
+     *
+     * @param timestamp The absolute timestamp of the packet's first sample.
+     * @param packet Packet data [channel][sample].
+     * @return true if (part of) the packet was placed, false if it was entirely
+     * late or does not fit in the ring's free space.
+     * @throws std::invalid_argument if the channel count mismatches or channels have inconsistent sizes.
+     */
+    bool insert(std::uint64_t timestamp, const std::vector<std::vector<T>>& packet);
+
+    /**
+     * @brief Conceals every missing sample before until and commits through it.
+     *
+     * A received run that straddles until is committed whole.
+     *
+     * @param until The timestamp to release up to (exclusive).
+     * @return The number of samples committed (0 if until is not past the head).
+     * @throws std::out_of_range if until lies beyond the ring's free space.
+     */
+    size_t flush(std::uint64_t until);
+
+    /**
+     * @brief Sets the automatic deadline: insert() flushes up to newest - delay.
+     * @param delay_samples The playout delay in samples (0 disables automatic flushing).
+     */
+    void setPlayoutDelay(size_t delay_samples);
+    size_t getPlayoutDelay() const;
+
+    /**
+     * @brief Drops all pending packets and restarts at a new timestamp. The ring is not touched.
+     */
+    void reset(std::uint64_t start_timestamp);
+
+    /**
+     * @brief Returns the timestamp of the next sample to be committed (the ring's write head).
+     */
+    std::uint64_t getHeadTimestamp() const;
+
+    /**
+     * @brief Returns the end timestamp (exclusive) of the newest sample received.
+     */
+    std::uint64_t getNewestTimestamp() const;
+
+    /**
+     * @brief Returns the number of received samples waiting behind a hole.
+     */
+    size_t getPendingSamples() const;
+
+    /**
+     * @brief Returns the number of holes between the head and the newest sample.
+     */
+    size_t getHoleCount() const;
+
+    size_t getLatePackets() const;
+    size_t getConcealedSamples() const;
+
+private:
+    void validatePacket(const std::vector<std::vector<T>>& packet) const;
+    void addReceived(std::uint64_t start, std::uint64_t end);
+    void commitReceivedPrefix();
+    void commitRun(size_t count);
+    void conceal(size_t count);
+
+    FramingRingBuffer2D<T>& m_target;
+    size_t m_num_channels;
+    ConcealMode m_mode;
+    size_t m_fade_length;
+    size_t m_playout_delay;
+
+    std::uint64_t m_head;      // Timestamp of the ring's write head
+    std::uint64_t m_newest;    // End of the newest received sample
+    std::map<std::uint64_t, std::uint64_t> m_received; // Received ranges past the head, start -> end, disjoint
+
+    size_t m_late_packets;
+    size_t m_concealed_samples;
+
+    std::vector<std::vector<T>> m_history; // [channel][fade_length] last committed samples (RepeatFade)
+    size_t m_history_fill;
+    std::vector<RingSpan<T>> m_spans;
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+JitterBuffer<T>::JitterBuffer(FramingRingBuffer2D<T>& target, std::uint64_t start_timestamp, ConcealMode mode, size_t fade_length)
+    : m_target(target),
+      m_num_channels(target.getNumChannels()),
+      m_mode(mode),
+      m_fade_length(fade_length),
+      m_playout_delay(0),
+      m_head(start_timestamp),
+      m_newest(start_timestamp),
+      m_late_packets(0),
+      m_concealed_samples(0),
+      m_history_fill(0) {
+
+    if (mode == ConcealMode::RepeatFade && (fade_length == 0 || fade_length > target.getCapacity())) {
+        throw std::invalid_argument("RepeatFade needs a fade_length in [1, capacity].");
+    }
+
+    if (mode == ConcealMode::RepeatFade) {
+        m_history.assign(m_num_channels, std::vector<T>(m_fade_length, static_cast<T>(0)));
+    }
+    m_spans.reserve(m_num_channels);
+}
+
+template <typename T>
+void JitterBuffer<T>::validatePacket(const std::vector<std::vector<T>>& packet) const {
+    if (packet.size() != m_num_channels) {
+        throw std::invalid_argument("Packet channel count (" + std::to_string(packet.size()) +
+                                    ") does not match buffer channels (" + std::to_string(m_num_channels) + ").");
+    }
+    for (size_t c = 1; c < m_num_channels; ++c) {
+        if (packet[c].size() != packet[0].size()) {
+            throw std::invalid_argument("Packet channels have inconsistent sizes.");
+        }
+    }
+}
+
+template <typename T>
+bool JitterBuffer<T>::insert(std::uint64_t timestamp, const std::vector<std::vector<T>>& packet) {
+    validatePacket(packet);
+
+    const size_t len = packet[0].size();
+    if (len == 0) return true;
+
+    const std::uint64_t end = timestamp + len;
+    if (end <= m_head) {
+        ++m_late_packets;
+        return false;
+    }
+
+    // Drop the part that is already past the head.
+    const size_t skip = (timestamp < m_head) ? static_cast<size_t>(m_head - timestamp) : 0;
+    const std::uint64_t start = timestamp + skip;
+    const size_t offset = static_cast<size_t>(start - m_head);
+    const size_t count = len - skip;
+
+    if (offset + count > m_target.getAvailableWrite()) {
+        return false;
+    }
+
+    m_target.reserve(offset + count, m_spans);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        RingSpan<T> dest = m_spans[c].subspan(offset, count);
+        const T* src = packet[c].data() + skip;
+        std::memcpy(dest.first, src, dest.first_size * sizeof(T));
+        if (dest.second_size > 0) {
+            std::memcpy(dest.second, src + dest.first_size, dest.second_size * sizeof(T));
+        }
+    }
+
+    addReceived(start, end);
+    m_newest = std::max(m_newest, end);
+    commitReceivedPrefix();
+
+    if (m_playout_delay > 0 && m_newest > m_head + m_playout_delay) {
+        flush(m_newest - m_playout_delay);
+    }
+
+    return true;
+}
+
+template <typename T>
+void JitterBuffer<T>::addReceived(std::uint64_t start, std::uint64_t end) {
+    // Merge with any range that overlaps or touches [start, end).
+    auto it = m_received.upper_bound(start);
+    if (it != m_received.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second >= start) {
+            start = prev->first;
+            end = std::max(end, prev->second);
+            it = m_received.erase(prev);
+        }
+    }
+    while (it != m_received.end() && it->first <= end) {
+        end = std::max(end, it->second);
+        it = m_received.erase(it);
+    }
+    m_received.emplace(start, end);
+}
+
+template <typename T>
+void JitterBuffer<T>::commitReceivedPrefix() {
+    auto it = m_received.begin();
+    if (it != m_received.end() && it->first == m_head) {
+        commitRun(static_cast<size_t>(it->second - m_head));
+        m_received.erase(it);
+    }
+}
+
+template <typename T>
+size_t JitterBuffer<T>::flush(std::uint64_t until) {
+    if (until <= m_head) return 0;
+
+    if (until - m_head > m_target.getAvailableWrite()) {
+        throw std::out_of_range("Flush to " + std::to_string(until) + " exceeds the ring's free space (" +
+                                std::to_string(m_target.getAvailableWrite()) + " samples past the head).");
+    }
+
+    const std::uint64_t start = m_head;
+    while (m_head < until) {
+        auto it = m_received.begin();
+        if (it != m_received.end() && it->first == m_head) {
+            commitRun(static_cast<size_t>(it->second - m_head));
+            m_received.erase(it);
+            continue;
+        }
+        std::uint64_t gap_end = (it != m_received.end()) ? std::min(until, it->first) : until;
+        size_t gap = static_cast<size_t>(gap_end - m_head);
+        conceal(gap);
+        commitRun(gap);
+    }
+    commitReceivedPrefix();
+
+    m_newest = std::max(m_newest, m_head);
+    return static_cast<size_t>(m_head - start);
+}
+
+template <typename T>
+void JitterBuffer<T>::conceal(size_t count) {
+    m_target.reserve(count, m_spans);
+    m_concealed_samples += count;
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        const RingSpan<T>& dest = m_spans[c];
+        size_t n = 0;
+        if (m_mode == ConcealMode::RepeatFade && m_history_fill > 0) {
+            // The newest m_history_fill samples sit at the end of the history; repeat them with a linear fade.
+            const T* hist = m_history[c].data() + (m_fade_length - m_history_fill);
+            const size_t faded = std::min(count, m_fade_length);
+            for (; n < faded; ++n) {
+                T gain = static_cast<T>(1.0 - static_cast<double>(n + 1) / static_cast<double>(m_fade_length + 1));
+                dest[n] = hist[n % m_history_fill] * gain;
+            }
+        }
+        for (; n < count; ++n) {
+            dest[n] = static_cast<T>(0);
+        }
+    }
+}
+
+template <typename T>
+void JitterBuffer<T>::commitRun(size_t count) {
+    if (count == 0) return;
+
+    // The run may span several packets placed by earlier reservations: reserve it as a whole to commit it.
+    m_target.reserve(count, m_spans);
+
+    if (m_mode == ConcealMode::RepeatFade) {
+        // Keep the last fade_length committed samples for concealment.
+        const size_t take = std::min(count, m_fade_length);
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            T* hist = m_history[c].data();
+            std::memmove(hist, hist + take, (m_fade_length - take) * sizeof(T));
+            for (size_t i = 0; i < take; ++i) {
+                hist[m_fade_length - take + i] = m_spans[c][count - take + i];
+            }
+        }
+        m_history_fill = std::min(m_fade_length, m_history_fill + count);
+    }
+
+    m_target.commit(count);
+    m_head += count;
+}
+
+template <typename T>
+void JitterBuffer<T>::setPlayoutDelay(size_t delay_samples) { m_playout_delay = delay_samples; }
+
+template <typename T>
+size_t JitterBuffer<T>::getPlayoutDelay() const { return m_playout_delay; }
+
+template <typename T>
+void JitterBuffer<T>::reset(std::uint64_t start_timestamp) {
+    m_head = start_timestamp;
+    m_newest = start_timestamp;
+    m_received.clear();
+    m_late_packets = 0;
+    m_concealed_samples = 0;
+    m_history_fill = 0;
+    for (auto& hist : m_history) {
+        std::fill(hist.begin(), hist.end(), static_cast<T>(0));
+    }
+}
+
+template <typename T>
+std::uint64_t JitterBuffer<T>::getHeadTimestamp() const { return m_head; }
+
+template <typename T>
+std::uint64_t JitterBuffer<T>::getNewestTimestamp() const { return m_newest; }
+
+template <typename T>
+size_t JitterBuffer<T>::getPendingSamples() const {
+    size_t total = 0;
+    for (const auto& range : m_received) {
+        total += static_cast<size_t>(range.second - range.first);
+    }
+    return total;
+}
+
+template <typename T>
+size_t JitterBuffer<T>::getHoleCount() const { return m_received.size(); }
+
+template <typename T>
+size_t JitterBuffer<T>::getLatePackets() const { return m_late_packets; }
+
+template <typename T>
+size_t JitterBuffer<T>::getConcealedSamples() const { return m_concealed_samples; }
+
+} // namespace JABuff
@@ -0,0 +1,477 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument, std::runtime_error, std::out_of_range
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint8_t, std::uint16_t, std::uint32_t, std::int32_t
+#include <cstring>      // For std::memcpy, std::memcmp
+#include <string>       // For std::string, std::to_string
+#include <algorithm>    // For std::min
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>      // For open
+#include <unistd.h>     // For close, sysconf
+#include <sys/mman.h>   // For mmap, munmap, madvise
+#include <sys/stat.h>   // For fstat
+#define JABUFF_HAS_MMAP 1
+#else
+#include <fstream>      // For std::ifstream (fallback: whole file in memory)
+#endif
+
+#include "FramingRingBuffer2D.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief On-disk sample encodings understood by MappedFileSource (little-endian, interleaved).
+ */
+enum class SampleFormat {
+    PCM16,
+    PCM24,
+    PCM32,
+    Float32,
+    Float64
+};
+
+namespace detail {
+
+// Where the samples of a WAV file are and how they are encoded.
+struct WavLayout {
+    SampleFormat format = SampleFormat::PCM16;
+    size_t num_channels = 0;
+    size_t sample_rate = 0;
+    size_t data_offset = 0;
+    size_t data_bytes = 0;
+};
+
+inline size_t bytesPerSample(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::PCM16:   return 2;
+        case SampleFormat::PCM24:   return 3;
+        case SampleFormat::PCM32:   return 4;
+        case SampleFormat::Float32: return 4;
+        case SampleFormat::Float64: return 8;
+    }
+    return 0;
+}
+
+// Parses a WAV header from the first 'size' bytes of a file of file_size bytes.
+inline WavLayout parseWavHeader(const std::uint8_t* data, size_t size, size_t file_size, const std::string& path) {
+    auto u16 = [data](size_t at) { return static_cast<std::uint16_t>(data[at] | (data[at + 1] << 8)); };
+    auto u32 = [data](size_t at) {
+        return static_cast<std::uint32_t>(data[at]) | (static_cast<std::uint32_t>(data[at + 1]) << 8) |
+               (static_cast<std::uint32_t>(data[at + 2]) << 16) | (static_cast<std::uint32_t>(data[at + 3]) << 24);
+    };
+
+    WavLayout layout;
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        throw std::runtime_error("'" + path + "' is not a RIFF/WAVE file.");
+    }
+
+    bool have_fmt = false;
+    size_t pos = 12;
+    while (pos + 8 <= size) {
+        size_t chunk_size = u32(pos + 4);
+        size_t body = pos + 8;
+
+        if (std::memcmp(data + pos, "fmt ", 4) == 0) {
+            if (chunk_size < 16 || body + chunk_size > size) break;
+            std::uint16_t tag = u16(body);
+            layout.num_channels = u16(body + 2);
+            layout.sample_rate = u32(body + 4);
+            std::uint16_t bits = u16(body + 14);
+            if (tag == 0xFFFE && chunk_size >= 26) {
+                tag = u16(body + 24); // First two bytes of the sub-format GUID
+            }
+
+            if (tag == 1 && bits == 16) layout.format = SampleFormat::PCM16;
+            else if (tag == 1 && bits == 24) layout.format = SampleFormat::PCM24;
+            else if (tag == 1 && bits == 32) layout.format = SampleFormat::PCM32;
+            else if (tag == 3 && bits == 32) layout.format = SampleFormat::Float32;
+            else if (tag == 3 && bits == 64) layout.format = SampleFormat::Float64;
+            else {
+                throw std::runtime_error("'" + path + "' has an unsupported WAV format (tag " + std::to_string(tag) +
+                                         ", " + std::to_string(bits) + " bits).");
+            }
+            if (layout.num_channels == 0) {
+                throw std::runtime_error("'" + path + "' declares zero channels.");
+            }
+            have_fmt = true;
+        } else if (std::memcmp(data + pos, "data", 4) == 0) {
+            if (!have_fmt) break;
+            // Streams written on the fly may leave the size at 0 or 0xFFFFFFFF: take the rest of the file.
+            size_t available = file_size - body;
+            layout.data_offset = body;
+            layout.data_bytes = (chunk_size == 0 || chunk_size > available) ? available : chunk_size;
+            return layout;
+        }
+
+        pos = body + chunk_size + (chunk_size & 1); // Chunks are word-aligned
+    }
+
+    throw std::runtime_error("'" + path + "' has no usable fmt / data chunks.");
+}
+
+// Converts frames of interleaved little-endian samples into one run per channel.
+template <typename T>
+void convertInterleaved(SampleFormat format, size_t channels, T* const* dst, const std::uint8_t* src, size_t frames) {
+    // Frame-major walk over the source (sequential reads), deinterleaving into one run per channel.
+    switch (format) {
+        case SampleFormat::PCM16: {
+            const T scale = static_cast<T>(1.0 / 32768.0);
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t c = 0; c < channels; ++c, src += 2) {
+                    std::int16_t v = static_cast<std::int16_t>(src[0] | (src[1] << 8));
+                    dst[c][i] = static_cast<T>(v) * scale;
+                }
+            }
+            break;
+        }
+        case SampleFormat::PCM24: {
+            const T scale = static_cast<T>(1.0 / 8388608.0);
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t c = 0; c < channels; ++c, src += 3) {
+                    // Assemble in the top 24 bits, then shift back down to sign-extend.
+                    std::int32_t v = static_cast<std::int32_t>((static_cast<std::uint32_t>(src[0]) << 8) |
+                                                               (static_cast<std::uint32_t>(src[1]) << 16) |
+                                                               (static_cast<std::uint32_t>(src[2]) << 24)) >> 8;
+                    dst[c][i] = static_cast<T>(v) * scale;
+                }
+            }
+            break;
+        }
+        case SampleFormat::PCM32: {
+            const double scale = 1.0 / 2147483648.0;
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t c = 0; c < channels; ++c, src += 4) {
+                    std::int32_t v = static_cast<std::int32_t>(static_cast<std::uint32_t>(src[0]) | (static_cast<std::uint32_t>(src[1]) << 8) |
+                                                               (static_cast<std::uint32_t>(src[2]) << 16) | (static_cast<std::uint32_t>(src[3]) << 24));
+                    dst[c][i] = static_cast<T>(static_cast<double>(v) * scale);
+                }
+            }
+            break;
+        }
+        case SampleFormat::Float32: {
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t c = 0; c < channels; ++c, src += 4) {
+                    float v;
+                    std::memcpy(&v, src, 4);
+                    dst[c][i] = static_cast<T>(v);
+                }
+            }
+            break;
+        }
+        case SampleFormat::Float64: {
+            for (size_t i = 0; i < frames; ++i) {
+                for (size_t c = 0; c < channels; ++c, src += 8) {
+                    double v;
+                    std::memcpy(&v, src, 8);
+                    dst[c][i] = static_cast<T>(v);
+                }
+            }
+            break;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Streams a WAV or raw PCM file into a FramingRingBuffer2D straight from a memory map.
+ *
+ * The file is mmap'd read-only with MADV_SEQUENTIAL read-ahead. pump() reserves
+ * space in the ring and converts / deinterleaves the next frames from the mapping
+ * directly into it (reserve() / commit()), so there is no intermediate
+ * vector<vector<float>> and no whole-file load. Pages already consumed are released
+ * with MADV_DONTNEED as the stream advances, so resident memory stays around the
+ * ring size plus the read-ahead window, however long the file is.
+ *
+ * Integer PCM is scaled to [-1, 1). Multi-byte values are read as little-endian,
+ * as WAV stores them.
+ *
+ * On platforms without mmap the file is read into memory instead (same API, no RSS bound).
+ *
+ * @tparam T The sample type of the ring (float or double).
+ */
+template <typename T>
+class MappedFileSource {
+public:
+    /**
+     * @brief Opens a WAV file (PCM 16/24/32-bit, IEEE float 32/64-bit, plain or WAVE_FORMAT_EXTENSIBLE).
+     * @param path The file to open.
+     * @throws std::runtime_error if the file cannot be opened, mapped or parsed.
+     */
+    explicit MappedFileSource(const std::string& path);
+
+    /**
+     * @brief Opens a headerless (raw) interleaved file.
+     * @param path The file to open.
+     * @param format The sample encoding.
+     * @param num_channels The number of interleaved channels.
+     * @param sample_rate Informational; returned by getSampleRate().
+     * @param header_bytes Bytes to skip at the start of the file.
+     * @throws std::invalid_argument if num_channels is 0.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    MappedFileSource(const std::string& path, SampleFormat format, size_t num_channels, size_t sample_rate = 0, size_t header_bytes = 0);
+
+    ~MappedFileSource();
+
+    MappedFileSource(const MappedFileSource&) = delete;
+    MappedFileSource& operator=(const MappedFileSource&) = delete;
+
+    /**
+     * @brief Converts the next frames of the file straight into the ring.
+     *
+     * @param target The ring to fill. Must have getNumChannels() channels.
+     * @param max_frames The most frames (samples per channel) to write; 0 = as many as fit.
+     * @return The number of frames written (0 at end of file or if the ring is full).
+     * @throws std::invalid_argument if the ring's channel count does not match the file.
+     */
+    size_t pump(FramingRingBuffer2D<T>& target, size_t max_frames = 0);
+
+    /**
+     * @brief Moves the read position to a frame.
+     * @throws std::out_of_range if frame > getTotalFrames().
+     */
+    void seek(size_t frame);
+
+    bool eof() const;
+    size_t getPosition() const;
+    size_t getTotalFrames() const;
+    size_t getNumChannels() const;
+    size_t getSampleRate() const;
+    SampleFormat getFormat() const;
+
+private:
+    void mapFile(const std::string& path);
+    void unmapFile();
+    void parseWav(const std::string& path);
+    void setLayout(size_t data_offset, size_t data_bytes);
+    void releaseConsumedPages();
+
+    const std::uint8_t* m_data;  // Whole file
+    size_t m_size;
+#if defined(JABUFF_HAS_MMAP)
+    int m_fd;
+    size_t m_released;           // Bytes [0, m_released) already given back with MADV_DONTNEED
+    size_t m_page_size;
+#else
+    std::vector<std::uint8_t> m_storage;
+#endif
+
+    SampleFormat m_format;
+    size_t m_num_channels;
+    size_t m_sample_rate;
+    size_t m_frame_bytes;
+    size_t m_data_offset;
+    size_t m_total_frames;
+    size_t m_position;
+
+    std::vector<RingSpan<T>> m_spans;
+    std::vector<T*> m_dst;
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+MappedFileSource<T>::MappedFileSource(const std::string& path)
+    : m_data(nullptr),
+      m_size(0),
+#if defined(JABUFF_HAS_MMAP)
+      m_fd(-1),
+      m_released(0),
+      m_page_size(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+#endif
+      m_format(SampleFormat::PCM16),
+      m_num_channels(0),
+      m_sample_rate(0),
+      m_frame_bytes(0),
+      m_data_offset(0),
+      m_total_frames(0),
+      m_position(0) {
+
+    mapFile(path);
+    try {
+        parseWav(path);
+    } catch (...) {
+        unmapFile();
+        throw;
+    }
+}
+
+template <typename T>
+MappedFileSource<T>::MappedFileSource(const std::string& path, SampleFormat format, size_t num_channels, size_t sample_rate, size_t header_bytes)
+    : m_data(nullptr),
+      m_size(0),
+#if defined(JABUFF_HAS_MMAP)
+      m_fd(-1),
+      m_released(0),
+      m_page_size(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+#endif
+      m_format(format),
+      m_num_channels(num_channels),
+      m_sample_rate(sample_rate),
+      m_frame_bytes(0),
+      m_data_offset(0),
+      m_total_frames(0),
+      m_position(0) {
+
+    if (num_channels == 0) {
+        throw std::invalid_argument("Raw file source needs at least one channel.");
+    }
+
+    mapFile(path);
+    size_t offset = std::min(header_bytes, m_size);
+    setLayout(offset, m_size - offset);
+}
+
+template <typename T>
+MappedFileSource<T>::~MappedFileSource() {
+    unmapFile();
+}
+
+template <typename T>
+void MappedFileSource<T>::unmapFile() {
+#if defined(JABUFF_HAS_MMAP)
+    if (m_data != nullptr && m_size > 0) {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+    m_data = nullptr;
+    m_fd = -1;
+#endif
+}
+
+template <typename T>
+void MappedFileSource<T>::mapFile(const std::string& path) {
+#if defined(JABUFF_HAS_MMAP)
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw std::runtime_error("Cannot open '" + path + "'.");
+    }
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) {
+        close(m_fd);
+        m_fd = -1;
+        throw std::runtime_error("Cannot stat '" + path + "'.");
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size == 0) return;
+
+    void* map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (map == MAP_FAILED) {
+        close(m_fd);
+        m_fd = -1;
+        throw std::runtime_error("Cannot map '" + path + "'.");
+    }
+    m_data = static_cast<const std::uint8_t*>(map);
+    madvise(map, m_size, MADV_SEQUENTIAL);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Cannot open '" + path + "'.");
+    }
+    m_size = static_cast<size_t>(file.tellg());
+    m_storage.resize(m_size);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(m_storage.data()), static_cast<std::streamsize>(m_size));
+    m_data = m_storage.data();
+#endif
+}
+
+template <typename T>
+void MappedFileSource<T>::setLayout(size_t data_offset, size_t data_bytes) {
+    m_frame_bytes = detail::bytesPerSample(m_format) * m_num_channels;
+    m_data_offset = data_offset;
+    m_total_frames = data_bytes / m_frame_bytes;
+}
+
+template <typename T>
+void MappedFileSource<T>::parseWav(const std::string& path) {
+    detail::WavLayout layout = detail::parseWavHeader(m_data, m_size, m_size, path);
+    m_format = layout.format;
+    m_num_channels = layout.num_channels;
+    m_sample_rate = layout.sample_rate;
+    setLayout(layout.data_offset, layout.data_bytes);
+}
+
+template <typename T>
+size_t MappedFileSource<T>::pump(FramingRingBuffer2D<T>& target, size_t max_frames) {
+    if (target.getNumChannels() != m_num_channels) {
+        throw std::invalid_argument("Ring channel count (" + std::to_string(target.getNumChannels()) +
+                                    ") does not match the file (" + std::to_string(m_num_channels) + ").");
+    }
+
+    size_t count = std::min(m_total_frames - m_position, target.getAvailableWrite());
+    if (max_frames > 0) count = std::min(count, max_frames);
+    if (count == 0) return 0;
+
+    target.reserve(count, m_spans);
+    const std::uint8_t* src = m_data + m_data_offset + m_position * m_frame_bytes;
+
+    // At most two runs (ring wrap).
+    m_dst.resize(m_num_channels);
+    size_t first = m_spans[0].first_size;
+    for (size_t c = 0; c < m_num_channels; ++c) m_dst[c] = m_spans[c].first;
+    detail::convertInterleaved(m_format, m_num_channels, m_dst.data(), src, first);
+    if (first < count) {
+        for (size_t c = 0; c < m_num_channels; ++c) m_dst[c] = m_spans[c].second;
+        detail::convertInterleaved(m_format, m_num_channels, m_dst.data(), src + first * m_frame_bytes, count - first);
+    }
+
+    target.commit(count);
+    m_position += count;
+    releaseConsumedPages();
+    return count;
+}
+
+template <typename T>
+void MappedFileSource<T>::releaseConsumedPages() {
+#if defined(JABUFF_HAS_MMAP)
+    // Give back whole pages behind the read position, in steps of at least 1 MiB.
+    size_t consumed = m_data_offset + m_position * m_frame_bytes;
+    size_t boundary = consumed / m_page_size * m_page_size;
+    if (boundary >= m_released + (size_t(1) << 20)) {
+        madvise(const_cast<std::uint8_t*>(m_data) + m_released, boundary - m_released, MADV_DONTNEED);
+        m_released = boundary;
+    }
+#endif
+}
+
+template <typename T>
+void MappedFileSource<T>::seek(size_t frame) {
+    if (frame > m_total_frames) {
+        throw std::out_of_range("Seek to frame " + std::to_string(frame) + " beyond the end (" + std::to_string(m_total_frames) + ").");
+    }
+    m_position = frame;
+#if defined(JABUFF_HAS_MMAP)
+    // Seeking back re-faults released pages on demand; restart the release window there.
+    size_t consumed = m_data_offset + m_position * m_frame_bytes;
+    m_released = std::min(m_released, consumed / m_page_size * m_page_size);
+#endif
+}
+
+template <typename T>
+bool MappedFileSource<T>::eof() const { return m_position >= m_total_frames; }
+
+template <typename T>
+size_t MappedFileSource<T>::getPosition() const { return m_position; }
+
+template <typename T>
+size_t MappedFileSource<T>::getTotalFrames() const { return m_total_frames; }
+
+template <typename T>
+size_t MappedFileSource<T>::getNumChannels() const { return m_num_channels; }
+
+template <typename T>
+size_t MappedFileSource<T>::getSampleRate() const { return m_sample_rate; }
+
+template <typename T>
+SampleFormat MappedFileSource<T>::getFormat() const { return m_format; }
+
+} // namespace JABuff
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <vector>       // For std::vector
-#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range, std::runtime_error
 #include <cstring>      // For std::memcpy, std::memset
 #include <cstddef>      // For size_t
+#include <cstdint>      // For std::uint8_t, std::uint64_t
 #include <string>       // For std::to_string
-#include <algorithm>    // For std::min
+#include <algorithm>    // For std::min, std::find, std::remove
 #include <cmath>        // For std::sqrt
 
+#include "WriteObserver.hpp"
+#include "BufferState.hpp"
+
 namespace JABuff {
 
 /**
@@ -24,6 +28,10 @@ namespace JABuff {
  * - Only allows reading samples that have been fully resolved (passed the splice point).
  * - "Yet to be overlapped" tail samples are not available for reading.
  *
+ * Observers (see WriteObserver) are notified with the samples each write resolved:
+ * the previous tail, now spliced, followed by the new body, i.e. exactly what
+ * read() will return. The unresolved new tail is reported by the next write.
+ *
  * Reference for crossfade: https://signalsmith-audio.co.uk/writing/2021/cheap-energy-crossfade/
  *
  * @tparam T The data type to be stored (e.g., float, double).
@@ -79,9 +87,51 @@ public:
 
     /**
      * @brief Resets read/write pointers and clears the buffer memory.
+     * Calls onClear() on every attached observer.
      */
     void clear();
 
+    /**
+     * @brief Appends a snapshot of the buffer to out (versioned binary, see BufferState.hpp).
+     *
+     * The snapshot holds the geometry, the read / write cursors, the unread samples, the
+     * pending (yet to be overlapped) tail and the crossfade window, so the next write
+     * after loadState() splices exactly as it would have on the original buffer.
+     */
+    void saveState(std::vector<std::uint8_t>& out) const;
+
+    /**
+     * @brief Appends the same snapshot as gather segments (for writeState() / writev()).
+     *
+     * The segments point into the ring and an internal header, and stay valid until the
+     * buffer is modified or saved again.
+     */
+    void saveState(std::vector<StateSegment>& segments_out) const;
+
+    /**
+     * @brief Restores a snapshot taken by saveState(), replacing the contents and cursors.
+     *
+     * No primeWithSilence() is needed afterwards. Observers get onClear().
+     *
+     * @param data The snapshot; may be followed by further data.
+     * @param size The bytes available at data.
+     * @return The size of the snapshot consumed.
+     * @throws std::runtime_error if the snapshot is malformed, truncated, of another version or sample type.
+     * @throws std::invalid_argument if its channels, capacity, frame or overlap size differ from this buffer's.
+     */
+    size_t loadState(const void* data, size_t size);
+
+    /**
+     * @brief Attaches an observer that is notified of the samples resolved by every accepted write.
+     * The buffer does not take ownership. Attaching the same observer twice has no effect.
+     */
+    void addObserver(WriteObserver<T>* observer);
+
+    /**
+     * @brief Detaches a previously attached observer.
+     */
+    void removeObserver(WriteObserver<T>* observer);
+
     size_t getAvailableFramesRead() const;
     size_t getAvailableSamplesRead() const;
     size_t getAvailableSpaceWrite() const; // In terms of samples
@@ -98,6 +148,9 @@ private:
     // The "Cheap Energy-Preserving" curve function
     T crossfadeCurve(T x) const;
 
+    // Reports count resolved samples starting at ring index start (one call per contiguous run)
+    void notifyObservers(size_t start, size_t count);
+
     // --- Member Variables ---
     std::vector<std::vector<T>> m_buffer; 
     std::vector<T> m_crossfade_window; // Size = overlap_size
@@ -111,6 +164,11 @@ private:
     size_t m_write_index;   // Points to the start of the current "Overlap Region" (where we Add)
     size_t m_read_index;    // Points to the next sample to be read
     size_t m_available_samples; // Samples safely fully written and ready to read
+
+    std::vector<WriteObserver<T>*> m_observers;
+    std::vector<const T*> m_observer_ptrs; // [channel], scratch for notifications
+
+    mutable std::vector<std::uint8_t> m_state_header; // Header segment of the last saveState()
 };
 
 // ===================================================================
@@ -142,6 +200,7 @@ OLARingBuffer2D<T>::OLARingBuffer2D(size_t num_channels, size_t capacity_samples
     for (size_t c = 0; c < m_num_channels; ++c) {
         m_buffer[c].resize(m_capacity_samples, static_cast<T>(0));
     }
+    m_observer_ptrs.resize(m_num_channels);
 
     precomputeWindow();
 }
@@ -247,12 +306,17 @@ bool OLARingBuffer2D<T>::write(const std::vector<std::vector<T>>& data_in) {
     // 4. Update Indices
     // The next write should start adding at the beginning of the NEW tail.
     // The new tail starts at: current_write + input_len - overlap.
+    const size_t resolved_start = m_write_index;
     m_write_index = (m_write_index + net_advance) % m_capacity_samples;
     
     // We can now safely read the data up to the start of the new tail.
     // The tail itself is "incomplete" (yet to be overlapped) and not counted.
     m_available_samples += net_advance;
 
+    if (!m_observers.empty()) {
+        notifyObservers(resolved_start, net_advance);
+    }
+
     return true;
 }
 
@@ -320,6 +384,113 @@ void OLARingBuffer2D<T>::clear() {
     for (auto& ch_buffer : m_buffer) {
         std::fill(ch_buffer.begin(), ch_buffer.end(), static_cast<T>(0));
     }
+
+    for (WriteObserver<T>* observer : m_observers) {
+        observer->onClear();
+    }
+}
+
+template <typename T>
+void OLARingBuffer2D<T>::saveState(std::vector<std::uint8_t>& out) const {
+    std::vector<StateSegment> segments;
+    saveState(segments);
+    appendState(segments, out);
+}
+
+template <typename T>
+void OLARingBuffer2D<T>::saveState(std::vector<StateSegment>& segments_out) const {
+    // Unread samples followed by the pending tail at the write index.
+    const size_t held = std::min(m_available_samples + m_overlap_size, m_capacity_samples);
+
+    detail::StateHeaderWriter header(m_state_header, "JOLA", sizeof(T), detail::StateSampleTypeOf<T>::value);
+    header.put(m_num_channels);
+    header.put(m_capacity_samples);
+    header.put(m_frame_size);
+    header.put(m_overlap_size);
+    header.put(m_read_index);
+    header.put(m_write_index);
+    header.put(m_available_samples);
+    header.put(held);
+    header.finish((m_num_channels * held + m_overlap_size) * sizeof(T));
+
+    segments_out.push_back({m_state_header.data(), m_state_header.size()});
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        detail::appendRingSegments(m_buffer[c].data(), m_capacity_samples, m_read_index, held, segments_out);
+    }
+    if (m_overlap_size > 0) {
+        segments_out.push_back({m_crossfade_window.data(), m_overlap_size * sizeof(T)});
+    }
+}
+
+template <typename T>
+size_t OLARingBuffer2D<T>::loadState(const void* data, size_t size) {
+    detail::StateReader reader(data, size, "JOLA", sizeof(T), detail::StateSampleTypeOf<T>::value, 8);
+    const std::uint64_t channels = reader.get();
+    const std::uint64_t capacity = reader.get();
+    const std::uint64_t frame_size = reader.get();
+    const std::uint64_t overlap_size = reader.get();
+    if (channels != m_num_channels || capacity != m_capacity_samples || frame_size != m_frame_size || overlap_size != m_overlap_size) {
+        throw std::invalid_argument("Snapshot geometry (" + std::to_string(channels) + " channels, capacity " + std::to_string(capacity) +
+                                    ", frame " + std::to_string(frame_size) + ", overlap " + std::to_string(overlap_size) +
+                                    ") does not match this buffer.");
+    }
+
+    const std::uint64_t read_index = reader.get();
+    const std::uint64_t write_index = reader.get();
+    const std::uint64_t available = reader.get();
+    const std::uint64_t held = reader.get();
+    if (read_index >= m_capacity_samples || write_index >= m_capacity_samples || available > m_capacity_samples ||
+        (read_index + available) % m_capacity_samples != write_index ||
+        held != std::min<std::uint64_t>(available + m_overlap_size, m_capacity_samples)) {
+        throw std::runtime_error("Snapshot cursors are inconsistent.");
+    }
+    const size_t count = static_cast<size_t>(held);
+    const std::uint8_t* samples = reader.take(m_num_channels * count * sizeof(T));
+    const std::uint8_t* window = reader.take(m_overlap_size * sizeof(T));
+    const size_t consumed = reader.finish();
+
+    m_read_index = static_cast<size_t>(read_index);
+    m_write_index = static_cast<size_t>(write_index);
+    m_available_samples = static_cast<size_t>(available);
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        detail::copyIntoRing(m_buffer[c].data(), m_capacity_samples, m_read_index, samples + c * count * sizeof(T), count);
+    }
+    if (m_overlap_size > 0) {
+        std::memcpy(m_crossfade_window.data(), window, m_overlap_size * sizeof(T));
+    }
+
+    for (WriteObserver<T>* observer : m_observers) {
+        observer->onClear();
+    }
+    return consumed;
+}
+
+template <typename T>
+void OLARingBuffer2D<T>::addObserver(WriteObserver<T>* observer) {
+    if (observer == nullptr) return;
+    if (std::find(m_observers.begin(), m_observers.end(), observer) == m_observers.end()) {
+        m_observers.push_back(observer);
+    }
+}
+
+template <typename T>
+void OLARingBuffer2D<T>::removeObserver(WriteObserver<T>* observer) {
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), observer), m_observers.end());
+}
+
+template <typename T>
+void OLARingBuffer2D<T>::notifyObservers(size_t start, size_t count) {
+    while (count > 0) {
+        size_t run = std::min(count, m_capacity_samples - start);
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            m_observer_ptrs[c] = m_buffer[c].data() + start;
+        }
+        for (WriteObserver<T>* observer : m_observers) {
+            observer->onWrite(m_observer_ptrs.data(), m_num_channels, run);
+        }
+        start = (start + run) % m_capacity_samples;
+        count -= run;
+    }
 }
 
 template <typename T>
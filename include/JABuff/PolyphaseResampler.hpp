@@ -0,0 +1,274 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument
+#include <cstddef>      // For size_t
+#include <string>       // For std::to_string
+#include <cmath>        // For std::sin, std::sqrt
+#include <numeric>      // For std::gcd
+#include <algorithm>    // For std::fill, std::copy, std::max
+
+#include "FramingRingBuffer2D.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief A streaming rational-ratio resampler that writes straight into a FramingRingBuffer2D.
+ *
+ * Converts by up / down (e.g. 48 kHz -> 16 kHz is 1 / 3, 44.1 kHz -> 16 kHz is
+ * 160 / 441) with a polyphase Kaiser-windowed sinc FIR. Each output sample is one
+ * contiguous dot product of taps_per_phase coefficients with the input history, and
+ * outputs are produced directly into space reserved in the target ring
+ * (reserve() / commit()), so there is no intermediate output vector.
+ *
+ * The filter history and phase carry across write() calls, so any block split of
+ * the input gives the same output stream.
+ *
+ * The filter is linear phase. getGroupDelay() reports its delay in output samples;
+ * add it to the target's own alignment (e.g. when choosing prime() / min_frames) to
+ * keep frame positions aligned with the original input.
+ *
+ * @tparam T The sample type (float or double).
+ */
+template <typename T>
+class PolyphaseResampler {
+public:
+    /**
+     * @brief Construct a resampler feeding a buffer.
+     *
+     * @param target The buffer to write to. Must outlive this object.
+     * @param up The interpolation factor L.
+     * @param down The decimation factor M. The ratio is reduced by gcd(up, down).
+     * @param taps_per_phase FIR taps per polyphase branch (quality vs. cost).
+     * @param rolloff Cutoff as a fraction of the lower of the two Nyquist rates (0, 1].
+     * @param kaiser_beta Kaiser window shape (higher = more stopband attenuation, wider transition).
+     * @throws std::invalid_argument on an invalid configuration.
+     */
+    PolyphaseResampler(FramingRingBuffer2D<T>& target, size_t up, size_t down, size_t taps_per_phase = 32,
+                       double rolloff = 0.9, double kaiser_beta = 8.0);
+
+    /**
+     * @brief Resamples a block and writes the output into the target ring.
+     *
+     * All-or-nothing: if the ring cannot take every output sample this block
+     * produces, nothing is written and the resampler state is unchanged.
+     *
+     * @param data_in Input data [channel][sample]. Any length.
+     * @return true if the output was written, false if the target is too full.
+     * @throws std::invalid_argument if the channel count mismatches or channels differ in length.
+     */
+    bool write(const std::vector<std::vector<T>>& data_in);
+
+    /**
+     * @brief Returns how many output samples the next input_count input samples will produce.
+     */
+    size_t getOutputCount(size_t input_count) const;
+
+    /**
+     * @brief Returns the filter's group delay in output samples: (L * taps - 1) / (2 * M).
+     */
+    double getGroupDelay() const;
+
+    /**
+     * @brief Clears the filter history and phase (the target ring is not touched).
+     */
+    void reset();
+
+    size_t getUp() const;
+    size_t getDown() const;
+    size_t getTapsPerPhase() const;
+
+private:
+    static double besselI0(double x);
+
+    FramingRingBuffer2D<T>& m_target;
+    size_t m_num_channels;
+    size_t m_up;
+    size_t m_down;
+    size_t m_taps;
+
+    std::vector<T> m_phases;            // [phase][tap], reversed so each output is a forward dot product
+    std::vector<std::vector<T>> m_work; // [channel][taps - 1 history + block], input staging
+    size_t m_phase;                     // Current phase (upsampled time mod L)
+    size_t m_input_index;               // Next output's input position, relative to the next block
+    std::vector<RingSpan<T>> m_spans;
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+PolyphaseResampler<T>::PolyphaseResampler(FramingRingBuffer2D<T>& target, size_t up, size_t down, size_t taps_per_phase,
+                                          double rolloff, double kaiser_beta)
+    : m_target(target),
+      m_num_channels(target.getNumChannels()),
+      m_up(up),
+      m_down(down),
+      m_taps(taps_per_phase),
+      m_phase(0),
+      m_input_index(0) {
+
+    if (up == 0 || down == 0) {
+        throw std::invalid_argument("Resampling factors must be non-zero.");
+    }
+    if (taps_per_phase == 0) {
+        throw std::invalid_argument("taps_per_phase must be non-zero.");
+    }
+    if (!(rolloff > 0.0 && rolloff <= 1.0)) {
+        throw std::invalid_argument("rolloff must be in (0, 1].");
+    }
+
+    size_t g = std::gcd(up, down);
+    m_up /= g;
+    m_down /= g;
+
+    // Prototype low-pass at the upsampled rate: cutoff = rolloff / (2 * max(L, M)) cycles/sample,
+    // gain L to make up for the zero stuffing.
+    const double pi = 3.14159265358979323846264338327950288;
+    const size_t length = m_up * m_taps;
+    const double centre = 0.5 * static_cast<double>(length - 1);
+    const double fc = rolloff / static_cast<double>(std::max(m_up, m_down));
+    const double i0_beta = besselI0(kaiser_beta);
+
+    std::vector<double> prototype(length);
+    for (size_t k = 0; k < length; ++k) {
+        double t = static_cast<double>(k) - centre;
+        double sinc = (t == 0.0) ? 1.0 : std::sin(pi * fc * t) / (pi * fc * t);
+        double r = (length > 1) ? t / centre : 0.0;
+        double window = besselI0(kaiser_beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0_beta;
+        prototype[k] = static_cast<double>(m_up) * fc * sinc * window;
+    }
+
+    // Phase p uses h[p + L * j] on x[i - j]; store reversed for a forward dot product over x[i - taps + 1 .. i].
+    m_phases.resize(m_up * m_taps);
+    for (size_t p = 0; p < m_up; ++p) {
+        for (size_t j = 0; j < m_taps; ++j) {
+            m_phases[p * m_taps + (m_taps - 1 - j)] = static_cast<T>(prototype[p + m_up * j]);
+        }
+    }
+
+    m_work.assign(m_num_channels, std::vector<T>(m_taps - 1, static_cast<T>(0)));
+    m_spans.reserve(m_num_channels);
+}
+
+template <typename T>
+double PolyphaseResampler<T>::besselI0(double x) {
+    // Power series; converges quickly for the beta range used by Kaiser windows.
+    double sum = 1.0, term = 1.0, half = 0.5 * x;
+    for (int k = 1; k < 64; ++k) {
+        term *= (half / k) * (half / k);
+        sum += term;
+        if (term < 1e-17 * sum) break;
+    }
+    return sum;
+}
+
+template <typename T>
+size_t PolyphaseResampler<T>::getOutputCount(size_t input_count) const {
+    // Outputs n with input position m_input_index + floor((m_phase + n * M) / L) < input_count.
+    if (m_input_index >= input_count) return 0;
+    size_t limit = (input_count - m_input_index) * m_up; // Upsampled steps available past the current phase
+    if (limit <= m_phase) return 0;
+    return (limit - m_phase - 1) / m_down + 1;
+}
+
+template <typename T>
+bool PolyphaseResampler<T>::write(const std::vector<std::vector<T>>& data_in) {
+    if (data_in.empty()) return true;
+
+    if (data_in.size() != m_num_channels) {
+        throw std::invalid_argument("Input data channel count (" + std::to_string(data_in.size()) +
+                                    ") does not match buffer channels (" + std::to_string(m_num_channels) + ").");
+    }
+
+    const size_t input_len = data_in[0].size();
+    for (size_t c = 1; c < m_num_channels; ++c) {
+        if (data_in[c].size() != input_len) {
+            throw std::invalid_argument("Input data channels have inconsistent sizes.");
+        }
+    }
+    if (input_len == 0) return true;
+
+    const size_t output_len = getOutputCount(input_len);
+    if (output_len > 0 && !m_target.reserve(output_len, m_spans)) {
+        return false;
+    }
+
+    const size_t history = m_taps - 1;
+    size_t phase = m_phase;
+    size_t index = m_input_index;
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        // [history | block]: output at input position i reads work[i .. i + taps).
+        std::vector<T>& work = m_work[c];
+        work.resize(history + input_len);
+        std::copy(data_in[c].begin(), data_in[c].end(), work.begin() + static_cast<std::ptrdiff_t>(history));
+
+        const T* x = work.data();
+        const RingSpan<T>* span = output_len > 0 ? &m_spans[c] : nullptr;
+        phase = m_phase;
+        index = m_input_index;
+
+        for (size_t n = 0; n < output_len; ++n) {
+            const T* h = m_phases.data() + phase * m_taps;
+            const T* in = x + index;
+
+            // Four partial sums keep the dot product vectorisable and the dependency chain short.
+            T acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+            size_t j = 0;
+            for (; j + 4 <= m_taps; j += 4) {
+                acc0 += h[j] * in[j];
+                acc1 += h[j + 1] * in[j + 1];
+                acc2 += h[j + 2] * in[j + 2];
+                acc3 += h[j + 3] * in[j + 3];
+            }
+            for (; j < m_taps; ++j) acc0 += h[j] * in[j];
+
+            (*span)[n] = (acc0 + acc1) + (acc2 + acc3);
+
+            phase += m_down;
+            index += phase / m_up;
+            phase %= m_up;
+        }
+
+        // Keep the newest taps - 1 inputs as history.
+        std::copy(work.end() - static_cast<std::ptrdiff_t>(history), work.end(), work.begin());
+        work.resize(history);
+    }
+
+    // The next output lies at or past the end of this block.
+    m_phase = phase;
+    m_input_index = index - input_len;
+
+    if (output_len > 0) {
+        m_target.commit(output_len);
+    }
+
+    return true;
+}
+
+template <typename T>
+double PolyphaseResampler<T>::getGroupDelay() const {
+    return static_cast<double>(m_up * m_taps - 1) / (2.0 * static_cast<double>(m_down));
+}
+
+template <typename T>
+void PolyphaseResampler<T>::reset() {
+    for (auto& work : m_work) {
+        work.assign(m_taps - 1, static_cast<T>(0));
+    }
+    m_phase = 0;
+    m_input_index = 0;
+}
+
+template <typename T>
+size_t PolyphaseResampler<T>::getUp() const { return m_up; }
+
+template <typename T>
+size_t PolyphaseResampler<T>::getDown() const { return m_down; }
+
+template <typename T>
+size_t PolyphaseResampler<T>::getTapsPerPhase() const { return m_taps; }
+
+} // namespace JABuff
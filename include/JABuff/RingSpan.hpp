@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstring>      // For std::memcpy
+#include <cstddef>      // For size_t
+#include <type_traits>  // For std::remove_const_t
+
+namespace JABuff {
+
+/**
+ * @brief A zero-copy view of a contiguous range of ring storage.
+ *
+ * Because the range may wrap around the end of the ring, it is described by
+ * up to two runs: [first, first + first_size) followed by
+ * [second, second + second_size). second_size is 0 when the range does not wrap.
+ *
+ * A view is only valid until the next write to the buffer it came from.
+ *
+ * @tparam T The element type (use const T for read-only views).
+ */
+template <typename T>
+struct RingSpan {
+    T* first = nullptr;
+    size_t first_size = 0;
+    T* second = nullptr;
+    size_t second_size = 0;
+
+    size_t size() const { return first_size + second_size; }
+
+    bool isContiguous() const { return second_size == 0; }
+
+    T& operator[](size_t i) const {
+        return (i < first_size) ? first[i] : second[i - first_size];
+    }
+
+    /**
+     * @brief Copies the whole view into dest (which must hold size() elements).
+     */
+    void copyTo(std::remove_const_t<T>* dest) const {
+        std::memcpy(dest, first, first_size * sizeof(T));
+        if (second_size > 0) {
+            std::memcpy(dest + first_size, second, second_size * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Returns the sub-range [offset, offset + count) as a new view.
+     */
+    RingSpan subspan(size_t offset, size_t count) const {
+        RingSpan out;
+        if (offset < first_size) {
+            out.first = first + offset;
+            out.first_size = (count < first_size - offset) ? count : first_size - offset;
+            out.second = second;
+            out.second_size = count - out.first_size;
+        } else {
+            out.first = second + (offset - first_size);
+            out.first_size = count;
+        }
+        return out;
+    }
+};
+
+} // namespace JABuff
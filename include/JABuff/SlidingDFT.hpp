@@ -0,0 +1,236 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <complex>      // For std::complex
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <cstddef>      // For size_t
+#include <string>       // For std::to_string
+#include <cmath>        // For std::cos, std::sin
+#include <algorithm>    // For std::fill
+
+#include "FramingRingBuffer2D.hpp"
+#include "WriteObserver.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief Tracks a handful of DFT bins over the newest frame of a FramingRingBuffer2D.
+ *
+ * Attaches itself to the buffer as a WriteObserver and updates each tracked bin
+ * with the sliding DFT recurrence on every write:
+ *
+ *   X_k <- (X_k + x_in - x_out) * exp(+2*pi*i*k/N)
+ *
+ * where N is the buffer's frame size, x_in the sample entering the window and
+ * x_out the sample leaving it. The cost is O(bins * new samples) per write
+ * instead of an O(N log N) FFT per frame.
+ *
+ * After any write, bin k equals the DFT of the newest N samples written (index 0 =
+ * the oldest). Samples before the first write count as zero. The window is rectangular.
+ * These N samples form a frame read() returns only when the write ends on the
+ * frame grid: (samples written - N) must be a multiple of the hop, e.g. writes of
+ * N samples followed by writes of whole hops. Otherwise the bins describe a window
+ * offset from every frame; query them only after grid-aligned writes if they
+ * must match the frames read() returns.
+ *
+ * The state is kept in double and re-synchronised from the exact DFT every
+ * resync_interval samples to bound drift of the recurrence.
+ *
+ * @tparam T The sample type of the buffer.
+ */
+template <typename T>
+class SlidingDFT : public WriteObserver<T> {
+public:
+    /**
+     * @brief Construct and attach to a buffer.
+     *
+     * @param buffer The buffer to follow. Must outlive this object.
+     * @param bins The DFT bin indices to track (each < frame_size).
+     * @param resync_interval Samples between exact re-computations (0 = never).
+     * @throws std::invalid_argument if bins is empty or a bin is out of range.
+     */
+    SlidingDFT(FramingRingBuffer2D<T>& buffer, const std::vector<size_t>& bins, size_t resync_interval = 1 << 16);
+
+    ~SlidingDFT() override;
+
+    SlidingDFT(const SlidingDFT&) = delete;
+    SlidingDFT& operator=(const SlidingDFT&) = delete;
+
+    void onWrite(const T* const* channels, size_t num_channels, size_t count) override;
+    void onClear() override;
+
+    /**
+     * @brief Returns the complex value of a tracked bin.
+     * @param channel The channel index.
+     * @param bin_index The index into the bins passed to the constructor (not the DFT bin).
+     * @throws std::out_of_range if channel or bin_index is out of range.
+     */
+    std::complex<T> getBin(size_t channel, size_t bin_index) const;
+
+    /**
+     * @brief Returns |X_k| of a tracked bin.
+     */
+    T getMagnitude(size_t channel, size_t bin_index) const;
+
+    /**
+     * @brief Returns |X_k|^2 of a tracked bin.
+     */
+    T getPower(size_t channel, size_t bin_index) const;
+
+    const std::vector<size_t>& getBins() const;
+    size_t getWindowSize() const;
+
+    /**
+     * @brief Resets all bins and the window history to zero.
+     */
+    void reset();
+
+private:
+    void resync();
+
+    FramingRingBuffer2D<T>& m_buffer;
+    std::vector<size_t> m_bins;
+    size_t m_window_size;
+    size_t m_num_channels;
+    size_t m_resync_interval;
+    size_t m_since_resync;
+
+    std::vector<std::complex<double>> m_rotations;          // [bin] exp(+2*pi*i*k/N)
+    std::vector<std::vector<std::complex<double>>> m_state; // [channel][bin]
+    std::vector<std::vector<T>> m_history;                  // [channel][N], circular
+    size_t m_history_index;                                 // Oldest sample in the window
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+SlidingDFT<T>::SlidingDFT(FramingRingBuffer2D<T>& buffer, const std::vector<size_t>& bins, size_t resync_interval)
+    : m_buffer(buffer),
+      m_bins(bins),
+      m_window_size(buffer.getFrameSizeFeatures()),
+      m_num_channels(buffer.getNumChannels()),
+      m_resync_interval(resync_interval),
+      m_since_resync(0),
+      m_history_index(0) {
+
+    if (m_bins.empty()) {
+        throw std::invalid_argument("SlidingDFT requires at least one bin.");
+    }
+    if (m_window_size == 0) {
+        throw std::invalid_argument("SlidingDFT requires a non-zero frame size.");
+    }
+
+    const double two_pi = 6.283185307179586476925286766559;
+    m_rotations.resize(m_bins.size());
+    for (size_t b = 0; b < m_bins.size(); ++b) {
+        if (m_bins[b] >= m_window_size) {
+            throw std::invalid_argument("Bin " + std::to_string(m_bins[b]) + " out of range for frame size " + std::to_string(m_window_size) + ".");
+        }
+        double phase = two_pi * static_cast<double>(m_bins[b]) / static_cast<double>(m_window_size);
+        m_rotations[b] = std::complex<double>(std::cos(phase), std::sin(phase));
+    }
+
+    m_state.assign(m_num_channels, std::vector<std::complex<double>>(m_bins.size()));
+    m_history.assign(m_num_channels, std::vector<T>(m_window_size, static_cast<T>(0)));
+
+    m_buffer.addObserver(this);
+}
+
+template <typename T>
+SlidingDFT<T>::~SlidingDFT() {
+    m_buffer.removeObserver(this);
+}
+
+template <typename T>
+void SlidingDFT<T>::onWrite(const T* const* channels, size_t num_channels, size_t count) {
+    (void)num_channels;
+    const size_t num_bins = m_bins.size();
+
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        const T* input = channels[c];
+        T* history = m_history[c].data();
+        std::complex<double>* state = m_state[c].data();
+        size_t index = m_history_index;
+
+        for (size_t j = 0; j < count; ++j) {
+            double delta = static_cast<double>(input[j]) - static_cast<double>(history[index]);
+            history[index] = input[j];
+            if (++index == m_window_size) index = 0;
+
+            for (size_t b = 0; b < num_bins; ++b) {
+                state[b] = (state[b] + delta) * m_rotations[b];
+            }
+        }
+    }
+
+    m_history_index = (m_history_index + count) % m_window_size;
+
+    m_since_resync += count;
+    if (m_resync_interval > 0 && m_since_resync >= m_resync_interval) {
+        resync();
+    }
+}
+
+template <typename T>
+void SlidingDFT<T>::resync() {
+    const double two_pi = 6.283185307179586476925286766559;
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        for (size_t b = 0; b < m_bins.size(); ++b) {
+            std::complex<double> acc(0.0, 0.0);
+            for (size_t m = 0; m < m_window_size; ++m) {
+                size_t index = (m_history_index + m) % m_window_size;
+                double phase = -two_pi * static_cast<double>((m_bins[b] * m) % m_window_size) / static_cast<double>(m_window_size);
+                acc += static_cast<double>(m_history[c][index]) * std::complex<double>(std::cos(phase), std::sin(phase));
+            }
+            m_state[c][b] = acc;
+        }
+    }
+    m_since_resync = 0;
+}
+
+template <typename T>
+void SlidingDFT<T>::onClear() {
+    reset();
+}
+
+template <typename T>
+void SlidingDFT<T>::reset() {
+    for (auto& channel_state : m_state) {
+        std::fill(channel_state.begin(), channel_state.end(), std::complex<double>(0.0, 0.0));
+    }
+    for (auto& channel_history : m_history) {
+        std::fill(channel_history.begin(), channel_history.end(), static_cast<T>(0));
+    }
+    m_history_index = 0;
+    m_since_resync = 0;
+}
+
+template <typename T>
+std::complex<T> SlidingDFT<T>::getBin(size_t channel, size_t bin_index) const {
+    if (channel >= m_num_channels || bin_index >= m_bins.size()) {
+        throw std::out_of_range("SlidingDFT bin access out of range (channel " + std::to_string(channel) +
+                                ", bin index " + std::to_string(bin_index) + ").");
+    }
+    const std::complex<double>& v = m_state[channel][bin_index];
+    return std::complex<T>(static_cast<T>(v.real()), static_cast<T>(v.imag()));
+}
+
+template <typename T>
+T SlidingDFT<T>::getMagnitude(size_t channel, size_t bin_index) const {
+    return std::abs(getBin(channel, bin_index));
+}
+
+template <typename T>
+T SlidingDFT<T>::getPower(size_t channel, size_t bin_index) const {
+    return std::norm(getBin(channel, bin_index));
+}
+
+template <typename T>
+const std::vector<size_t>& SlidingDFT<T>::getBins() const { return m_bins; }
+
+template <typename T>
+size_t SlidingDFT<T>::getWindowSize() const { return m_window_size; }
+
+} // namespace JABuff
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <complex>      // For std::complex
+#include <stdexcept>    // For std::invalid_argument
+#include <cstddef>      // For size_t
+#include <string>       // For std::to_string
+#include <algorithm>    // For std::min
+#include <cmath>        // For std::cos
+
+#include "FramingRingBuffer2D.hpp"
+#include "FramingRingBuffer3D.hpp"
+#include "FFT.hpp"
+
+namespace JABuff {
+
+/**
+ * @brief What StreamingSTFT stores per frequency bin.
+ */
+enum class SpectrumType {
+    Magnitude, // |X[k]|
+    Power      // |X[k]|^2
+};
+
+/**
+ * @brief A streaming STFT front-end: samples in, spectrogram frames out.
+ *
+ * Owns a FramingRingBuffer2D for the input samples (frame = fft_size,
+ * hop = hop_size) and a FramingRingBuffer3D for the output spectra
+ * ([channel][time][fft_size / 2 + 1]). Every write() windows each newly
+ * completed frame straight from the input ring, runs the FFT, and writes the
+ * magnitudes straight into the 3D ring (no intermediate frame vectors).
+ *
+ * Read spectra from getSpectrogram() using the usual FramingRingBuffer3D API.
+ *
+ * @tparam T The sample type (float or double).
+ * @tparam StorageT The 3D storage type (see FramingRingBuffer3D). Defaults to T.
+ * @tparam FFTImpl The FFT. Must be constructible from (size_t n) and provide
+ * forward(const T* in, std::complex<T>* out) writing n/2 + 1 bins. Defaults to RealFFT<T>.
+ */
+template <typename T, typename StorageT = T, typename FFTImpl = RealFFT<T>>
+class StreamingSTFT {
+public:
+    /**
+     * @brief Construct a new Streaming STFT.
+     *
+     * @param num_channels The number of audio channels.
+     * @param fft_size The analysis window / FFT size in samples.
+     * @param hop_size The number of samples between consecutive spectra. Must be <= fft_size.
+     * @param capacity_time The spectrogram ring capacity in time steps (spectra).
+     * @param frame_size_time Spectrogram frame size in time steps (see FramingRingBuffer3D).
+     * @param hop_size_time Spectrogram hop size in time steps.
+     * @param min_frames Spectrogram min_frames.
+     * @param keep_frames Spectrogram keep_frames.
+     * @param type Magnitude or power spectrum.
+     */
+    StreamingSTFT(size_t num_channels, size_t fft_size, size_t hop_size, size_t capacity_time,
+                  size_t frame_size_time = 1, size_t hop_size_time = 1, size_t min_frames = 1, size_t keep_frames = 0,
+                  SpectrumType type = SpectrumType::Magnitude);
+
+    /**
+     * @brief Writes a block of samples and pushes every spectrum it completes.
+     *
+     * The write is all-or-nothing: if the spectrogram cannot hold every spectrum
+     * this block would produce, nothing is written.
+     *
+     * @param data_in Input data [channel][sample]. Any length.
+     * @return true if write succeeded, false if the spectrogram is too full.
+     * @throws std::invalid_argument if channel count mismatches.
+     */
+    bool write(const std::vector<std::vector<T>>& data_in);
+
+    /**
+     * @brief Primes the input ring so that the next write of hop_size samples
+     * produces a spectrum (see FramingRingBuffer2D::prime()).
+     */
+    void prime(T value = 0);
+
+    /**
+     * @brief Replaces the analysis window (default: periodic Hann).
+     * @throws std::invalid_argument if window.size() != fft_size.
+     */
+    void setWindow(const std::vector<T>& window);
+
+    /**
+     * @brief Resets both rings. The window is kept.
+     */
+    void clear();
+
+    FramingRingBuffer3D<T, StorageT>& getSpectrogram();
+    const FramingRingBuffer3D<T, StorageT>& getSpectrogram() const;
+    const std::vector<T>& getWindow() const;
+    size_t getNumChannels() const;
+    size_t getFFTSize() const;
+    size_t getHopSize() const;
+    size_t getNumBins() const;
+
+    /**
+     * @brief Returns the latency the STFT adds, in input samples: fft_size - hop_size.
+     *
+     * A spectrum is pushed as soon as the hop that completes its window is written,
+     * and that window reaches fft_size - hop_size samples further back. This is the
+     * delay a parallel (e.g. dry or label) stream needs to line up with the
+     * spectrogram's time steps, and the analysis share of an STFT/ISTFT round trip.
+     */
+    size_t getLatencySamples() const;
+
+    /**
+     * @brief Returns how many more input samples are needed before the next spectrum is pushed.
+     */
+    size_t getSamplesUntilNextSpectrum() const;
+
+private:
+    void processAvailableFrames();
+
+    size_t m_num_channels;
+    size_t m_fft_size;
+    size_t m_hop_size;
+    size_t m_num_bins;
+    SpectrumType m_type;
+
+    FramingRingBuffer2D<T> m_input;
+    FramingRingBuffer3D<T, StorageT> m_spectrogram;
+    FFTImpl m_fft;
+
+    std::vector<T> m_window;
+    std::vector<T> m_frame;                 // Windowed frame (FFT input)
+    std::vector<std::complex<T>> m_bins;    // FFT output
+    std::vector<RingSpan<const T>> m_views; // Input frame views
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T, typename StorageT, typename FFTImpl>
+StreamingSTFT<T, StorageT, FFTImpl>::StreamingSTFT(size_t num_channels, size_t fft_size, size_t hop_size, size_t capacity_time,
+                                                   size_t frame_size_time, size_t hop_size_time, size_t min_frames, size_t keep_frames,
+                                                   SpectrumType type)
+    : m_num_channels(num_channels),
+      m_fft_size(fft_size),
+      m_hop_size(hop_size),
+      m_num_bins(fft_size / 2 + 1),
+      m_type(type),
+      m_input(num_channels, fft_size + hop_size, fft_size, hop_size == 0 ? 1 : hop_size),
+      m_spectrogram(num_channels, fft_size / 2 + 1, capacity_time, frame_size_time, hop_size_time, min_frames, keep_frames),
+      m_fft(fft_size) {
+
+    if (m_hop_size == 0 || m_hop_size > m_fft_size) {
+        throw std::invalid_argument("Hop size (" + std::to_string(hop_size) + ") must be in [1, fft_size].");
+    }
+
+    // Periodic Hann
+    const double two_pi = 6.283185307179586476925286766559;
+    m_window.resize(m_fft_size);
+    for (size_t i = 0; i < m_fft_size; ++i) {
+        m_window[i] = static_cast<T>(0.5 - 0.5 * std::cos(two_pi * static_cast<double>(i) / static_cast<double>(m_fft_size)));
+    }
+
+    m_frame.resize(m_fft_size);
+    m_bins.resize(m_num_bins);
+    m_views.reserve(m_num_channels);
+}
+
+template <typename T, typename StorageT, typename FFTImpl>
+bool StreamingSTFT<T, StorageT, FFTImpl>::write(const std::vector<std::vector<T>>& data_in) {
+    if (data_in.empty()) return true;
+
+    if (data_in.size() != m_num_channels) {
+        throw std::invalid_argument("Input data channel count (" + std::to_string(data_in.size()) +
+                                    ") does not match STFT channels (" + std::to_string(m_num_channels) + ").");
+    }
+
+    size_t input_len = data_in[0].size();
+    if (input_len == 0) return true;
+
+    // All-or-nothing: check the spectrogram can take every spectrum this block completes.
+    size_t pending = m_input.getAvailableFeaturesRead() + input_len;
+    size_t new_spectra = (pending < m_fft_size) ? 0 : 1 + (pending - m_fft_size) / m_hop_size;
+    if (new_spectra > m_spectrogram.getAvailableWrite()) {
+        return false;
+    }
+
+    // The input ring only holds fft_size + hop_size samples, so feed it in chunks.
+    size_t offset = 0;
+    while (offset < input_len) {
+        size_t chunk = std::min(input_len - offset, m_input.getAvailableWrite());
+        m_input.write(data_in, offset, chunk);
+        offset += chunk;
+        processAvailableFrames();
+    }
+
+    return true;
+}
+
+template <typename T, typename StorageT, typename FFTImpl>
+void StreamingSTFT<T, StorageT, FFTImpl>::processAvailableFrames() {
+    while (m_input.peek(m_views, 1)) {
+        m_spectrogram.pushInPlace([this](size_t c, T* features) {
+            // Window straight out of the ring (view may wrap)
+            const RingSpan<const T>& view = m_views[c];
+            const T* w = m_window.data();
+            T* frame = m_frame.data();
+            for (size_t i = 0; i < view.first_size; ++i) frame[i] = view.first[i] * w[i];
+            for (size_t i = 0; i < view.second_size; ++i) frame[view.first_size + i] = view.second[i] * w[view.first_size + i];
+
+            m_fft.forward(m_frame.data(), m_bins.data());
+
+            if (m_type == SpectrumType::Power) {
+                for (size_t k = 0; k < m_num_bins; ++k) features[k] = std::norm(m_bins[k]);
+            } else {
+                for (size_t k = 0; k < m_num_bins; ++k) features[k] = std::abs(m_bins[k]);
+            }
+        });
+        m_input.advance(1);
+    }
+}
+
+template <typename T, typename StorageT, typename FFTImpl>
+void StreamingSTFT<T, StorageT, FFTImpl>::prime(T value) {
+    m_input.prime(value);
+}
+
+template <typename T, typename StorageT, typename FFTImpl>
+void StreamingSTFT<T, StorageT, FFTImpl>::setWindow(const std::vector<T>& window) {
+    if (window.size() != m_fft_size) {
+        throw std::invalid_argument("Window size (" + std::to_string(window.size()) +
+                                    ") does not match FFT size (" + std::to_string(m_fft_size) + ").");
+    }
+    m_window = window;
+}
+
+template <typename T, typename StorageT, typename FFTImpl>
+void StreamingSTFT<T, StorageT, FFTImpl>::clear() {
+    m_input.clear();
+    m_spectrogram.clear();
+}
+
+template <typename T, typename StorageT, typename FFTImpl>
+FramingRingBuffer3D<T, StorageT>& StreamingSTFT<T, StorageT, FFTImpl>::getSpectrogram() { return m_spectrogram; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+const FramingRingBuffer3D<T, StorageT>& StreamingSTFT<T, StorageT, FFTImpl>::getSpectrogram() const { return m_spectrogram; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+const std::vector<T>& StreamingSTFT<T, StorageT, FFTImpl>::getWindow() const { return m_window; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+size_t StreamingSTFT<T, StorageT, FFTImpl>::getNumChannels() const { return m_num_channels; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+size_t StreamingSTFT<T, StorageT, FFTImpl>::getFFTSize() const { return m_fft_size; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+size_t StreamingSTFT<T, StorageT, FFTImpl>::getHopSize() const { return m_hop_size; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+size_t StreamingSTFT<T, StorageT, FFTImpl>::getNumBins() const { return m_num_bins; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+size_t StreamingSTFT<T, StorageT, FFTImpl>::getLatencySamples() const { return m_fft_size - m_hop_size; }
+
+template <typename T, typename StorageT, typename FFTImpl>
+size_t StreamingSTFT<T, StorageT, FFTImpl>::getSamplesUntilNextSpectrum() const {
+    // After processing, the input ring always holds less than one frame.
+    return m_fft_size - m_input.getAvailableFeaturesRead();
+}
+
+} // namespace JABuff
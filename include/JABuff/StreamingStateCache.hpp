@@ -0,0 +1,233 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <cstddef>      // For size_t
+#include <cstring>      // For std::memmove
+#include <string>       // For std::to_string
+#include <algorithm>    // For std::fill
+
+namespace JABuff {
+
+/**
+ * @brief Shape of one layer's state in a StreamingStateCache.
+ */
+struct StateCacheLayer {
+    size_t history_steps; // Left context kept across chunks (e.g. kernel_size - 1)
+    size_t feature_dim;   // Activations per time step
+};
+
+/**
+ * @brief A zero-copy [history + chunk] view of one layer's state.
+ *
+ * Rows are time steps, row-major, contiguous: data[t * feature_dim + f] for
+ * t in [0, history_steps + chunk_steps). The first history_steps rows are the
+ * kept left context; the caller writes the new chunk into rows from chunk() on.
+ *
+ * A view is only valid until the next advance() or reset() of the cache.
+ */
+template <typename T>
+struct StateView {
+    T* data = nullptr;
+    size_t history_steps = 0;
+    size_t chunk_steps = 0;
+    size_t feature_dim = 0;
+
+    size_t steps() const { return history_steps + chunk_steps; }
+    T* row(size_t t) const { return data + t * feature_dim; }
+    T* chunk() const { return data + history_steps * feature_dim; }
+};
+
+/**
+ * @brief Per-layer left-context state for streaming causal models (conv / attention caches).
+ *
+ * Every layer owns a linear region of one shared slab. Its kept history and the
+ * incoming chunk always sit next to each other, so getView() hands out a single
+ * contiguous [history + chunk] block that a convolution or attention kernel can
+ * consume in place; no per-chunk copy of the history in or out.
+ *
+ * advance() moves every layer's history window forward by the chunk length.
+ * Only when a region runs out of room are its last history_steps rows moved back
+ * to the region start (the region is twice the size of the largest view, so this
+ * is amortised and happens at most once every few chunks). This is the keep_frames
+ * idea of FramingRingBuffer3D, laid out so that the kept context is always
+ * contiguous with new data.
+ *
+ * History starts out as zeros (causal zero padding).
+ *
+ * @tparam T The activation type.
+ */
+template <typename T>
+class StreamingStateCache {
+public:
+    /**
+     * @brief Construct a new cache.
+     *
+     * @param layers The shape of each layer's state.
+     * @param max_chunk_steps The largest chunk that will be processed at once.
+     * @throws std::invalid_argument if layers is empty, max_chunk_steps is 0 or a layer has feature_dim 0.
+     */
+    StreamingStateCache(const std::vector<StateCacheLayer>& layers, size_t max_chunk_steps);
+
+    /**
+     * @brief Returns the [history + chunk] view of a layer for a chunk of chunk_steps.
+     *
+     * Write the layer's new activations into view.chunk(), run the layer on the
+     * whole view, then call advance(chunk_steps) once all layers are done.
+     *
+     * @throws std::out_of_range if layer is out of range.
+     * @throws std::invalid_argument if chunk_steps > max_chunk_steps.
+     */
+    StateView<T> getView(size_t layer, size_t chunk_steps);
+
+    /**
+     * @brief Returns a layer's current history only (no chunk).
+     * @throws std::out_of_range if layer is out of range.
+     */
+    StateView<T> getHistory(size_t layer);
+
+    /**
+     * @brief Commits a chunk of chunk_steps on every layer: the newest
+     * history_steps rows of [history + chunk] become the history.
+     *
+     * @throws std::invalid_argument if chunk_steps > max_chunk_steps.
+     */
+    void advance(size_t chunk_steps);
+
+    /**
+     * @brief Resets every layer's history to zeros.
+     */
+    void reset();
+
+    size_t getNumLayers() const;
+    size_t getMaxChunkSteps() const;
+    const StateCacheLayer& getLayer(size_t layer) const;
+
+    /**
+     * @brief Returns the size of the shared slab in bytes.
+     */
+    size_t getSlabBytes() const;
+
+private:
+    void checkLayer(size_t layer) const;
+    void checkChunk(size_t chunk_steps) const;
+
+    std::vector<StateCacheLayer> m_layers;
+    size_t m_max_chunk_steps;
+
+    std::vector<T> m_slab;
+    std::vector<size_t> m_region_offset; // [layer] element offset of the region in the slab
+    std::vector<size_t> m_region_steps;  // [layer] region length in time steps
+    std::vector<size_t> m_history_begin; // [layer] first history row within the region
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+StreamingStateCache<T>::StreamingStateCache(const std::vector<StateCacheLayer>& layers, size_t max_chunk_steps)
+    : m_layers(layers),
+      m_max_chunk_steps(max_chunk_steps) {
+
+    if (m_layers.empty()) {
+        throw std::invalid_argument("StreamingStateCache requires at least one layer.");
+    }
+    if (m_max_chunk_steps == 0) {
+        throw std::invalid_argument("max_chunk_steps must be non-zero.");
+    }
+
+    // Regions start on a 64-byte boundary relative to the slab start.
+    const size_t align_elems = (64 % sizeof(T) == 0) ? 64 / sizeof(T) : 1;
+
+    size_t total = 0;
+    m_region_offset.resize(m_layers.size());
+    m_region_steps.resize(m_layers.size());
+    m_history_begin.assign(m_layers.size(), 0);
+    for (size_t l = 0; l < m_layers.size(); ++l) {
+        if (m_layers[l].feature_dim == 0) {
+            throw std::invalid_argument("Layer " + std::to_string(l) + " has feature_dim 0.");
+        }
+        m_region_offset[l] = total;
+        m_region_steps[l] = 2 * (m_layers[l].history_steps + m_max_chunk_steps);
+        size_t elems = m_region_steps[l] * m_layers[l].feature_dim;
+        total += (elems + align_elems - 1) / align_elems * align_elems;
+    }
+
+    m_slab.assign(total, static_cast<T>(0));
+}
+
+template <typename T>
+void StreamingStateCache<T>::checkLayer(size_t layer) const {
+    if (layer >= m_layers.size()) {
+        throw std::out_of_range("Layer " + std::to_string(layer) + " out of range.");
+    }
+}
+
+template <typename T>
+void StreamingStateCache<T>::checkChunk(size_t chunk_steps) const {
+    if (chunk_steps > m_max_chunk_steps) {
+        throw std::invalid_argument("Chunk (" + std::to_string(chunk_steps) + ") exceeds max_chunk_steps (" +
+                                    std::to_string(m_max_chunk_steps) + ").");
+    }
+}
+
+template <typename T>
+StateView<T> StreamingStateCache<T>::getView(size_t layer, size_t chunk_steps) {
+    checkLayer(layer);
+    checkChunk(chunk_steps);
+
+    const StateCacheLayer& spec = m_layers[layer];
+    StateView<T> view;
+    view.data = m_slab.data() + m_region_offset[layer] + m_history_begin[layer] * spec.feature_dim;
+    view.history_steps = spec.history_steps;
+    view.chunk_steps = chunk_steps;
+    view.feature_dim = spec.feature_dim;
+    return view;
+}
+
+template <typename T>
+StateView<T> StreamingStateCache<T>::getHistory(size_t layer) {
+    return getView(layer, 0);
+}
+
+template <typename T>
+void StreamingStateCache<T>::advance(size_t chunk_steps) {
+    checkChunk(chunk_steps);
+
+    for (size_t l = 0; l < m_layers.size(); ++l) {
+        const StateCacheLayer& spec = m_layers[l];
+        size_t begin = m_history_begin[l] + chunk_steps;
+
+        // Compact when the next [history + max chunk] view would not fit.
+        if (begin + spec.history_steps + m_max_chunk_steps > m_region_steps[l]) {
+            T* region = m_slab.data() + m_region_offset[l];
+            std::memmove(region, region + begin * spec.feature_dim, spec.history_steps * spec.feature_dim * sizeof(T));
+            begin = 0;
+        }
+        m_history_begin[l] = begin;
+    }
+}
+
+template <typename T>
+void StreamingStateCache<T>::reset() {
+    std::fill(m_slab.begin(), m_slab.end(), static_cast<T>(0));
+    std::fill(m_history_begin.begin(), m_history_begin.end(), 0);
+}
+
+template <typename T>
+size_t StreamingStateCache<T>::getNumLayers() const { return m_layers.size(); }
+
+template <typename T>
+size_t StreamingStateCache<T>::getMaxChunkSteps() const { return m_max_chunk_steps; }
+
+template <typename T>
+const StateCacheLayer& StreamingStateCache<T>::getLayer(size_t layer) const {
+    checkLayer(layer);
+    return m_layers[layer];
+}
+
+template <typename T>
+size_t StreamingStateCache<T>::getSlabBytes() const { return m_slab.size() * sizeof(T); }
+
+} // namespace JABuff
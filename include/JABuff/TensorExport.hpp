@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>       // For std::vector
+#include <cstddef>      // For size_t
+#include <cstdint>      // For std::int64_t, std::uint64_t
+#include <algorithm>    // For std::find, std::min_element
+
+#include "FeatureStorage.hpp"
+
+#if defined(__has_include)
+#if __has_include(<dlpack/dlpack.h>)
+#include <dlpack/dlpack.h>
+#define JABUFF_HAS_DLPACK 1
+#endif
+#endif
+
+namespace JABuff {
+
+// ===================================================================
+// --- DLPack types ---
+// ===================================================================
+
+#if defined(JABUFF_HAS_DLPACK)
+using DLDevice = ::DLDevice;
+using DLDataType = ::DLDataType;
+using DLTensor = ::DLTensor;
+#else
+/**
+ * @brief Layout-compatible mirrors of the DLPack C structs (dlpack.h v0.8+),
+ * used when <dlpack/dlpack.h> is not on the include path. A DLTensor* from
+ * here can be handed to any DLPack consumer.
+ */
+struct DLDevice {
+    std::int32_t device_type; // 1 = kDLCPU
+    std::int32_t device_id;
+};
+
+struct DLDataType {
+    std::uint8_t code;        // 0 = int, 1 = uint, 2 = float, 4 = bfloat
+    std::uint8_t bits;
+    std::uint16_t lanes;
+};
+
+struct DLTensor {
+    void* data;
+    DLDevice device;
+    std::int32_t ndim;
+    DLDataType dtype;
+    std::int64_t* shape;
+    std::int64_t* strides;    // In elements, not bytes
+    std::uint64_t byte_offset;
+};
+#endif
+
+namespace detail {
+
+// dlpack.h declares device_type as the DLDeviceType enum, the mirror as int32.
+constexpr decltype(DLDevice{}.device_type) kDLCPUDevice = static_cast<decltype(DLDevice{}.device_type)>(1);
+
+/**
+ * @brief Maps a storage type to its DLPack dtype.
+ */
+template <typename S> struct DLTypeOf;
+template <> struct DLTypeOf<float>         { static DLDataType get() { return {2, 32, 1}; } };
+template <> struct DLTypeOf<double>        { static DLDataType get() { return {2, 64, 1}; } };
+template <> struct DLTypeOf<Float16>       { static DLDataType get() { return {2, 16, 1}; } };
+template <> struct DLTypeOf<BFloat16>      { static DLDataType get() { return {4, 16, 1}; } };
+template <> struct DLTypeOf<std::int8_t>   { static DLDataType get() { return {0, 8, 1}; } };
+template <> struct DLTypeOf<std::int16_t>  { static DLDataType get() { return {0, 16, 1}; } };
+template <> struct DLTypeOf<std::int32_t>  { static DLDataType get() { return {0, 32, 1}; } };
+template <> struct DLTypeOf<std::uint8_t>  { static DLDataType get() { return {1, 8, 1}; } };
+
+/**
+ * @brief The absolute read positions a buffer must not overwrite while exported tensors borrow them.
+ */
+struct PinRegistry {
+    std::vector<std::uint64_t> positions;
+
+    void add(std::uint64_t position) { positions.push_back(position); }
+
+    void remove(std::uint64_t position) {
+        auto it = std::find(positions.begin(), positions.end(), position);
+        if (it != positions.end()) {
+            *it = positions.back();
+            positions.pop_back();
+        }
+    }
+
+    bool empty() const { return positions.empty(); }
+
+    std::uint64_t oldest() const { return *std::min_element(positions.begin(), positions.end()); }
+};
+
+} // namespace detail
+
+template <typename T> class FramingRingBuffer2D;
+template <typename T, typename StorageT> class FramingRingBuffer3D;
+
+/**
+ * @brief A DLPack tensor describing frames of a FramingRingBuffer2D / 3D.
+ *
+ * Filled by the buffers' exportFrames(). When the frames do not wrap around the
+ * end of the ring, the tensor points straight into ring storage (isZeroCopy()) and
+ * holds a pin: until release() or destruction, the buffer refuses writes that would
+ * overwrite the exported region, even if the frames are consumed in the meantime.
+ * Wrapped frames are copied into storage owned by this object instead.
+ *
+ * The buffer must outlive the tensor (or the tensor must be released first).
+ *
+ * @tparam S The element type of the exported data (the buffer's storage type).
+ */
+template <typename S>
+class ExportedTensor {
+public:
+    ExportedTensor() { m_tensor = DLTensor{}; }
+    ~ExportedTensor() { release(); }
+
+    ExportedTensor(const ExportedTensor&) = delete;
+    ExportedTensor& operator=(const ExportedTensor&) = delete;
+
+    /**
+     * @brief Returns the DLPack descriptor. Shape and strides point into this object.
+     */
+    DLTensor* get() { return &m_tensor; }
+    const DLTensor* get() const { return &m_tensor; }
+
+    /**
+     * @brief Returns the typed data pointer (data + byte_offset).
+     */
+    const S* data() const { return static_cast<const S*>(m_tensor.data); }
+
+    bool isZeroCopy() const { return m_zero_copy; }
+    bool isPinned() const { return m_registry != nullptr; }
+    size_t getNumFrames() const { return m_num_frames; }
+
+    /**
+     * @brief Unpins the ring region (if pinned) and empties the descriptor.
+     */
+    void release() {
+        if (m_registry) {
+            m_registry->remove(m_pinned_position);
+            m_registry = nullptr;
+        }
+        m_tensor = DLTensor{};
+        m_zero_copy = false;
+        m_num_frames = 0;
+    }
+
+private:
+    template <typename> friend class FramingRingBuffer2D;
+    template <typename, typename> friend class FramingRingBuffer3D;
+
+    // Fills the descriptor (strides in elements); pins if registry is set.
+    void set(S* data, std::int32_t ndim, const std::int64_t* shape, const std::int64_t* strides,
+             size_t num_frames, detail::PinRegistry* registry, std::uint64_t pinned_position) {
+        release();
+        for (std::int32_t i = 0; i < ndim; ++i) {
+            m_shape[i] = shape[i];
+            m_strides[i] = strides[i];
+        }
+        m_tensor.data = data;
+        m_tensor.device.device_type = detail::kDLCPUDevice;
+        m_tensor.device.device_id = 0;
+        m_tensor.ndim = ndim;
+        m_tensor.dtype = detail::DLTypeOf<S>::get();
+        m_tensor.shape = m_shape;
+        m_tensor.strides = m_strides;
+        m_tensor.byte_offset = 0;
+        m_num_frames = num_frames;
+        m_zero_copy = (registry != nullptr);
+        if (registry) {
+            registry->add(pinned_position);
+            m_registry = registry;
+            m_pinned_position = pinned_position;
+        }
+    }
+
+    // Staging for frames that wrap (not zero-copy).
+    S* staging(size_t count) {
+        release();
+        m_staging.resize(count);
+        return m_staging.data();
+    }
+
+    DLTensor m_tensor;
+    std::int64_t m_shape[3] = {0, 0, 0};
+    std::int64_t m_strides[3] = {0, 0, 0};
+    std::vector<S> m_staging;
+    size_t m_num_frames = 0;
+    bool m_zero_copy = false;
+    detail::PinRegistry* m_registry = nullptr;
+    std::uint64_t m_pinned_position = 0;
+};
+
+} // namespace JABuff
@@ -0,0 +1,502 @@
+#pragma once
+
+#include <vector>               // For std::vector
+#include <deque>                // For std::deque
+#include <stdexcept>            // For std::invalid_argument
+#include <cstddef>              // For size_t
+#include <cstdint>              // For std::uint8_t, std::uint64_t
+#include <cstring>              // For std::memcpy
+#include <string>               // For std::to_string
+#include <algorithm>            // For std::min, std::max
+#include <type_traits>          // For std::conditional, std::is_trivially_copyable
+#include <atomic>               // For std::atomic
+#include <chrono>               // For std::chrono::milliseconds
+#include <thread>               // For std::thread, std::this_thread::sleep_for
+#include <mutex>                // For std::mutex, std::unique_lock
+#include <condition_variable>   // For std::condition_variable
+
+#include "FramingRingBuffer2D.hpp"
+#include "WriteObserver.hpp"
+
+namespace JABuff {
+
+namespace detail {
+
+/**
+ * @brief Fast lossless codec for blocks of samples.
+ *
+ * Each sample's bit pattern is XORed with the previous one. Neighbouring audio
+ * samples share sign, exponent and the top of the mantissa, so the XOR has
+ * leading zero bytes; only its significant low bytes are stored, with a 4-bit
+ * byte count per sample. Silence and repeated values cost half a byte per sample.
+ */
+template <typename T>
+struct XorByteCodec {
+    static_assert(std::is_trivially_copyable<T>::value, "XorByteCodec needs a trivially copyable sample type.");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported sample size.");
+
+    using Bits = typename std::conditional<sizeof(T) == 1, std::uint8_t,
+                 typename std::conditional<sizeof(T) == 2, std::uint16_t,
+                 typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type>::type>::type;
+
+    // Appends the encoding of count samples to out.
+    static void encode(const T* data, size_t count, std::vector<std::uint8_t>& out) {
+        const size_t control_start = out.size();
+        out.resize(control_start + (count + 1) / 2, 0);
+
+        Bits prev = 0;
+        for (size_t i = 0; i < count; ++i) {
+            Bits bits;
+            std::memcpy(&bits, data + i, sizeof(T));
+            Bits x = bits ^ prev;
+            prev = bits;
+
+            std::uint8_t n = 0;
+            for (Bits v = x; v != 0; v = static_cast<Bits>(v >> 8)) ++n;
+            out[control_start + i / 2] |= static_cast<std::uint8_t>(n << ((i & 1) * 4));
+            for (std::uint8_t b = 0; b < n; ++b) {
+                out.push_back(static_cast<std::uint8_t>(x >> (8 * b)));
+            }
+        }
+    }
+
+    // Decodes count samples starting at in; returns the number of bytes consumed.
+    static size_t decode(const std::uint8_t* in, size_t count, T* data) {
+        const std::uint8_t* control = in;
+        const std::uint8_t* payload = in + (count + 1) / 2;
+
+        Bits prev = 0;
+        for (size_t i = 0; i < count; ++i) {
+            std::uint8_t n = static_cast<std::uint8_t>((control[i / 2] >> ((i & 1) * 4)) & 0x0F);
+            Bits x = 0;
+            for (std::uint8_t b = 0; b < n; ++b) {
+                x |= static_cast<Bits>(static_cast<Bits>(*payload++) << (8 * b));
+            }
+            prev ^= x;
+            std::memcpy(data + i, &prev, sizeof(T));
+        }
+        return static_cast<size_t>(payload - in);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Long retroactive history behind a FramingRingBuffer2D, compressed in the background.
+ *
+ * The buffer stays the hot tier: recent audio, read and framed exactly as before.
+ * TieredHistory attaches as a WriteObserver and gathers every written sample into
+ * hop-aligned blocks of block_size samples, in a pool of pool_blocks pre-allocated
+ * block slots shared with a background thread through a lock-free single-producer /
+ * single-consumer queue. The thread compresses each completed block losslessly
+ * (detail::XorByteCodec) into the cold tier, which keeps up to max_history_samples
+ * per channel, oldest dropped first.
+ *
+ * read(from, to) returns any range by absolute position (as in
+ * FramingRingBuffer2D::getWritePosition()). It is served straight from the ring when
+ * the ring still holds it (see setHistoryRetention()); older samples are decompressed
+ * on demand, a block at a time, with the last decoded block cached.
+ *
+ * Cost on the writer's thread: one copy of each written sample into the current
+ * pool slot and an atomic store per block; no locks, allocations or system calls,
+ * and clear() does not wait for the thread. If every slot is still waiting for
+ * compression when a block starts, that block is dropped (never blocked on) and
+ * counted in getDroppedBlocks(); the cold tier then has a gap there.
+ * read() must be called from the writer's thread (the ring itself is not thread-safe).
+ *
+ * @tparam T The sample type of the buffer.
+ */
+template <typename T>
+class TieredHistory : public WriteObserver<T> {
+public:
+    /**
+     * @brief Construct, attach to a buffer and start the compression thread.
+     *
+     * @param buffer The hot-tier buffer to follow. Must outlive this object.
+     * @param block_size Samples per channel in each cold block. Must be a multiple of the hop size.
+     * @param max_history_samples Samples per channel kept in the cold tier (rounded up to whole blocks).
+     * @param pool_blocks Block slots shared with the compression thread; size it for the longest stall you expect.
+     * @throws std::invalid_argument if block_size, max_history_samples or pool_blocks is 0, or block_size is not hop-aligned.
+     */
+    TieredHistory(FramingRingBuffer2D<T>& buffer, size_t block_size, size_t max_history_samples, size_t pool_blocks = 16);
+
+    ~TieredHistory() override;
+
+    TieredHistory(const TieredHistory&) = delete;
+    TieredHistory& operator=(const TieredHistory&) = delete;
+
+    void onWrite(const T* const* channels, size_t num_channels, size_t count) override;
+    void onClear() override;
+
+    /**
+     * @brief Copies the samples [from_sample, to_sample) of every channel by absolute position.
+     *
+     * @param buffer_out Output vector [channel][samples]. Resized automatically.
+     * @return true if the whole range is held by either tier, false otherwise (including dropped blocks).
+     * @throws std::invalid_argument if from_sample > to_sample.
+     */
+    bool read(std::uint64_t from_sample, std::uint64_t to_sample, std::vector<std::vector<T>>& buffer_out);
+
+    /**
+     * @brief Blocks until every completed block has been compressed. Not for the writer's hot path.
+     */
+    void flush();
+
+    /**
+     * @brief Returns the number of blocks dropped because every pool slot was busy.
+     */
+    size_t getDroppedBlocks() const;
+
+    /**
+     * @brief Returns the oldest absolute position read() can return.
+     */
+    std::uint64_t getOldestPosition() const;
+
+    /**
+     * @brief Returns the number of samples per channel in the cold tier.
+     */
+    size_t getColdSamples() const;
+
+    /**
+     * @brief Returns the compressed size of the cold tier in bytes.
+     */
+    size_t getColdBytes() const;
+
+    size_t getBlockSize() const;
+    size_t getMaxHistorySamples() const;
+    size_t getPoolBlocks() const;
+
+private:
+    struct ColdBlock {
+        std::uint64_t start;
+        std::vector<std::uint8_t> bytes; // Channels encoded back to back
+    };
+
+    void workerLoop();
+    bool drain();
+    void decodeBlock(const ColdBlock& block);
+    const ColdBlock* findColdBlock(std::uint64_t pos) const;
+    bool coldCurrent() const;
+    T* slotData(std::uint64_t sequence);
+
+    FramingRingBuffer2D<T>& m_buffer;
+    size_t m_num_channels;
+    size_t m_block_size;
+    size_t m_max_blocks;
+    size_t m_pool_blocks;
+
+    // Block pool: slot (sequence % pool_blocks). m_head is written only by the writer, m_tail only by the worker.
+    std::vector<T> m_pool;                  // [slot][channel][block_size]
+    std::vector<std::uint64_t> m_slot_start;
+    std::vector<std::uint64_t> m_slot_epoch;
+    std::atomic<std::uint64_t> m_head;      // Blocks published
+    std::atomic<std::uint64_t> m_tail;      // Blocks compressed (or discarded)
+    std::atomic<std::uint64_t> m_epoch;     // Incremented by every clear()
+    std::atomic<size_t> m_dropped;
+
+    // Writer's thread: the block being filled (in slot m_head, unless dropping)
+    size_t m_fill_count;
+    std::uint64_t m_fill_start;
+    bool m_fill_dropped;
+
+    // Shared between the worker and readers (m_mutex)
+    mutable std::mutex m_mutex;
+    std::condition_variable m_done_cv;
+    std::deque<ColdBlock> m_cold;           // Ascending start, gaps where blocks were dropped
+    std::uint64_t m_cold_epoch;             // Epoch the cold tier belongs to
+    size_t m_cold_bytes;
+    std::atomic<bool> m_stop;
+
+    // Decode cache (reader's thread, under m_mutex)
+    std::vector<T> m_decoded;
+    std::uint64_t m_decoded_start;
+    bool m_decoded_valid;
+
+    std::thread m_worker;
+};
+
+// ===================================================================
+// --- Implementation ---
+// ===================================================================
+
+template <typename T>
+TieredHistory<T>::TieredHistory(FramingRingBuffer2D<T>& buffer, size_t block_size, size_t max_history_samples, size_t pool_blocks)
+    : m_buffer(buffer),
+      m_num_channels(buffer.getNumChannels()),
+      m_block_size(block_size),
+      m_max_blocks(0),
+      m_pool_blocks(pool_blocks),
+      m_head(0),
+      m_tail(0),
+      m_epoch(0),
+      m_dropped(0),
+      m_fill_count(0),
+      m_fill_start(buffer.getWritePosition()),
+      m_fill_dropped(false),
+      m_cold_epoch(0),
+      m_cold_bytes(0),
+      m_stop(false),
+      m_decoded_start(0),
+      m_decoded_valid(false) {
+
+    if (block_size == 0 || max_history_samples == 0 || pool_blocks == 0) {
+        throw std::invalid_argument("Block size, history length and pool size must be non-zero.");
+    }
+    if (buffer.getHopDenominator() == 1 && block_size % buffer.getHopSizeFeatures() != 0) {
+        throw std::invalid_argument("Block size (" + std::to_string(block_size) + ") must be a multiple of the hop size (" +
+                                    std::to_string(buffer.getHopSizeFeatures()) + ").");
+    }
+
+    m_max_blocks = (max_history_samples + block_size - 1) / block_size;
+    m_pool.resize(m_pool_blocks * m_num_channels * m_block_size);
+    m_slot_start.resize(m_pool_blocks);
+    m_slot_epoch.resize(m_pool_blocks);
+    m_decoded.resize(m_num_channels * m_block_size);
+
+    m_worker = std::thread(&TieredHistory::workerLoop, this);
+    m_buffer.addObserver(this);
+}
+
+template <typename T>
+TieredHistory<T>::~TieredHistory() {
+    m_buffer.removeObserver(this);
+    m_stop.store(true, std::memory_order_release);
+    m_worker.join();
+}
+
+template <typename T>
+T* TieredHistory<T>::slotData(std::uint64_t sequence) {
+    return m_pool.data() + static_cast<size_t>(sequence % m_pool_blocks) * m_num_channels * m_block_size;
+}
+
+template <typename T>
+void TieredHistory<T>::onWrite(const T* const* channels, size_t num_channels, size_t count) {
+    size_t done = 0;
+    while (done < count) {
+        const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (m_fill_count == 0) {
+            // Claim the next slot, or drop this block if the worker still owns every slot.
+            m_fill_dropped = head - m_tail.load(std::memory_order_acquire) >= m_pool_blocks;
+            if (m_fill_dropped) m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        size_t n = std::min(count - done, m_block_size - m_fill_count);
+        if (!m_fill_dropped) {
+            T* slot = slotData(head);
+            for (size_t c = 0; c < num_channels; ++c) {
+                std::memcpy(slot + c * m_block_size + m_fill_count, channels[c] + done, n * sizeof(T));
+            }
+        }
+        m_fill_count += n;
+        done += n;
+
+        if (m_fill_count == m_block_size) {
+            if (!m_fill_dropped) {
+                const size_t index = static_cast<size_t>(head % m_pool_blocks);
+                m_slot_start[index] = m_fill_start;
+                m_slot_epoch[index] = m_epoch.load(std::memory_order_relaxed);
+                m_head.store(head + 1, std::memory_order_release);
+            }
+            m_fill_start += m_block_size;
+            m_fill_count = 0;
+        }
+    }
+}
+
+template <typename T>
+void TieredHistory<T>::onClear() {
+    // The worker discards blocks and cold data of older epochs; nothing here waits for it.
+    m_epoch.fetch_add(1, std::memory_order_release);
+    m_fill_count = 0;
+    m_fill_dropped = false;
+    m_fill_start = m_buffer.getWritePosition();
+}
+
+template <typename T>
+void TieredHistory<T>::workerLoop() {
+    while (!m_stop.load(std::memory_order_acquire)) {
+        if (!drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+template <typename T>
+bool TieredHistory<T>::drain() {
+    std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = m_head.load(std::memory_order_acquire);
+    const std::uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+
+    std::vector<std::uint8_t> bytes;
+    bool stale = false;
+    if (tail != head) {
+        const size_t index = static_cast<size_t>(tail % m_pool_blocks);
+        stale = m_slot_epoch[index] != epoch;
+        if (!stale) {
+            const T* data = slotData(tail);
+            for (size_t c = 0; c < m_num_channels; ++c) {
+                detail::XorByteCodec<T>::encode(data + c * m_block_size, m_block_size, bytes);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const bool cleared = m_cold_epoch != epoch;
+        if (cleared) {
+            m_cold.clear();
+            m_cold_bytes = 0;
+            m_decoded_valid = false;
+            m_cold_epoch = epoch;
+        }
+        if (tail == head) {
+            if (cleared) m_done_cv.notify_all();
+            return false;
+        }
+
+        if (!stale) {
+            m_cold_bytes += bytes.size();
+            m_cold.push_back(ColdBlock{m_slot_start[static_cast<size_t>(tail % m_pool_blocks)], std::move(bytes)});
+            while (m_cold.size() > m_max_blocks) {
+                m_cold_bytes -= m_cold.front().bytes.size();
+                if (m_decoded_valid && m_decoded_start == m_cold.front().start) m_decoded_valid = false;
+                m_cold.pop_front();
+            }
+        }
+        // Hand the slot back to the writer.
+        m_tail.store(tail + 1, std::memory_order_release);
+    }
+    m_done_cv.notify_all();
+    return true;
+}
+
+template <typename T>
+void TieredHistory<T>::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire) &&
+               m_cold_epoch == m_epoch.load(std::memory_order_acquire);
+    });
+}
+
+template <typename T>
+bool TieredHistory<T>::coldCurrent() const {
+    // Caller holds m_mutex. A clear() the worker has not seen yet empties the cold tier.
+    return m_cold_epoch == m_epoch.load(std::memory_order_acquire);
+}
+
+template <typename T>
+const typename TieredHistory<T>::ColdBlock* TieredHistory<T>::findColdBlock(std::uint64_t pos) const {
+    // Caller holds m_mutex. Blocks are ordered by start; dropped blocks leave gaps.
+    auto it = std::upper_bound(m_cold.begin(), m_cold.end(), pos,
+                               [](std::uint64_t p, const ColdBlock& block) { return p < block.start; });
+    if (it == m_cold.begin()) return nullptr;
+    --it;
+    return (pos < it->start + m_block_size) ? &*it : nullptr;
+}
+
+template <typename T>
+void TieredHistory<T>::decodeBlock(const ColdBlock& block) {
+    // Caller holds m_mutex.
+    if (m_decoded_valid && m_decoded_start == block.start) return;
+    const std::uint8_t* in = block.bytes.data();
+    for (size_t c = 0; c < m_num_channels; ++c) {
+        in += detail::XorByteCodec<T>::decode(in, m_block_size, m_decoded.data() + c * m_block_size);
+    }
+    m_decoded_start = block.start;
+    m_decoded_valid = true;
+}
+
+template <typename T>
+bool TieredHistory<T>::read(std::uint64_t from_sample, std::uint64_t to_sample, std::vector<std::vector<T>>& buffer_out) {
+    if (from_sample > to_sample) {
+        throw std::invalid_argument("History range start (" + std::to_string(from_sample) + ") is after its end (" +
+                                    std::to_string(to_sample) + ").");
+    }
+
+    // Hot tier first: no decompression, no waiting.
+    if (m_buffer.extractHistory(from_sample, to_sample, buffer_out)) {
+        return true;
+    }
+    if (to_sample > m_buffer.getWritePosition()) {
+        return false;
+    }
+
+    flush();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The block being filled lives in the writer's pool slot (read() runs on the writer's thread).
+    const T* fill = m_fill_dropped ? nullptr : slotData(m_head.load(std::memory_order_relaxed));
+
+    // Check the whole range is held before copying anything.
+    if (!coldCurrent()) return false;
+    for (std::uint64_t pos = from_sample; pos < to_sample;) {
+        if (pos >= m_fill_start) {
+            if (fill == nullptr) return false;
+            break;
+        }
+        const ColdBlock* block = findColdBlock(pos);
+        if (block == nullptr) return false;
+        pos = block->start + m_block_size;
+    }
+
+    const size_t count = static_cast<size_t>(to_sample - from_sample);
+    buffer_out.resize(m_num_channels);
+    for (auto& channel : buffer_out) channel.resize(count);
+
+    std::uint64_t pos = from_sample;
+    while (pos < to_sample) {
+        const T* src;
+        std::uint64_t block_start;
+        if (pos >= m_fill_start) {
+            src = fill;
+            block_start = m_fill_start;
+        } else {
+            decodeBlock(*findColdBlock(pos));
+            src = m_decoded.data();
+            block_start = m_decoded_start;
+        }
+
+        size_t offset = static_cast<size_t>(pos - block_start);
+        size_t n = static_cast<size_t>(std::min<std::uint64_t>(to_sample - pos, m_block_size - offset));
+        size_t out_pos = static_cast<size_t>(pos - from_sample);
+        for (size_t c = 0; c < m_num_channels; ++c) {
+            std::memcpy(buffer_out[c].data() + out_pos, src + c * m_block_size + offset, n * sizeof(T));
+        }
+        pos += n;
+    }
+    return true;
+}
+
+template <typename T>
+std::uint64_t TieredHistory<T>::getOldestPosition() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t oldest = (m_cold.empty() || !coldCurrent()) ? m_fill_start : m_cold.front().start;
+    return std::min(oldest, m_buffer.getOldestRetainedPosition());
+}
+
+template <typename T>
+size_t TieredHistory<T>::getColdSamples() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return coldCurrent() ? m_cold.size() * m_block_size : 0;
+}
+
+template <typename T>
+size_t TieredHistory<T>::getColdBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return coldCurrent() ? m_cold_bytes : 0;
+}
+
+template <typename T>
+size_t TieredHistory<T>::getBlockSize() const { return m_block_size; }
+
+template <typename T>
+size_t TieredHistory<T>::getMaxHistorySamples() const { return m_max_blocks * m_block_size; }
+
+template <typename T>
+size_t TieredHistory<T>::getPoolBlocks() const { return m_pool_blocks; }
+
+template <typename T>
+size_t TieredHistory<T>::getDroppedBlocks() const { return m_dropped.load(std::memory_order_relaxed); }
+
+} // namespace JABuff
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>      // For size_t
+
+namespace JABuff {
+
+/**
+ * @brief Interface for components that follow every block written to a buffer.
+ *
+ * Attach with the buffer's addObserver(). The buffer calls onWrite() once per
+ * accepted write (after the data is stored) with one pointer per channel to
+ * the samples that were written, in order. Observers run on the writer's
+ * thread, so keep them cheap.
+ *
+ * @tparam T The sample type of the buffer.
+ */
+template <typename T>
+class WriteObserver {
+public:
+    virtual ~WriteObserver() = default;
+
+    /**
+     * @brief Called for every block accepted by the buffer.
+     * @param channels One pointer per channel to the written samples.
+     * @param num_channels The number of channels.
+     * @param count The number of samples per channel.
+     */
+    virtual void onWrite(const T* const* channels, size_t num_channels, size_t count) = 0;
+
+    /**
+     * @brief Called when the buffer is cleared.
+     */
+    virtual void onClear() {}
+};
+
+} // namespace JABuff
@@ -1,6 +1,9 @@
 #include "JABuff/FramingRingBuffer2D.hpp"
 #include "test_utils.hpp"
 #include <numeric>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
 
 void TestBasicFlow() {
     print_header("TestBasicFlow");
@@ -236,6 +239,539 @@ void TestPrime() {
     }
 }
 
+void TestPeekAdvance() {
+    print_header("TestPeekAdvance");
+    // Capacity 12, Frame 8, Hop 4, Keep 1
+    JABuff::FramingRingBuffer2D<float> buffer(1, 12, 8, 4, 1, 1);
+    std::vector<std::vector<float>> input(1, std::vector<float>(12));
+    std::iota(input[0].begin(), input[0].end(), 0.0f);
+    buffer.write(input);
+
+    // Read 2 (keep 1) -> consumes one hop, read index 4
+    std::vector<std::vector<float>> out;
+    buffer.read(out, 2);
+
+    // Write 4 more so the data wraps: ring holds 4..15
+    std::vector<std::vector<float>> more(1, std::vector<float>(4));
+    std::iota(more[0].begin(), more[0].end(), 12.0f);
+    ASSERT(buffer.write(more), "Wrap write failed");
+
+    std::vector<JABuff::RingSpan<const float>> views;
+    ASSERT(buffer.peek(views, 2), "Peek failed");
+    ASSERT(views.size() == 1 && views[0].size() == 12, "Peek view size");
+    ASSERT(!views[0].isContiguous(), "View should wrap");
+    for (size_t i = 0; i < 12; ++i) {
+        ASSERT_NEAR(views[0][i], 4.0f + static_cast<float>(i), 0.001f, "Peek data mismatch");
+    }
+    ASSERT(buffer.getAvailableFeaturesRead() == 12, "Peek must not consume");
+
+    // advance(2) == read(2) consumption: 1 frame (keep 1)
+    ASSERT(buffer.advance(2), "Advance failed");
+    ASSERT(buffer.getAvailableFeaturesRead() == 8, "Advance consumption mismatch");
+    ASSERT(!buffer.advance(2), "Advance beyond available should fail");
+
+    ASSERT(buffer.read(out, 1), "Read after advance failed");
+    ASSERT_NEAR(out[0][0], 8.0f, 0.001f, "Read after advance data mismatch");
+}
+
+void TestRunningStats() {
+    print_header("TestRunningStats");
+    // Capacity 20, Frame 8, Hop 2 (75% overlap)
+    JABuff::FramingRingBuffer2D<float> buffer(2, 20, 8, 2);
+
+    std::vector<float> signal(100);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.9f * static_cast<float>(i)) * 3.0f + 1.0f;
+
+    // Some data before enabling must be included
+    std::vector<std::vector<float>> first(2, std::vector<float>(signal.begin(), signal.begin() + 5));
+    buffer.write(first);
+    buffer.enableRunningStats();
+    ASSERT(buffer.isRunningStatsEnabled(), "Stats should be enabled");
+
+    bool caught = false;
+    try {
+        buffer.getFrameEnergy(0, 0);
+    } catch (const std::out_of_range&) {
+        caught = true;
+    }
+    ASSERT(caught, "Query of unavailable frame did not throw");
+
+    size_t written = 5;
+    size_t consumed = 0;
+    std::vector<std::vector<float>> out;
+    while (written < signal.size()) {
+        size_t len = std::min<size_t>(std::min<size_t>(3, signal.size() - written), buffer.getAvailableWrite());
+        std::vector<std::vector<float>> block(2, std::vector<float>(signal.begin() + written, signal.begin() + written + len));
+        if (len > 0) {
+            buffer.push(std::vector<float>(2, signal[written]));
+            if (len > 1) buffer.write(block, 1, len - 1);
+        }
+        written += len;
+
+        // Check every available frame against a direct computation
+        for (size_t f = 0; f < buffer.getAvailableFramesRead(); ++f) {
+            double sum = 0.0, sum_sq = 0.0;
+            for (size_t i = 0; i < 8; ++i) {
+                double x = signal[consumed + f * 2 + i];
+                sum += x;
+                sum_sq += x * x;
+            }
+            double mean = sum / 8.0;
+            ASSERT_NEAR(buffer.getFrameSum(1, f), sum, 1e-9, "Frame sum mismatch");
+            ASSERT_NEAR(buffer.getFrameEnergy(0, f), sum_sq, 1e-9, "Frame energy mismatch");
+            ASSERT_NEAR(buffer.getFrameMean(0, f), mean, 1e-9, "Frame mean mismatch");
+            ASSERT_NEAR(buffer.getFrameVariance(0, f), sum_sq / 8.0 - mean * mean, 1e-9, "Frame variance mismatch");
+            ASSERT_NEAR(buffer.getFrameRms(0, f), std::sqrt(sum_sq / 8.0), 1e-9, "Frame RMS mismatch");
+        }
+
+        if (buffer.read(out, 2)) consumed += 4;
+    }
+
+    buffer.disableRunningStats();
+    caught = false;
+    try {
+        buffer.getFrameSum(0, 0);
+    } catch (const std::logic_error&) {
+        caught = true;
+    }
+    ASSERT(caught, "Query with stats disabled did not throw");
+}
+
+void TestEnergyGate() {
+    print_header("TestEnergyGate");
+    // Frame 4, Hop 4 (no overlap) to make frame boundaries obvious
+    for (int use_stats = 0; use_stats < 2; ++use_stats) {
+        JABuff::FramingRingBuffer2D<float> buffer(2, 64, 4, 4);
+        if (use_stats) buffer.enableRunningStats();
+        buffer.setEnergyGate(0.01, 1, 1);
+
+        // Frames: S S L S S S L (S = silent 0.001, L = loud 1.0 on channel 1 only)
+        const char* pattern = "SSLSSSL";
+        std::vector<std::vector<float>> input(2, std::vector<float>(28, 0.001f));
+        for (size_t f = 0; f < 7; ++f) {
+            if (pattern[f] == 'L') {
+                for (size_t i = 0; i < 4; ++i) input[1][f * 4 + i] = 1.0f;
+            }
+        }
+        buffer.write(input);
+
+        ASSERT_NEAR(buffer.getFramePower(2), (4 * 1.0 + 4 * 0.000001) / 8.0, 1e-6, "Frame power mismatch");
+
+        // Expected: S(gated) S(passes: lookahead sees L) L S(hangover) S(gated) S(lookahead) L
+        const bool expected_silent[] = {true, false, false, false, true, false, false};
+        std::vector<std::vector<float>> out;
+        for (size_t f = 0; f < 7; ++f) {
+            out.clear();
+            bool silent = false;
+            ASSERT(buffer.readGated(out, silent), "Gated read failed");
+            ASSERT(silent == expected_silent[f], "Gate decision mismatch at frame " << f);
+            if (silent) {
+                ASSERT(out.empty(), "Silent frame must not be copied");
+            } else {
+                ASSERT(out[1].size() == 4, "Passed frame size");
+                ASSERT_NEAR(out[1][0], pattern[f] == 'L' ? 1.0f : 0.001f, 1e-6f, "Passed frame data");
+            }
+        }
+
+        bool silent = false;
+        ASSERT(!buffer.readGated(out, silent), "No frame left to read");
+        ASSERT(buffer.isEmpty(), "All frames should be consumed");
+    }
+}
+
+void TestReadUnfolded() {
+    print_header("TestReadUnfolded");
+    // 2 channels, frame 5, hop 3: rows of 10 samples padded to 16.
+    JABuff::FramingRingBuffer2D<float> buffer(2, 12, 5, 3);
+    ASSERT(buffer.getUnfoldedRowStride(16) == 16, "Row stride");
+    ASSERT(buffer.getUnfoldedRowStride(1) == 10, "Unpadded row stride");
+
+    // Advance the indices so frames wrap around the end of the ring.
+    std::vector<std::vector<float>> data(2, std::vector<float>(9));
+    for (size_t i = 0; i < 9; ++i) { data[0][i] = -1.0f; data[1][i] = -1.0f; }
+    buffer.write(data);
+    std::vector<std::vector<float>> out;
+    buffer.read(out, 2);
+
+    float next = 0.0f;
+    std::vector<std::vector<float>> block(2, std::vector<float>(8));
+    for (size_t i = 0; i < 8; ++i) { block[0][i] = next; block[1][i] = 100.0f + next; next += 1.0f; }
+    ASSERT(buffer.write(block), "Write failed");
+    ASSERT(buffer.getAvailableFramesRead() == 3, "Frames available");
+
+    // Available: 3 leftover (-1) + 0..7; frame i starts at sample 3i.
+    auto expected = [](size_t ch, size_t s) { return s < 3 ? -1.0f : static_cast<float>(s - 3) + (ch == 1 ? 100.0f : 0.0f); };
+
+    std::vector<float> matrix;
+    size_t stride = 0;
+    ASSERT(buffer.readUnfolded(matrix, stride, 2), "Unfolded read failed");
+    ASSERT(stride == 16 && matrix.size() == 2 * 16, "Unfolded shape");
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t ch = 0; ch < 2; ++ch)
+            for (size_t k = 0; k < 5; ++k)
+                ASSERT_NEAR(matrix[i * stride + ch * 5 + k], expected(ch, 3 * i + k), 0.0f, "Unfolded value mismatch");
+        for (size_t k = 10; k < 16; ++k) ASSERT_NEAR(matrix[i * stride + k], 0.0f, 0.0f, "Padding should be zero");
+    }
+    ASSERT(buffer.getAvailableFeaturesRead() == 5, "Unfolded read consumption");
+
+    // Caller tensor form
+    std::vector<float> tensor(12, 7.0f);
+    ASSERT(buffer.readUnfolded(tensor.data(), 12, 1), "Caller-tensor read failed");
+    ASSERT_NEAR(tensor[5], expected(1, 6), 0.0f, "Caller tensor value");
+    ASSERT_NEAR(tensor[11], 0.0f, 0.0f, "Caller tensor padding");
+
+    bool thrown = false;
+    try { buffer.readUnfolded(tensor.data(), 9, 1); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Short row stride should throw");
+}
+
+void TestChannelSelection() {
+    print_header("TestChannelSelection");
+    JABuff::FramingRingBuffer2D<int> buffer(4, 8, 4, 2);
+    std::vector<std::vector<int>> data(4, std::vector<int>(6));
+    for (int c = 0; c < 4; ++c)
+        for (int i = 0; i < 6; ++i) data[c][i] = c * 100 + i;
+    buffer.write(data);
+
+    // Views in the requested order, including a repeat.
+    std::vector<size_t> selection = {3, 1, 3};
+    std::vector<JABuff::RingSpan<const int>> views;
+    ASSERT(buffer.peek(views, selection, 2), "Selected peek failed");
+    ASSERT(views.size() == 3 && views[0].size() == 6, "Selected peek shape");
+    ASSERT(views[0][5] == 305 && views[1][0] == 100 && views[2][2] == 302, "Selected peek values");
+
+    std::vector<std::vector<int>> out;
+    std::vector<size_t> reference = {2};
+    ASSERT(buffer.read(out, reference, 1), "Selected read failed");
+    ASSERT(out.size() == 1 && out[0].size() == 4, "Selected read shape");
+    ASSERT(out[0][0] == 200 && out[0][3] == 203, "Selected read values");
+    ASSERT(buffer.getAvailableFeaturesRead() == 4, "Selected read consumption");
+
+    // Wrap, then read a remapped pair.
+    std::vector<std::vector<int>> more(4, std::vector<int>(4));
+    for (int c = 0; c < 4; ++c)
+        for (int i = 0; i < 4; ++i) more[c][i] = c * 100 + 6 + i;
+    ASSERT(buffer.write(more), "Wrap write failed");
+    std::vector<size_t> pair = {1, 0};
+    ASSERT(buffer.read(out, pair, 0), "Selected read-all failed");
+    ASSERT(out.size() == 2 && out[0].size() == 8, "Remapped shape");
+    for (int i = 0; i < 8; ++i) {
+        ASSERT(out[0][i] == 100 + 2 + i && out[1][i] == 2 + i, "Remapped values across wrap");
+    }
+
+    bool thrown = false;
+    std::vector<size_t> bad = {0, 4};
+    try { buffer.peek(views, bad, 1); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Out-of-range channel should throw");
+}
+
+void TestReadMixed() {
+    print_header("TestReadMixed");
+    const size_t channels = 3;
+    JABuff::FramingRingBuffer2D<float> buffer(channels, 700, 600, 100);
+
+    // Move the read head so the 600-sample frame wraps, and spans several tiles.
+    std::vector<std::vector<float>> zeros(channels, std::vector<float>(600, 0.0f));
+    buffer.write(zeros);
+    std::vector<std::vector<float>> out;
+    ASSERT(buffer.read(out, 1), "Priming read failed"); // Read head -> 100
+
+    std::vector<std::vector<float>> data(channels, std::vector<float>(200));
+    for (size_t c = 0; c < channels; ++c)
+        for (size_t i = 0; i < 200; ++i) data[c][i] = static_cast<float>((i * (c + 3)) % 17) - 8.0f;
+    ASSERT(buffer.write(data), "Write failed");
+    ASSERT(buffer.advance(1), "Advance failed"); // Read head -> 200, frame covers 200..799
+
+    std::vector<std::vector<float>> matrix = {
+        {0.5f, 0.5f, 0.0f},   // Mono of the first two
+        {1.0f, -2.0f, 0.25f}, // Arbitrary beam
+    };
+    std::vector<JABuff::RingSpan<const float>> views;
+    ASSERT(buffer.peek(views, 1), "Peek failed");
+    ASSERT(!views[0].isContiguous(), "Frame should wrap");
+
+    ASSERT(buffer.readMixed(matrix, out, 1), "Mixed read failed");
+    ASSERT(out.size() == 2 && out[0].size() == 600, "Mixed shape");
+    for (size_t i = 0; i < 600; ++i) {
+        float x[3];
+        for (size_t c = 0; c < channels; ++c) x[c] = (i < 400) ? 0.0f : data[c][i - 400];
+        ASSERT_NEAR(out[0][i], 0.5f * x[0] + 0.5f * x[1], 1e-5f, "Downmix mismatch");
+        ASSERT_NEAR(out[1][i], x[0] - 2.0f * x[1] + 0.25f * x[2], 1e-5f, "Beam mismatch");
+    }
+    ASSERT(buffer.getAvailableFeaturesRead() == 500, "Mixed read consumption");
+
+    bool thrown = false;
+    std::vector<std::vector<float>> bad = {{1.0f, 1.0f}};
+    try { buffer.readMixed(bad, out, 1); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Matrix with wrong width should throw");
+}
+
+struct CountingObserver : public JABuff::WriteObserver<float> {
+    std::vector<float> seen;
+    void onWrite(const float* const* channels, size_t, size_t count) override {
+        seen.insert(seen.end(), channels[0], channels[0] + count);
+    }
+};
+
+void TestReserveCommit() {
+    print_header("TestReserveCommit");
+    JABuff::FramingRingBuffer2D<float> buffer(2, 8, 4, 4);
+    buffer.enableRunningStats();
+    CountingObserver observer;
+    buffer.addObserver(&observer);
+
+    std::vector<std::vector<float>> out;
+    std::vector<std::vector<float>> head(2, std::vector<float>(6, 1.0f));
+    buffer.write(head);
+    ASSERT(buffer.read(out, 1), "Read failed"); // Read head -> 4, write head at 6
+
+    // Reserve across the wrap and produce in place.
+    std::vector<JABuff::RingSpan<float>> spans;
+    ASSERT(!buffer.reserve(7, spans), "Reserve beyond free space should fail");
+    ASSERT(buffer.reserve(6, spans), "Reserve failed");
+    ASSERT(spans.size() == 2 && spans[0].first_size == 2 && spans[0].second_size == 4, "Reserved runs");
+    for (size_t c = 0; c < 2; ++c)
+        for (size_t i = 0; i < 6; ++i) spans[c][i] = static_cast<float>(10 * c + i);
+    ASSERT(buffer.getAvailableFeaturesRead() == 2, "Nothing visible before commit");
+
+    buffer.commit(5);
+    ASSERT(buffer.getAvailableFeaturesRead() == 7, "Committed count");
+    ASSERT(observer.seen.size() == 11 && observer.seen[6] == 0.0f && observer.seen[10] == 4.0f, "Observers see committed samples");
+    ASSERT_NEAR(buffer.getFrameSum(1, 0), 1.0 + 1.0 + 10.0 + 11.0, 1e-9, "Stats follow commit");
+
+    ASSERT(buffer.read(out, 0), "Read after commit failed");
+    ASSERT(out[1].size() == 4 && out[1][2] == 10.0f && out[1][3] == 11.0f, "Committed values");
+
+    bool thrown = false;
+    try { buffer.commit(100); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Over-commit should throw");
+
+    // Commits draw down the reservation; nothing past it may be published.
+    const size_t before = buffer.getAvailableFeaturesRead();
+    ASSERT(buffer.reserve(4, spans), "Second reserve failed");
+    buffer.commit(3);
+    thrown = false;
+    try { buffer.commit(2); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Commit beyond the remaining reservation should throw");
+    buffer.commit(1);
+    ASSERT(buffer.getAvailableFeaturesRead() == before + 4, "Reservation committed in pieces");
+
+    thrown = false;
+    buffer.clear();
+    ASSERT(buffer.reserve(2, spans), "Third reserve failed");
+    ASSERT(buffer.write(std::vector<std::vector<float>>(2, std::vector<float>(1, 0.0f))), "Write failed");
+    try { buffer.commit(1); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "write() discards the reservation");
+    buffer.removeObserver(&observer);
+}
+
+void TestFractionalHop() {
+    print_header("TestFractionalHop");
+    // 10 ms at 22.05 kHz: a 220.5-sample hop. Samples hold their absolute index.
+    const size_t frame = 512;
+    std::vector<std::vector<float>> block(1, std::vector<float>(300));
+    size_t written = 0;
+    auto feed = [&](JABuff::FramingRingBuffer2D<float>& buffer) {
+        for (size_t i = 0; i < 300; ++i) block[0][i] = static_cast<float>(written + i);
+        if (buffer.write(block)) written += 300;
+    };
+
+    JABuff::FramingRingBuffer2D<float> buffer(1, 2048, frame, 1);
+    buffer.setFractionalHop(441, 2);
+    ASSERT(buffer.getHopNumerator() == 441 && buffer.getHopDenominator() == 2, "Hop ratio");
+    ASSERT(buffer.getHopSizeFeatures() == 220, "Nominal hop rounds down");
+
+    std::vector<std::vector<float>> out;
+    size_t frames_read = 0;
+    while (frames_read < 200) {
+        feed(buffer);
+        // O(1) count matches a brute-force scan of frame starts.
+        size_t brute = 0;
+        while (buffer.getFrameOffset(brute) + frame <= buffer.getAvailableFeaturesRead()) ++brute;
+        ASSERT(buffer.getAvailableFramesRead() == brute, "Available frame count");
+
+        while (buffer.getAvailableFramesRead() >= 2) {
+            size_t second = buffer.getFrameOffset(1);
+            ASSERT(buffer.read(out, 2), "Read failed");
+            // Frame k starts at round(k * 220.5), half rounded up: no drift however long it runs.
+            size_t k = frames_read;
+            ASSERT(out[0][0] == static_cast<float>((2 * k * 441 / 2 + 1) / 2), "Frame start drifted");
+            ASSERT(out[0][second] == static_cast<float>((2 * (k + 1) * 441 / 2 + 1) / 2), "Second frame start");
+            ASSERT(out[0].size() == second + frame, "Block covers both frames");
+            frames_read += 2;
+        }
+    }
+
+    // Interpolated: frames start at the exact fractional position.
+    JABuff::FramingRingBuffer2D<float> interp(1, 2048, frame, 1);
+    interp.setFractionalHop(441, 2, true);
+    written = 0;
+    std::vector<float> matrix;
+    size_t stride = 0;
+    frames_read = 0;
+    while (frames_read < 50) {
+        feed(interp);
+        size_t brute = 0;
+        while (interp.getFrameOffset(brute) + frame + 1 <= interp.getAvailableFeaturesRead()) ++brute;
+        ASSERT(interp.getAvailableFramesRead() == brute, "Interpolated frame count");
+
+        while (interp.readUnfolded(matrix, stride, 1)) {
+            double start = static_cast<double>(frames_read) * 220.5;
+            ASSERT_NEAR(matrix[0], start, 1e-3, "Interpolated frame start");
+            ASSERT_NEAR(matrix[frame - 1], start + static_cast<double>(frame - 1), 1e-3, "Interpolated frame end");
+            ++frames_read;
+        }
+    }
+
+    bool thrown = false;
+    try { buffer.setFractionalHop(1, 2); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Sub-sample hop should throw");
+}
+
+void TestHistoryRetention() {
+    print_header("TestHistoryRetention");
+    // Capacity 64, frame 8 / hop 8, keep 32 consumed samples. Samples hold their absolute index.
+    JABuff::FramingRingBuffer2D<float> buffer(2, 64, 8, 8);
+    buffer.setHistoryRetention(32);
+    ASSERT(buffer.getHistoryRetention() == 32, "Retention getter");
+
+    std::vector<std::vector<float>> block(2, std::vector<float>(16));
+    std::vector<std::vector<float>> out;
+    std::uint64_t written = 0;
+    for (int round = 0; round < 20; ++round) {
+        for (size_t i = 0; i < 16; ++i) {
+            block[0][i] = static_cast<float>(written + i);
+            block[1][i] = -static_cast<float>(written + i);
+        }
+        ASSERT(buffer.write(block), "Write failed");
+        written += 16;
+        while (buffer.read(out, 1)) {}
+    }
+    ASSERT(buffer.getWritePosition() == written && buffer.getReadPosition() == written, "Absolute positions");
+    ASSERT(buffer.getOldestRetainedPosition() == written - 32, "Oldest retained");
+    ASSERT(buffer.getAvailableWrite() == 32, "Retention limits the write space");
+
+    // Look back before the read cursor, across the ring wrap.
+    std::vector<JABuff::RingSpan<const float>> views;
+    ASSERT(buffer.extractHistory(written - 32, written, views), "Extract retained history");
+    ASSERT(views.size() == 2 && views[0].size() == 32, "View size");
+    for (size_t i = 0; i < 32; ++i) {
+        ASSERT(views[0][i] == static_cast<float>(written - 32 + i), "History view data");
+        ASSERT(views[1][i] == -static_cast<float>(written - 32 + i), "History view data (ch 1)");
+    }
+    ASSERT(!buffer.extractHistory(written - 33, written, views), "Beyond retention is refused");
+    ASSERT(!buffer.extractHistory(written - 8, written + 1, views), "Unwritten samples are refused");
+
+    // Pre-roll plus what follows: history and unread samples in one copy.
+    for (size_t i = 0; i < 16; ++i) {
+        block[0][i] = static_cast<float>(written + i);
+        block[1][i] = -static_cast<float>(written + i);
+    }
+    ASSERT(buffer.write(block), "Write failed");
+    ASSERT(buffer.extractHistory(written - 16, written + 16, out), "Extract history + unread");
+    ASSERT(out[0].size() == 32, "Copy size");
+    for (size_t i = 0; i < 32; ++i) {
+        ASSERT(out[0][i] == static_cast<float>(written - 16 + i), "History copy data");
+    }
+
+    bool thrown = false;
+    try { buffer.extractHistory(written, written - 1, views); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Reversed range should throw");
+    thrown = false;
+    try { buffer.setHistoryRetention(60); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Retention + frame beyond capacity should throw");
+}
+
+void TestSaveLoadState() {
+    print_header("TestSaveLoadState");
+    // Fractional hop, history retention and a wrapped write head all have to survive the round trip.
+    JABuff::FramingRingBuffer2D<float> source(2, 64, 16, 8);
+    source.setFractionalHop(15, 2);
+    source.setHistoryRetention(8);
+
+    std::vector<std::vector<float>> block(2, std::vector<float>(40));
+    for (size_t i = 0; i < 40; ++i) { block[0][i] = static_cast<float>(i); block[1][i] = -static_cast<float>(i); }
+    ASSERT(source.write(block), "Write 1 failed");
+    std::vector<std::vector<float>> out_a, out_b;
+    ASSERT(source.read(out_a, 3), "Read failed");
+    block.assign(2, std::vector<float>(30));
+    for (size_t i = 0; i < 30; ++i) { block[0][i] = static_cast<float>(40 + i); block[1][i] = -static_cast<float>(40 + i); }
+    ASSERT(source.write(block), "Write 2 failed");
+
+    std::vector<std::uint8_t> bytes;
+    source.saveState(bytes);
+
+    JABuff::FramingRingBuffer2D<float> restored(2, 64, 16, 8);
+    ASSERT(restored.loadState(bytes.data(), bytes.size()) == bytes.size(), "Whole snapshot consumed");
+    ASSERT(restored.getReadPosition() == source.getReadPosition() && restored.getWritePosition() == source.getWritePosition(), "Cursors");
+    ASSERT(restored.getHopNumerator() == 15 && restored.getHopDenominator() == 2 && restored.getHistoryRetention() == 8, "Settings");
+    ASSERT(restored.ready() && restored.getAvailableFramesRead() == source.getAvailableFramesRead(), "Readable without priming");
+
+    std::vector<std::vector<float>> hist_a, hist_b;
+    std::uint64_t oldest = source.getOldestRetainedPosition();
+    ASSERT(restored.extractHistory(oldest, source.getWritePosition(), hist_b), "History restored");
+    ASSERT(source.extractHistory(oldest, source.getWritePosition(), hist_a) && hist_a == hist_b, "History matches");
+
+    ASSERT(source.read(out_a, 0) && restored.read(out_b, 0), "Read all failed");
+    ASSERT(out_a == out_b, "Restored frames must match the original");
+
+    // Gather form: two sessions in one stream, restored back to back.
+    JABuff::FramingRingBuffer2D<float> other(2, 64, 16, 8);
+    ASSERT(other.write(std::vector<std::vector<float>>(2, std::vector<float>(20, 7.0f))), "Write failed");
+    std::vector<JABuff::StateSegment> segments;
+    source.saveState(segments);
+    other.saveState(segments);
+    std::vector<std::uint8_t> stream;
+    JABuff::appendState(segments, stream);
+    ASSERT(stream.size() == JABuff::getStateSize(segments), "Gathered size");
+#if defined(JABUFF_HAS_WRITEV)
+    const char* path = "jabuff_test_state.bin";
+    std::FILE* f = std::fopen(path, "wb");
+    ASSERT(f != nullptr && JABuff::writeState(fileno(f), segments), "writeState failed");
+    std::fclose(f);
+    std::vector<std::uint8_t> file_bytes(stream.size() + 1);
+    f = std::fopen(path, "rb");
+    ASSERT(std::fread(file_bytes.data(), 1, file_bytes.size(), f) == stream.size(), "File size");
+    std::fclose(f);
+    std::remove(path);
+    file_bytes.resize(stream.size());
+    ASSERT(file_bytes == stream, "writeState output matches appendState");
+#endif
+    size_t used = restored.loadState(stream.data(), stream.size());
+    JABuff::FramingRingBuffer2D<float> other_restored(2, 64, 16, 8);
+    ASSERT(other_restored.loadState(stream.data() + used, stream.size() - used) == stream.size() - used, "Second session");
+    ASSERT(other_restored.read(out_b, 1) && out_b[1][15] == 7.0f, "Second session data");
+
+    bool thrown = false;
+    try { JABuff::FramingRingBuffer2D<float> wrong(2, 128, 16, 8); wrong.loadState(bytes.data(), bytes.size()); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Geometry mismatch should throw");
+
+    thrown = false;
+    try { JABuff::FramingRingBuffer2D<std::int32_t> ints(2, 64, 16, 8); ints.loadState(bytes.data(), bytes.size()); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Sample type mismatch (float into int32) should throw");
+
+    thrown = false;
+    try { restored.loadState(bytes.data(), bytes.size() - 1); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Truncated snapshot should throw");
+
+    // Hop fields (after the 32-byte preamble and five geometry fields): a hop under one
+    // sample, or a fraction not in lowest terms, is refused.
+    const std::uint64_t bad_hops[][2] = {{1, 2}, {30, 4}};
+    for (const auto& hop : bad_hops) {
+        std::vector<std::uint8_t> corrupt = bytes;
+        std::memcpy(corrupt.data() + 32 + 5 * 8, &hop[0], 8);
+        std::memcpy(corrupt.data() + 32 + 6 * 8, &hop[1], 8);
+        thrown = false;
+        try { restored.loadState(corrupt.data(), corrupt.size()); } catch (const std::runtime_error&) { thrown = true; }
+        ASSERT(thrown, "Inconsistent hop fraction should throw");
+    }
+
+    thrown = false;
+    bytes[0] = 'X';
+    try { restored.loadState(bytes.data(), bytes.size()); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Bad magic should throw");
+}
+
 int main() {
     TestBasicFlow();
     TestWrapAround();
@@ -245,6 +781,16 @@ int main() {
     TestPush();
     TestReady();
     TestPrime();
+    TestPeekAdvance();
+    TestRunningStats();
+    TestEnergyGate();
+    TestReadUnfolded();
+    TestChannelSelection();
+    TestReadMixed();
+    TestReserveCommit();
+    TestFractionalHop();
+    TestHistoryRetention();
+    TestSaveLoadState();
     print_pass();
     return 0;
 }
@@ -1,6 +1,9 @@
 #include "JABuff/FramingRingBuffer3D.hpp"
 #include "test_utils.hpp"
 #include <numeric>
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 void TestBasic3D() {
     print_header("TestBasic3D");
@@ -159,12 +162,395 @@ void TestPrime3D() {
     }
 }
 
+void TestHalfStorage3D() {
+    print_header("TestHalfStorage3D");
+    size_t feature_dim = 19; // Not a multiple of the SIMD width (exercises the scalar tail)
+
+    JABuff::FramingRingBuffer3D<float> full(2, feature_dim, 20, 4, 2);
+    JABuff::FramingRingBuffer3D<float, JABuff::Float16> fp16(2, feature_dim, 20, 4, 2);
+    JABuff::FramingRingBuffer3D<float, JABuff::BFloat16> bf16(2, feature_dim, 20, 4, 2);
+
+    ASSERT(fp16.getStorageBytes() * 2 == full.getStorageBytes(), "fp16 storage should be half of float");
+    ASSERT(bf16.getStorageBytes() * 2 == full.getStorageBytes(), "bf16 storage should be half of float");
+
+    std::vector<std::vector<std::vector<float>>> input(
+        2, std::vector<std::vector<float>>(16, std::vector<float>(feature_dim))
+    );
+    for (size_t c = 0; c < 2; ++c) {
+        for (size_t t = 0; t < 16; ++t) {
+            for (size_t f = 0; f < feature_dim; ++f) {
+                input[c][t][f] = static_cast<float>(t) * 0.37f - static_cast<float>(f) * 1.5f + static_cast<float>(c);
+            }
+        }
+    }
+
+    // Wrap the ring: write 16, consume 12, write 16 again.
+    std::vector<std::vector<std::vector<float>>> out16, outbf;
+    for (int pass = 0; pass < 2; ++pass) {
+        ASSERT(fp16.write(input), "fp16 write failed");
+        ASSERT(bf16.write(input), "bf16 write failed");
+        if (pass == 0) {
+            fp16.read(out16, 6);
+            bf16.read(outbf, 6);
+        }
+    }
+
+    ASSERT(fp16.read(out16, 3), "fp16 read failed");
+    ASSERT(bf16.read(outbf, 3), "bf16 read failed");
+    ASSERT(out16[0].size() == 8 && out16[0][0].size() == feature_dim, "fp16 output shape");
+
+    // Next unread step after 12 consumed from the first pass is input step 12.
+    for (size_t c = 0; c < 2; ++c) {
+        for (size_t t = 0; t < 8; ++t) {
+            const std::vector<float>& expected = input[c][(12 + t) % 16];
+            for (size_t f = 0; f < feature_dim; ++f) {
+                float tol16 = std::abs(expected[f]) * (1.0f / 1024.0f) + 1e-6f;
+                float tolbf = std::abs(expected[f]) * (1.0f / 128.0f) + 1e-6f;
+                ASSERT_NEAR(out16[c][t][f], expected[f], tol16, "fp16 round-trip mismatch");
+                ASSERT_NEAR(outbf[c][t][f], expected[f], tolbf, "bf16 round-trip mismatch");
+            }
+        }
+    }
+
+    // Exact values and special cases
+    JABuff::Float16 h;
+    h.bits = JABuff::detail::floatToHalfBits(65504.0f);
+    ASSERT(h.bits == 0x7BFF, "fp16 max encoding");
+    ASSERT(JABuff::detail::floatToHalfBits(1e6f) == 0x7C00, "fp16 overflow should be Inf");
+    ASSERT(JABuff::detail::floatToHalfBits(5.9604645e-8f) == 0x0001, "fp16 smallest subnormal");
+    ASSERT_NEAR(JABuff::detail::halfBitsToFloat(0x3C00), 1.0f, 0.0f, "fp16 one");
+    ASSERT(JABuff::detail::floatToBFloat16Bits(1.0f) == 0x3F80, "bf16 one");
+    ASSERT(std::isnan(JABuff::detail::bfloat16BitsToFloat(JABuff::detail::floatToBFloat16Bits(std::nanf("")))), "bf16 NaN");
+}
+
+void TestQuantizedStorage3D() {
+    print_header("TestQuantizedStorage3D");
+    size_t feature_dim = 8;
+    JABuff::FramingRingBuffer3D<float, JABuff::QInt8> buffer(1, feature_dim, 6, 4, 2);
+
+    std::vector<std::vector<float>> step(1, std::vector<float>(feature_dim));
+    for (int t = 0; t < 6; ++t) {
+        for (size_t f = 0; f < feature_dim; ++f) {
+            step[0][f] = (static_cast<float>(f) - 3.0f) * static_cast<float>(t + 1);
+        }
+        ASSERT(buffer.push(step), "Push failed");
+    }
+
+    // Dequantised read: error bounded by half a quantisation step of each row.
+    std::vector<std::vector<std::vector<float>>> out;
+    ASSERT(buffer.read(out, 1), "Read failed");
+    for (int t = 0; t < 4; ++t) {
+        float range = 7.0f * static_cast<float>(t + 1);
+        for (size_t f = 0; f < feature_dim; ++f) {
+            float expected = (static_cast<float>(f) - 3.0f) * static_cast<float>(t + 1);
+            ASSERT_NEAR(out[0][t][f], expected, range / 255.0f * 0.5f + 1e-5f, "Dequantised value mismatch");
+        }
+    }
+
+    // Wrap the ring, then read raw int8 data + scales.
+    for (int t = 6; t < 8; ++t) {
+        for (size_t f = 0; f < feature_dim; ++f) {
+            step[0][f] = (static_cast<float>(f) - 3.0f) * static_cast<float>(t + 1);
+        }
+        ASSERT(buffer.push(step), "Push (wrap) failed");
+    }
+
+    std::vector<std::vector<std::int8_t>> q;
+    std::vector<std::vector<JABuff::QuantParams>> params;
+    ASSERT(buffer.readQuantized(q, params, 1), "Raw read failed");
+    ASSERT(q[0].size() == 4 * feature_dim, "Raw data size");
+    ASSERT(params[0].size() == 4, "Raw params size");
+
+    // Read started at time step 2 (one hop consumed): steps 2..5 at indices 2..5, one run.
+    for (size_t t = 0; t < 4; ++t) {
+        float scale = params[0][t].scale;
+        int zp = params[0][t].zero_point;
+        ASSERT_NEAR(static_cast<float>(q[0][t * feature_dim + 3] - zp) * scale, 0.0f, 1e-6f, "Zero should be exact");
+        float expected_first = -3.0f * static_cast<float>(t + 3);
+        ASSERT_NEAR(static_cast<float>(q[0][t * feature_dim] - zp) * scale, expected_first, scale * 0.5f + 1e-5f, "Raw value mismatch");
+    }
+    ASSERT(buffer.getAvailableTimeRead() == 4, "Consumption after raw read");
+
+    // Read index 4 > capacity - frame: steps 4..7 sit at indices 4, 5, 0, 1 (two runs).
+    ASSERT(buffer.readQuantized(q, params, 1), "Wrapped raw read failed");
+    ASSERT(q[0].size() == 4 * feature_dim && params[0].size() == 4, "Wrapped raw sizes");
+    for (size_t t = 0; t < 4; ++t) {
+        const float step_scale = static_cast<float>(t + 5);
+        ASSERT_NEAR(params[0][t].scale, 7.0f * step_scale / 255.0f, 1e-6f, "Wrapped scale follows its step");
+        for (size_t f = 0; f < feature_dim; ++f) {
+            float expected = (static_cast<float>(f) - 3.0f) * step_scale;
+            float decoded = static_cast<float>(q[0][t * feature_dim + f] - params[0][t].zero_point) * params[0][t].scale;
+            ASSERT_NEAR(decoded, expected, params[0][t].scale * 0.5f + 1e-5f, "Wrapped raw value mismatch");
+        }
+    }
+    ASSERT(buffer.getAvailableTimeRead() == 2, "Consumption after wrapped raw read");
+}
+
+void TestCMVN3D() {
+    print_header("TestCMVN3D");
+    const size_t channels = 2, feature_dim = 3, capacity = 8, window = 5;
+    JABuff::FramingRingBuffer3D<double> buffer(channels, feature_dim, capacity, 2, 2);
+
+    auto value = [](size_t c, int t, size_t f) {
+        return std::sin(0.7 * t + static_cast<double>(f)) * (f + 1.0) + static_cast<double>(c) * 10.0 + 0.1 * t;
+    };
+
+    // Window covers the most recent 'window' written steps, counting across wraps.
+    auto check_stats = [&](int written) {
+        for (size_t c = 0; c < channels; ++c) {
+            std::vector<double> mean, sd;
+            buffer.getCMVNStats(c, mean, sd);
+            int first = std::max(0, written - static_cast<int>(window));
+            for (size_t f = 0; f < feature_dim; ++f) {
+                double s = 0.0, s2 = 0.0;
+                for (int t = first; t < written; ++t) s += value(c, t, f);
+                double n = written - first;
+                double m = s / n;
+                for (int t = first; t < written; ++t) s2 += (value(c, t, f) - m) * (value(c, t, f) - m);
+                ASSERT_NEAR(mean[f], m, 1e-9, "CMVN mean mismatch");
+                ASSERT_NEAR(sd[f], std::sqrt(s2 / n), 1e-9, "CMVN std mismatch");
+            }
+        }
+    };
+
+    // Two steps already in the ring are picked up by enableCMVN().
+    int written = 0;
+    std::vector<std::vector<std::vector<double>>> block(channels, std::vector<std::vector<double>>(2, std::vector<double>(feature_dim)));
+    for (size_t c = 0; c < channels; ++c)
+        for (int t = 0; t < 2; ++t)
+            for (size_t f = 0; f < feature_dim; ++f) block[c][t][f] = value(c, t, f);
+    ASSERT(buffer.write(block), "Write failed");
+    written = 2;
+
+    bool thrown = false;
+    try { buffer.enableCMVN(capacity + 1); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Window larger than capacity should throw");
+
+    buffer.enableCMVN(window, 0.0);
+    check_stats(written);
+
+    std::vector<std::vector<double>> step(channels, std::vector<double>(feature_dim));
+    std::vector<std::vector<std::vector<double>>> out;
+    for (int round = 0; round < 12; ++round) {
+        for (size_t c = 0; c < channels; ++c)
+            for (size_t f = 0; f < feature_dim; ++f) step[c][f] = value(c, written, f);
+        ASSERT(buffer.push(step), "Push failed");
+        ++written;
+        check_stats(written);
+
+        if (buffer.getAvailableFramesRead() > 0) {
+            // Snapshot the stats, then check the normalised read against them.
+            std::vector<std::vector<double>> mean(channels), sd(channels);
+            for (size_t c = 0; c < channels; ++c) buffer.getCMVNStats(c, mean[c], sd[c]);
+            int start = written - static_cast<int>(buffer.getAvailableTimeRead());
+            ASSERT(buffer.readNormalized(out, 1), "Normalised read failed");
+            for (size_t c = 0; c < channels; ++c)
+                for (int t = 0; t < 2; ++t)
+                    for (size_t f = 0; f < feature_dim; ++f)
+                        ASSERT_NEAR(out[c][t][f], (value(c, start + t, f) - mean[c][f]) / sd[c][f], 1e-9, "Normalised value mismatch");
+        }
+    }
+
+    // Mean-only normalisation
+    while (buffer.getAvailableFramesRead() == 0) {
+        for (size_t c = 0; c < channels; ++c)
+            for (size_t f = 0; f < feature_dim; ++f) step[c][f] = value(c, written, f);
+        ASSERT(buffer.push(step), "Push failed");
+        ++written;
+    }
+    std::vector<double> mean0, sd0;
+    buffer.getCMVNStats(0, mean0, sd0);
+    int start0 = written - static_cast<int>(buffer.getAvailableTimeRead());
+    ASSERT(buffer.readNormalized(out, 1, false), "Mean-only read failed");
+    ASSERT_NEAR(out[0][1][0], value(0, start0 + 1, 0) - mean0[0], 1e-9, "Mean-only mismatch");
+
+    // Clear resets the statistics window.
+    buffer.clear();
+    ASSERT(buffer.push(step), "Push after clear failed");
+    std::vector<double> mean, sd;
+    buffer.getCMVNStats(1, mean, sd);
+    ASSERT_NEAR(mean[2], step[1][2], 1e-12, "Mean after clear");
+    // A single step has no spread; allow sqrt(rounding error) relative to the feature's magnitude.
+    ASSERT_NEAR(sd[2], 0.0, std::sqrt(std::numeric_limits<double>::epsilon()) * std::abs(step[1][2]), "Std after clear");
+
+    buffer.disableCMVN();
+    thrown = false;
+    try { buffer.readNormalized(out, 1); } catch (const std::logic_error&) { thrown = true; }
+    ASSERT(thrown, "readNormalized without CMVN should throw");
+}
+
+void TestSplicedAndDeltas3D() {
+    print_header("TestSplicedAndDeltas3D");
+    const size_t feature_dim = 3;
+    const int length = 10;
+    auto value = [](int t, size_t f) { return static_cast<double>(t * t) * 0.5 + static_cast<double>(f) * 3.0 - static_cast<double>(t * f); };
+    auto clamped = [&](int t, size_t f) { return value(std::max(0, std::min(length - 1, t)), f); };
+
+    auto fill = [&](JABuff::FramingRingBuffer3D<double>& buffer) {
+        std::vector<std::vector<std::vector<double>>> block(1, std::vector<std::vector<double>>(length, std::vector<double>(feature_dim)));
+        for (int t = 0; t < length; ++t)
+            for (size_t f = 0; f < feature_dim; ++f) block[0][t][f] = value(t, f);
+        ASSERT(buffer.write(block), "Write failed");
+    };
+
+    // Splicing: left context comes from retained history, right context stops at the
+    // union edge; keep_frames = 1 re-reads the last frame so its rows get full context.
+    JABuff::FramingRingBuffer3D<double> spliced(1, feature_dim, 16, 2, 2, 1, 1);
+    spliced.setHistoryRetention(2);
+    fill(spliced);
+    std::vector<std::vector<std::vector<double>>> out;
+    for (int start = 0; start <= 2; start += 2) {
+        ASSERT(spliced.readSpliced(out, 2, 1, 2), "Spliced read failed");
+        ASSERT(out[0].size() == 4 && out[0][0].size() == 4 * feature_dim, "Spliced shape");
+        for (int t = 0; t < 2; ++t)
+            for (int j = -2; j <= 1; ++j)
+                for (size_t f = 0; f < feature_dim; ++f)
+                    ASSERT_NEAR(out[0][t][(j + 2) * feature_dim + f], clamped(start + t + j, f), 1e-12, "Spliced value mismatch");
+        ASSERT_NEAR(out[0][3][3 * feature_dim], value(start + 3, 0), 1e-12, "Right context replicates the union edge");
+    }
+    ASSERT(spliced.getAvailableTimeRead() == 6, "Spliced read consumption");
+
+    // Right edge replicates the newest written step.
+    ASSERT(spliced.readSpliced(out, 0, 3, 0), "Spliced read-all failed");
+    ASSERT_NEAR(out[0][5][3 * feature_dim], value(length - 1, 0), 1e-12, "Right edge replication");
+
+    // Deltas against an offline reference over the whole (edge-clamped) sequence.
+    auto delta = [&](auto&& x, int t, size_t f) {
+        double acc = 0.0;
+        for (int n = 1; n <= 2; ++n) acc += n * (x(std::min(length - 1, t + n), f) - x(std::max(0, t - n), f));
+        return acc / 10.0;
+    };
+    auto d = [&](int t, size_t f) { return delta(clamped, t, f); };
+
+    // Order 2, N = 2 reaches 4 steps each way: retain 4 steps, keep 2 frames of look-ahead.
+    JABuff::FramingRingBuffer3D<double> deltas(1, feature_dim, 16, 2, 2, 1, 2);
+    deltas.setHistoryRetention(4);
+    fill(deltas);
+    for (int start = 0; start <= 4; start += 2) {
+        ASSERT(deltas.readWithDeltas(out, 2, 2, 3), "Delta read failed");
+        ASSERT(out[0][0].size() == 3 * feature_dim, "Delta shape");
+        for (int t = 0; t < 2; ++t) {
+            for (size_t f = 0; f < feature_dim; ++f) {
+                ASSERT_NEAR(out[0][t][f], value(start + t, f), 1e-12, "Static part mismatch");
+                ASSERT_NEAR(out[0][t][feature_dim + f], d(start + t, f), 1e-9, "Delta mismatch");
+                ASSERT_NEAR(out[0][t][2 * feature_dim + f], delta(d, start + t, f), 1e-9, "Delta-delta mismatch");
+            }
+        }
+    }
+
+    bool thrown = false;
+    try { deltas.readWithDeltas(out, 3); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Delta order 3 should throw");
+}
+
+void TestContextChunking3D() {
+    print_header("TestContextChunking3D");
+    // The same stream written in different chunk sizes must give identical context reads.
+    const size_t feature_dim = 2;
+    const size_t length = 40;
+    std::vector<std::vector<std::vector<double>>> stream(1, std::vector<std::vector<double>>(length, std::vector<double>(feature_dim)));
+    for (size_t t = 0; t < length; ++t)
+        for (size_t f = 0; f < feature_dim; ++f) stream[0][t][f] = std::sin(0.3 * static_cast<double>(t)) + static_cast<double>(f);
+
+    auto run = [&](size_t chunk, bool with_deltas) {
+        JABuff::FramingRingBuffer3D<double> buffer(1, feature_dim, 12, 2, 2, 3, 2);
+        buffer.setHistoryRetention(2);
+        std::vector<std::vector<double>> rows;
+        std::vector<std::vector<std::vector<double>>> out;
+        size_t pos = 0;
+        while (true) {
+            while (with_deltas ? buffer.readWithDeltas(out, 2, 1, 3) : buffer.readSpliced(out, 2, 2, 3)) {
+                rows.insert(rows.end(), out[0].begin(), out[0].end());
+            }
+            if (pos == length) break;
+            size_t n = std::min({chunk, length - pos, buffer.getAvailableWrite()});
+            ASSERT(n > 0 && buffer.write(stream, pos, n), "Chunked write failed");
+            pos += n;
+        }
+        return rows;
+    };
+
+    for (bool with_deltas : {false, true}) {
+        std::vector<std::vector<double>> single = run(1, with_deltas);
+        std::vector<std::vector<double>> bulk = run(7, with_deltas);
+        ASSERT(!single.empty(), "Chunked reads produced output");
+        ASSERT(single == bulk, "Context reads depend on write chunking");
+    }
+
+    bool thrown = false;
+    try { JABuff::FramingRingBuffer3D<double> small(1, feature_dim, 12, 2, 2); small.setHistoryRetention(11); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Retention plus frame size beyond capacity should throw");
+}
+
+void TestSaveLoadState3D() {
+    print_header("TestSaveLoadState3D");
+    // QInt8 storage: the per-step parameters travel with the codes, so decoding is bit-identical.
+    const size_t feature_dim = 3;
+    JABuff::FramingRingBuffer3D<float, JABuff::QInt8> source(2, feature_dim, 12, 4, 2);
+    source.enableCMVN(6);
+    std::vector<std::vector<std::vector<float>>> block(2, std::vector<std::vector<float>>(10, std::vector<float>(feature_dim)));
+    for (size_t t = 0; t < 10; ++t) {
+        for (size_t f = 0; f < feature_dim; ++f) {
+            block[0][t][f] = static_cast<float>(t) * 0.5f - static_cast<float>(f);
+            block[1][t][f] = static_cast<float>(t * f) * 0.25f;
+        }
+    }
+    std::vector<std::vector<std::vector<float>>> out_a, out_b;
+    ASSERT(source.write(block), "Write 1 failed");
+    ASSERT(source.read(out_a, 3), "Read failed");
+    ASSERT(source.write(block, 0, 8), "Write 2 failed (wraps)");
+
+    std::vector<std::uint8_t> bytes;
+    source.saveState(bytes);
+    JABuff::FramingRingBuffer3D<float, JABuff::QInt8> restored(2, feature_dim, 12, 4, 2);
+    restored.enableCMVN(6);
+    ASSERT(restored.loadState(bytes.data(), bytes.size()) == bytes.size(), "Whole snapshot consumed");
+    ASSERT(restored.getAvailableTimeRead() == source.getAvailableTimeRead() && restored.ready(), "Cursors");
+
+    std::vector<float> mean_a, std_a, mean_b, std_b;
+    source.getCMVNStats(1, mean_a, std_a);
+    restored.getCMVNStats(1, mean_b, std_b);
+    for (size_t f = 0; f < feature_dim; ++f) {
+        ASSERT_NEAR(mean_a[f], mean_b[f], 1e-6f, "CMVN mean restored");
+        ASSERT_NEAR(std_a[f], std_b[f], 1e-6f, "CMVN std restored");
+    }
+
+    ASSERT(source.readSpliced(out_a, 2, 1, 0) && restored.readSpliced(out_b, 2, 1, 0), "Read all failed");
+    ASSERT(out_a == out_b, "Restored frames (with left context) must match the original");
+
+    bool thrown = false;
+    try { JABuff::FramingRingBuffer3D<float, JABuff::QInt8> wrong(2, feature_dim, 12, 4, 3); wrong.loadState(bytes.data(), bytes.size()); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Hop mismatch should throw");
+
+    thrown = false;
+    try { JABuff::FramingRingBuffer3D<float> plain(2, feature_dim, 12, 4, 2); plain.loadState(bytes.data(), bytes.size()); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Storage type mismatch should throw");
+
+    // Float16 and BFloat16 have the same size; the snapshot must still tell them apart.
+    JABuff::FramingRingBuffer3D<float, JABuff::Float16> half(1, feature_dim, 8, 2, 1);
+    ASSERT(half.write(std::vector<std::vector<std::vector<float>>>(1, std::vector<std::vector<float>>(4, std::vector<float>(feature_dim, 1.5f)))), "Half write failed");
+    std::vector<std::uint8_t> half_bytes;
+    half.saveState(half_bytes);
+    thrown = false;
+    try { JABuff::FramingRingBuffer3D<float, JABuff::BFloat16> brain(1, feature_dim, 8, 2, 1); brain.loadState(half_bytes.data(), half_bytes.size()); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Float16 snapshot into BFloat16 storage should throw");
+    JABuff::FramingRingBuffer3D<float, JABuff::Float16> half_restored(1, feature_dim, 8, 2, 1);
+    ASSERT(half_restored.loadState(half_bytes.data(), half_bytes.size()) == half_bytes.size(), "Same storage type loads");
+    ASSERT(half_restored.read(out_b) && out_b[0][0][0] == 1.5f, "Float16 data restored");
+}
+
 int main() {
     TestBasic3D();
     TestOffsetWrite3D();
     TestPush3D();
     TestReady3D();
     TestPrime3D();
+    TestHalfStorage3D();
+    TestQuantizedStorage3D();
+    TestCMVN3D();
+    TestSplicedAndDeltas3D();
+    TestContextChunking3D();
+    TestSaveLoadState3D();
     print_pass();
     return 0;
 }
@@ -0,0 +1,122 @@
+#include "JABuff/AsyncFileReader.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+
+// Stereo PCM16 WAV: left = i, right = -i (in LSBs).
+static void write_pcm16_wav(const std::string& path, size_t frames) {
+    std::vector<std::uint8_t> payload;
+    for (size_t i = 0; i < frames; ++i) {
+        put_u16(payload, static_cast<std::uint16_t>(static_cast<std::int16_t>(i)));
+        put_u16(payload, static_cast<std::uint16_t>(static_cast<std::int16_t>(-static_cast<int>(i))));
+    }
+    write_wav(path, 1, 2, 16, payload);
+}
+
+// Raw mono float32 after a 16-byte header: sample i = i * 0.5.
+static void write_raw_float(const std::string& path, size_t frames) {
+    std::vector<std::uint8_t> b(16, 0xAB);
+    for (size_t i = 0; i < frames; ++i) {
+        float v = static_cast<float>(i) * 0.5f;
+        const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(&v);
+        b.insert(b.end(), p, p + sizeof(float));
+    }
+    write_file(path, b);
+}
+
+static void run_ingest(JABuff::IngestBackend backend) {
+    const size_t wav_frames = 20000;
+    const size_t raw_frames = 30001;
+    write_pcm16_wav("jabuff_test_async.wav", wav_frames);
+    write_raw_float("jabuff_test_async.raw", raw_frames);
+
+    // Small chunks and rings so reads wrap the rings and many are in flight at once.
+    JABuff::AsyncFileReader<float> reader(8, 4096, backend);
+    JABuff::FramingRingBuffer2D<float> wav_ring(2, 3000, 100, 100);
+    JABuff::FramingRingBuffer2D<float> raw_ring(1, 2500, 100, 100);
+    size_t wav = reader.addFile("jabuff_test_async.wav", wav_ring);
+    size_t raw = reader.addFile("jabuff_test_async.raw", raw_ring, JABuff::SampleFormat::Float32, 1, 16);
+    ASSERT(reader.getNumStreams() == 2 && reader.getTotalFrames(wav) == wav_frames && reader.getTotalFrames(raw) == raw_frames, "Streams");
+
+    std::vector<std::vector<float>> out;
+    size_t wav_checked = 0;
+    size_t raw_checked = 0;
+    size_t guard = 0;
+    while (!reader.allFinished() || wav_ring.getAvailableFramesRead() > 0 || raw_ring.getAvailableFramesRead() > 0) {
+        ASSERT(++guard < 100000, "Ingestion made no progress");
+        reader.poll(true);
+        // Consume between polls, as the framing / compute stage would.
+        while (wav_ring.read(out, 1)) {
+            for (size_t i = 0; i < 100; ++i, ++wav_checked) {
+                ASSERT_NEAR(out[0][i], static_cast<float>(wav_checked) / 32768.0f, 1e-7f, "WAV left mismatch");
+                ASSERT_NEAR(out[1][i], -static_cast<float>(wav_checked) / 32768.0f, 1e-7f, "WAV right mismatch");
+            }
+        }
+        while (raw_ring.read(out, 1)) {
+            for (size_t i = 0; i < 100; ++i, ++raw_checked) {
+                ASSERT(out[0][i] == static_cast<float>(raw_checked) * 0.5f, "Raw (direct) mismatch");
+            }
+        }
+    }
+    ASSERT(wav_checked == wav_frames, "All WAV frames read");
+    ASSERT(raw_checked == raw_frames - 1 && raw_ring.getAvailableFeaturesRead() == 1, "All raw frames read (one sample short of a frame left)");
+    ASSERT(reader.isFinished(wav) && reader.isFinished(raw) && reader.getReadsInFlight() == 0, "Finished");
+    ASSERT(reader.getFramesPublished(raw) == raw_frames, "Published count");
+
+    std::remove("jabuff_test_async.wav");
+    std::remove("jabuff_test_async.raw");
+}
+
+void TestAsyncReaderPread() {
+    print_header("TestAsyncReaderPread");
+    run_ingest(JABuff::IngestBackend::Pread);
+    JABuff::AsyncFileReader<float> reader(4, 4096, JABuff::IngestBackend::Pread);
+    ASSERT(reader.getBackend() == JABuff::IngestBackend::Pread, "Forced fallback");
+}
+
+void TestAsyncReaderIoUring() {
+    print_header("TestAsyncReaderIoUring");
+    // Falls back to pread where io_uring is unavailable (old kernel, sandbox); the results must be identical.
+    run_ingest(JABuff::IngestBackend::IoUring);
+    JABuff::AsyncFileReader<float> reader(4, 4096);
+#if !defined(JABUFF_HAS_IO_URING)
+    ASSERT(reader.getBackend() == JABuff::IngestBackend::Pread, "No io_uring headers: pread");
+#endif
+}
+
+void TestAsyncReaderErrors() {
+    print_header("TestAsyncReaderErrors");
+    bool thrown = false;
+    try { JABuff::AsyncFileReader<float> bad(4, 1000); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Unaligned chunk size should throw");
+
+    thrown = false;
+    try { JABuff::AsyncFileReader<float> bad(0, 4096); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Zero queue depth should throw");
+
+    JABuff::AsyncFileReader<float> reader(4, 4096);
+    JABuff::FramingRingBuffer2D<float> mono(1, 1024, 64, 64);
+    thrown = false;
+    try { reader.addFile("jabuff_test_missing.wav", mono); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Missing file should throw");
+
+    write_pcm16_wav("jabuff_test_async_err.wav", 10);
+    thrown = false;
+    try { reader.addFile("jabuff_test_async_err.wav", mono); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Channel mismatch should throw");
+    std::remove("jabuff_test_async_err.wav");
+
+    thrown = false;
+    try { reader.isFinished(0); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Unknown stream should throw");
+}
+
+int main() {
+    TestAsyncReaderPread();
+    TestAsyncReaderIoUring();
+    TestAsyncReaderErrors();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "JABuff/DriftCompensator.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <cmath>
+
+// Producer at 48 kHz * (1 + drift), consumer pulling 480-sample frames at exactly 48 kHz.
+template <typename Writer, typename Reader>
+static void run_clocks(Writer&& write, Reader&& read, double drift, size_t ticks, double& phase) {
+    const double two_pi = 6.283185307179586476925286766559;
+    double owed = 0.0;
+    for (size_t tick = 0; tick < ticks; ++tick) {
+        owed += 480.0 * (1.0 + drift);
+        size_t n = static_cast<size_t>(owed);
+        owed -= static_cast<double>(n);
+        std::vector<std::vector<float>> block(1, std::vector<float>(n));
+        for (size_t i = 0; i < n; ++i) {
+            block[0][i] = static_cast<float>(std::sin(phase));
+            phase += two_pi * 440.0 / 48000.0;
+        }
+        write(block);
+        read();
+    }
+}
+
+void TestDriftCompensatorHoldsFill() {
+    print_header("TestDriftCompensatorHoldsFill");
+    const double drift = 150e-6;
+    double phase = 0.0;
+
+    // Uncompensated reference: the fill creeps up by ~0.07 samples per frame.
+    JABuff::FramingRingBuffer2D<float> plain(1, 8192, 480, 480);
+    std::vector<std::vector<float>> out;
+    run_clocks([&](const std::vector<std::vector<float>>& b) { plain.write(b); },
+               [&]() { plain.read(out, 1); }, drift, 6000, phase);
+    ASSERT(plain.getAvailableFeaturesRead() > 400, "Uncompensated buffer should drift");
+
+    phase = 0.0;
+    JABuff::FramingRingBuffer2D<float> buffer(1, 8192, 480, 480);
+    JABuff::DriftCompensator<float> compensator(buffer, 960.0);
+    buffer.prime();
+    size_t underruns = 0;
+    double last = 0.0;
+    bool continuous = true;
+    run_clocks([&](const std::vector<std::vector<float>>& b) { ASSERT(compensator.write(b), "Compensated write failed"); },
+               [&]() {
+                   if (!buffer.read(out, 1)) { ++underruns; return; }
+                   // The resampled tone stays smooth across block and frame boundaries.
+                   for (float v : out[0]) {
+                       if (std::fabs(v - last) > 0.07f) continuous = false;
+                       last = v;
+                   }
+               }, drift, 6000, phase);
+
+    ASSERT(underruns == 0, "Compensated buffer should not underrun");
+    ASSERT(continuous, "Resampled stream has a discontinuity");
+    ASSERT(std::fabs(compensator.getSmoothedFill() - 960.0) < 120.0, "Fill should settle at the target");
+    ASSERT_NEAR(compensator.getEstimatedDriftPpm(), 150.0, 15.0, "Drift estimate");
+}
+
+void TestDriftCompensatorOLA() {
+    print_header("TestDriftCompensatorOLA");
+    // Blocks of 512 with 32 overlap (480 net) per tick; the consumer pulls 32-sample frames
+    // at a clock 300 ppm faster than the producer, so the buffer would drain.
+    JABuff::OLARingBuffer2D<float> ola(1, 8192, 32, 32);
+    JABuff::DriftCompensator<float, JABuff::OLARingBuffer2D> compensator(ola, 1500.0, 1.5e-5, 1.1e-10, 2e-3);
+
+    const double drift = -300e-6;
+    std::vector<std::vector<float>> block(1, std::vector<float>(512, 0.25f)), out;
+    double owed = 0.0, ppm_sum = 0.0;
+    size_t underruns = 0, ppm_count = 0;
+    for (size_t tick = 0; tick < 4; ++tick) compensator.write(block);
+    for (size_t tick = 0; tick < 20000; ++tick) {
+        owed += 480.0 / (1.0 + drift);
+        while (owed >= 32.0) {
+            owed -= 32.0;
+            if (!ola.read(out, 1)) ++underruns;
+        }
+        ASSERT(compensator.write(block), "OLA write failed");
+        if (tick >= 15000) {
+            ppm_sum += compensator.getEstimatedDriftPpm();
+            ++ppm_count;
+        }
+    }
+    ASSERT(underruns == 0, "OLA buffer should not underrun");
+    ASSERT(std::fabs(compensator.getSmoothedFill() - 1500.0) < 100.0, "OLA fill should settle at the target");
+    ASSERT_NEAR(ppm_sum / static_cast<double>(ppm_count), -300.0, 30.0, "OLA drift estimate");
+
+    bool thrown = false;
+    JABuff::FramingRingBuffer2D<float> small(1, 16, 4, 4);
+    try { JABuff::DriftCompensator<float> bad(small, 32.0); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Target beyond capacity should throw");
+
+    // Ragged channels are rejected before any sample is touched.
+    JABuff::FramingRingBuffer2D<float> stereo(2, 256, 16, 16);
+    JABuff::DriftCompensator<float> checked(stereo, 64.0);
+    for (const auto& ragged : {std::vector<std::vector<float>>{{1.0f, 2.0f, 3.0f}, {1.0f}},
+                               std::vector<std::vector<float>>{{1.0f, 2.0f}, {}},
+                               std::vector<std::vector<float>>{{}, {1.0f}}}) {
+        thrown = false;
+        try { checked.write(ragged); } catch (const std::invalid_argument&) { thrown = true; }
+        ASSERT(thrown, "Ragged input should throw");
+    }
+    ASSERT(stereo.getAvailableFeaturesRead() == 0, "Nothing written from ragged input");
+}
+
+int main() {
+    TestDriftCompensatorHoldsFill();
+    TestDriftCompensatorOLA();
+    print_pass();
+    return 0;
+}
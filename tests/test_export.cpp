@@ -0,0 +1,92 @@
+#include "JABuff/FramingRingBuffer2D.hpp"
+#include "JABuff/FramingRingBuffer3D.hpp"
+#include "JABuff/TensorExport.hpp"
+#include "test_utils.hpp"
+#include <vector>
+
+#if defined(JABUFF_TEST_EXPECT_DLPACK) && !defined(JABUFF_HAS_DLPACK)
+#error "TestExportDLPack must compile against <dlpack/dlpack.h>"
+#endif
+
+void TestExport2D() {
+    print_header("TestExport2D");
+    JABuff::FramingRingBuffer2D<float> buffer(2, 10, 4, 2);
+    std::vector<std::vector<float>> data(2, std::vector<float>(6));
+    for (size_t i = 0; i < 6; ++i) { data[0][i] = static_cast<float>(i); data[1][i] = 10.0f + static_cast<float>(i); }
+    ASSERT(buffer.write(data), "Write failed");
+
+    JABuff::ExportedTensor<float> tensor;
+    ASSERT(buffer.exportFrames(tensor, 2), "Export failed");
+    const JABuff::DLTensor* t = tensor.get();
+    ASSERT(tensor.isZeroCopy() && tensor.isPinned(), "Unwrapped export should be zero-copy");
+    ASSERT(t->ndim == 2 && t->shape[0] == 2 && t->shape[1] == 6, "Shape");
+    ASSERT(t->strides[0] == 10 && t->strides[1] == 1, "Strides (elements)");
+    ASSERT(t->dtype.code == 2 && t->dtype.bits == 32 && t->dtype.lanes == 1, "dtype float32");
+    ASSERT(t->device.device_type == 1, "CPU device");
+    const float* p = tensor.data();
+    ASSERT_NEAR(p[t->strides[0] * 1 + 5], 15.0f, 0.0f, "Strided element");
+
+    // Consuming does not unpin: the write head may not lap the exported region.
+    ASSERT(buffer.advance(2), "Advance failed");
+    ASSERT(buffer.getAvailableFeaturesRead() == 2, "Consumed");
+    ASSERT(buffer.getAvailableWrite() == 4, "Pinned region limits writes");
+    std::vector<std::vector<float>> more(2, std::vector<float>(5, -1.0f));
+    ASSERT(!buffer.write(more), "Write into pinned region should be refused");
+    ASSERT_NEAR(p[0], 0.0f, 0.0f, "Pinned data intact");
+
+    bool thrown = false;
+    try { buffer.clear(); } catch (const std::logic_error&) { thrown = true; }
+    ASSERT(thrown, "clear() while pinned should throw");
+
+    tensor.release();
+    ASSERT(!buffer.isPinned(), "Released");
+    ASSERT(buffer.getAvailableWrite() == 8, "Write space restored");
+    ASSERT(buffer.write(more), "Write after release");
+
+    // Move the read head to 6 and fill up, so the available block wraps the ring end.
+    ASSERT(buffer.advance(1), "Advance failed");
+    std::vector<std::vector<float>> tail(2, std::vector<float>(5, -2.0f));
+    ASSERT(buffer.write(tail), "Fill write failed");
+    ASSERT(buffer.exportFrames(tensor, 0), "Wrapped export failed");
+    t = tensor.get();
+    ASSERT(!tensor.isZeroCopy() && !tensor.isPinned(), "Wrapped export is a copy");
+    ASSERT(t->shape[1] == 10 && t->strides[0] == 10, "Wrapped shape");
+    ASSERT_NEAR(tensor.data()[0 * 10 + 4], -1.0f, 0.0f, "Wrapped copy head");
+    ASSERT_NEAR(tensor.data()[1 * 10 + 5], -2.0f, 0.0f, "Wrapped copy tail");
+    ASSERT(tensor.getNumFrames() == 4, "Frame count");
+}
+
+void TestExport3D() {
+    print_header("TestExport3D");
+    JABuff::FramingRingBuffer3D<float, JABuff::Float16> buffer(2, 3, 6, 2, 2);
+    std::vector<std::vector<float>> step(2, std::vector<float>(3));
+    for (int t = 0; t < 4; ++t) {
+        for (size_t c = 0; c < 2; ++c)
+            for (size_t f = 0; f < 3; ++f) step[c][f] = static_cast<float>(t * 4 + static_cast<int>(f)) + (c ? 0.5f : 0.0f);
+        ASSERT(buffer.push(step), "Push failed");
+    }
+
+    {
+        JABuff::ExportedTensor<JABuff::Float16> tensor;
+        ASSERT(buffer.exportFrames(tensor, 2), "Export failed");
+        const JABuff::DLTensor* t = tensor.get();
+        ASSERT(t->ndim == 3 && t->shape[0] == 2 && t->shape[1] == 4 && t->shape[2] == 3, "3D shape");
+        ASSERT(t->strides[0] == 18 && t->strides[1] == 3 && t->strides[2] == 1, "3D strides");
+        ASSERT(t->dtype.code == 2 && t->dtype.bits == 16, "dtype float16");
+        JABuff::Float16 h = tensor.data()[t->strides[0] + 3 * t->strides[1] + 2];
+        ASSERT_NEAR(JABuff::detail::halfBitsToFloat(h.bits), 14.5f, 0.0f, "Half element");
+        ASSERT(buffer.getAvailableWrite() == 2, "Unconsumed export leaves free space");
+        std::vector<std::vector<std::vector<float>>> out;
+        ASSERT(buffer.read(out, 2), "Read failed");
+        ASSERT(buffer.getAvailableWrite() == 2, "Pinned after read");
+    }
+    ASSERT(!buffer.isPinned(), "Destructor releases the pin");
+    ASSERT(buffer.getAvailableWrite() == 6, "Space after release");
+}
+
+int main() {
+    TestExport2D();
+    TestExport3D();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "JABuff/MappedFileSource.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <cstring>
+
+void TestWavPCM16Streaming() {
+    print_header("TestWavPCM16Streaming");
+    // Stereo PCM16: left = i, right = -i (in LSBs), 3000 frames streamed through a 256-sample ring.
+    const size_t frames = 3000;
+    std::vector<std::uint8_t> payload;
+    for (size_t i = 0; i < frames; ++i) {
+        put_u16(payload, static_cast<std::uint16_t>(static_cast<std::int16_t>(i)));
+        put_u16(payload, static_cast<std::uint16_t>(static_cast<std::int16_t>(-static_cast<int>(i))));
+    }
+    const std::string path = "jabuff_test_pcm16.wav";
+    write_wav(path, 1, 2, 16, payload);
+
+    JABuff::MappedFileSource<float> source(path);
+    ASSERT(source.getNumChannels() == 2 && source.getSampleRate() == 16000, "Header");
+    ASSERT(source.getFormat() == JABuff::SampleFormat::PCM16 && source.getTotalFrames() == frames, "Format / length");
+
+    JABuff::FramingRingBuffer2D<float> ring(2, 256, 100, 100);
+    std::vector<std::vector<float>> out;
+    size_t checked = 0;
+    while (!source.eof() || ring.getAvailableFramesRead() > 0) {
+        source.pump(ring, 70);
+        while (ring.read(out, 1)) {
+            for (size_t i = 0; i < 100; ++i, ++checked) {
+                ASSERT(out[0][i] == static_cast<float>(checked) / 32768.0f, "Left channel");
+                ASSERT(out[1][i] == -static_cast<float>(checked) / 32768.0f, "Right channel");
+            }
+        }
+        if (source.eof() && ring.getAvailableFramesRead() == 0) break;
+    }
+    ASSERT(checked == frames, "All frames streamed");
+    ASSERT(source.pump(ring) == 0, "Nothing left at EOF");
+
+    source.seek(2990);
+    ring.clear();
+    ASSERT(source.pump(ring) == 10 && source.eof(), "Seek near the end");
+
+    bool thrown = false;
+    JABuff::FramingRingBuffer2D<float> mono(1, 64, 8, 8);
+    try { source.pump(mono); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Channel mismatch should throw");
+    std::remove(path.c_str());
+}
+
+void TestWavFormats() {
+    print_header("TestWavFormats");
+    // PCM24 mono: full-scale negative, zero and a positive value.
+    std::vector<std::uint8_t> pcm24 = {0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40};
+    write_wav("jabuff_test_pcm24.wav", 1, 1, 24, pcm24);
+    // Float32 mono.
+    std::vector<std::uint8_t> f32;
+    for (float v : {0.5f, -0.25f, 1.0f}) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &v, 4);
+        put_u32(f32, bits);
+    }
+    write_wav("jabuff_test_f32.wav", 3, 1, 32, f32);
+
+    JABuff::FramingRingBuffer2D<double> ring(1, 16, 3, 3);
+    std::vector<std::vector<double>> out;
+    {
+        JABuff::MappedFileSource<double> source("jabuff_test_pcm24.wav");
+        ASSERT(source.getFormat() == JABuff::SampleFormat::PCM24, "PCM24 detected");
+        ASSERT(source.pump(ring) == 3 && ring.read(out, 1), "PCM24 pump");
+        ASSERT(out[0][0] == -1.0 && out[0][1] == 0.0 && out[0][2] == 0.5, "PCM24 values");
+    }
+    {
+        JABuff::MappedFileSource<double> source("jabuff_test_f32.wav");
+        ASSERT(source.getFormat() == JABuff::SampleFormat::Float32, "Float32 detected");
+        ASSERT(source.pump(ring) == 3 && ring.read(out, 1), "Float32 pump");
+        ASSERT(out[0][0] == 0.5 && out[0][1] == -0.25 && out[0][2] == 1.0, "Float32 values");
+    }
+
+    // Raw interleaved PCM32 with a 4-byte header to skip.
+    std::vector<std::uint8_t> raw = {0xDE, 0xAD, 0xBE, 0xEF};
+    put_u32(raw, 0x40000000u);
+    put_u32(raw, 0xC0000000u);
+    write_file("jabuff_test_raw.pcm", raw);
+    {
+        JABuff::MappedFileSource<double> source("jabuff_test_raw.pcm", JABuff::SampleFormat::PCM32, 2, 8000, 4);
+        JABuff::FramingRingBuffer2D<double> stereo(2, 8, 1, 1);
+        ASSERT(source.getTotalFrames() == 1 && source.pump(stereo) == 1 && stereo.read(out, 1), "Raw pump");
+        ASSERT(out[0][0] == 0.5 && out[1][0] == -0.5, "Raw PCM32 values");
+    }
+
+    bool thrown = false;
+    try { JABuff::MappedFileSource<double> bad("jabuff_test_raw.pcm"); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Non-WAV file should throw");
+    thrown = false;
+    try { JABuff::MappedFileSource<double> missing("jabuff_test_missing.wav"); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown, "Missing file should throw");
+
+    std::remove("jabuff_test_pcm24.wav");
+    std::remove("jabuff_test_f32.wav");
+    std::remove("jabuff_test_raw.pcm");
+}
+
+int main() {
+    TestWavPCM16Streaming();
+    TestWavFormats();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "JABuff/FrameView.hpp"
+#include "JABuff/FramingRingBuffer2D.hpp"
+#include "test_utils.hpp"
+#include <vector>
+
+void TestFrameViewMatchesStreaming() {
+    print_header("TestFrameViewMatchesStreaming");
+    const size_t length = 1000, frame = 64, hop = 24;
+    std::vector<std::vector<float>> signal(2, std::vector<float>(length));
+    for (size_t i = 0; i < length; ++i) {
+        signal[0][i] = static_cast<float>(i);
+        signal[1][i] = static_cast<float>(i) * 0.5f - 7.0f;
+    }
+
+    JABuff::FrameView<float> view(signal, frame, hop);
+    JABuff::FramingRingBuffer2D<float> ring(2, 2048, frame, hop);
+    ASSERT(ring.write(signal), "Write failed");
+    ASSERT(view.getNumFrames() == ring.getAvailableFramesRead(), "Same frame count as the streaming path");
+    ASSERT(view.getNumFullFrames() == view.getNumFrames(), "Drop keeps only full frames");
+
+    // Frame by frame, the offline view equals what the ring reads.
+    std::vector<std::vector<float>> out;
+    for (size_t k = 0; k < view.getNumFrames(); ++k) {
+        ASSERT(ring.read(out, 1), "Read failed");
+        for (size_t c = 0; c < 2; ++c) {
+            JABuff::RingSpan<const float> f = view.frame(c, k);
+            ASSERT(f.isContiguous() && f.size() == frame, "Full frames are one contiguous run");
+            ASSERT(f.first == signal[c].data() + k * hop, "Zero-copy frame");
+            for (size_t i = 0; i < frame; ++i) {
+                ASSERT(f[i] == out[c][i], "Frame data differs from the streaming path");
+            }
+        }
+    }
+
+    JABuff::RingSpan<const float> blk = view.block(1, 3, 4);
+    ASSERT(blk.size() == 3 * hop + frame && blk.first == signal[1].data() + 3 * hop, "Block like read(4)");
+
+    JABuff::StridedFrames<float> strided = view.strided(0);
+    ASSERT(strided.num_frames == view.getNumFullFrames() && strided.hop_stride == hop, "Strided view");
+    ASSERT(strided.frame(5)[0] == 5.0f * hop, "Strided frame start");
+
+    // min_frames: too few frames yield none, like a streaming read.
+    JABuff::FrameView<float> short_view(signal[0].data(), 100, frame, hop, 3);
+    ASSERT(short_view.getNumFrames() == 0, "min_frames not met");
+}
+
+void TestFrameViewZeroPad() {
+    print_header("TestFrameViewZeroPad");
+    std::vector<double> x(50);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<double>(i + 1);
+
+    JABuff::FrameView<double> view(x.data(), x.size(), 16, 10, 1, JABuff::TailPolicy::ZeroPad);
+    // Full frames start at 0..30; padded frames at 40 (ends at 56) cover the rest.
+    ASSERT(view.getNumFullFrames() == 4 && view.getNumFrames() == 5, "Padded frame count");
+
+    JABuff::RingSpan<const double> tail = view.frame(0, 4);
+    ASSERT(tail.first_size == 10 && tail.second_size == 6, "Tail frame is signal + zeros");
+    std::vector<double> copy(16);
+    tail.copyTo(copy.data());
+    for (size_t i = 0; i < 16; ++i) {
+        ASSERT(copy[i] == (i < 10 ? static_cast<double>(41 + i) : 0.0), "Tail frame data");
+    }
+
+    JABuff::RingSpan<const double> blk = view.block(0, 3, 2);
+    ASSERT(blk.size() == 26 && blk.first_size == 20 && blk[25] == 0.0, "Block into the padding");
+
+    JABuff::FrameView<double> tiny(x.data(), 5, 16, 10, 1, JABuff::TailPolicy::ZeroPad);
+    ASSERT(tiny.getNumFrames() == 1 && tiny.getNumFullFrames() == 0 && tiny.frame(0, 0)[4] == 5.0, "Signal shorter than a frame");
+
+    bool thrown = false;
+    try { view.frame(0, 5); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Frame out of range should throw");
+    thrown = false;
+    try { JABuff::FrameView<double> bad(x.data(), x.size(), 16, 0); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Zero hop should throw");
+}
+
+int main() {
+    TestFrameViewMatchesStreaming();
+    TestFrameViewZeroPad();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "JABuff/JitterBuffer.hpp"
+#include "test_utils.hpp"
+#include <vector>
+
+// One-channel packet with values timestamp, timestamp + 1, ...
+static std::vector<std::vector<float>> ramp_packet(std::uint64_t timestamp, size_t len) {
+    std::vector<std::vector<float>> packet(1, std::vector<float>(len));
+    for (size_t i = 0; i < len; ++i) packet[0][i] = static_cast<float>(timestamp + i);
+    return packet;
+}
+
+void TestJitterReorder() {
+    print_header("TestJitterReorder");
+    // Capacity 40 so the pending region wraps around the ring.
+    JABuff::FramingRingBuffer2D<float> ring(1, 40, 10, 10);
+    ring.write(ramp_packet(0, 30));
+    std::vector<std::vector<float>> out;
+    ASSERT(ring.read(out, 3), "Setup read failed");
+
+    JABuff::JitterBuffer<float> jitter(ring, 1000);
+
+    // Packets of 5 arrive in the order 3, 1, 0, 2.
+    ASSERT(jitter.insert(1015, ramp_packet(1015, 5)), "Insert 3");
+    ASSERT(jitter.insert(1005, ramp_packet(1005, 5)), "Insert 1");
+    ASSERT(ring.getAvailableFeaturesRead() == 0, "Nothing may be readable while the head is missing");
+    ASSERT(jitter.getHoleCount() == 2 && jitter.getPendingSamples() == 10, "Two holes pending");
+
+    ASSERT(jitter.insert(1000, ramp_packet(1000, 5)), "Insert 0");
+    ASSERT(ring.getAvailableFeaturesRead() == 10 && jitter.getHeadTimestamp() == 1010, "Packets 0 and 1 committed");
+    ASSERT(jitter.getHoleCount() == 1, "One hole left");
+
+    ASSERT(jitter.insert(1010, ramp_packet(1010, 5)), "Insert 2");
+    ASSERT(ring.getAvailableFeaturesRead() == 20 && jitter.getHoleCount() == 0, "All committed");
+
+    ASSERT(ring.read(out, 2), "Read failed");
+    for (size_t i = 0; i < 20; ++i) {
+        ASSERT(out[0][i] == static_cast<float>(1000 + i), "Reordered data mismatch");
+    }
+
+    // Late and partially late packets.
+    ASSERT(!jitter.insert(1010, ramp_packet(1010, 5)), "Fully late packet must be dropped");
+    ASSERT(jitter.getLatePackets() == 1, "Late count");
+    ASSERT(jitter.insert(1018, ramp_packet(1018, 6)), "Straddling packet keeps its new part");
+    ASSERT(jitter.getHeadTimestamp() == 1024, "Head after the straddling packet");
+
+    // A packet beyond the free space is refused.
+    ASSERT(!jitter.insert(1024 + 100, ramp_packet(1124, 5)), "Packet past the free space must be refused");
+}
+
+void TestJitterDeadline() {
+    print_header("TestJitterDeadline");
+    JABuff::FramingRingBuffer2D<float> ring(1, 64, 4, 4);
+    JABuff::JitterBuffer<float> jitter(ring, 0);
+
+    // Packet 1 (samples 4..7) is lost.
+    ASSERT(jitter.insert(0, ramp_packet(0, 4)), "Insert 0");
+    ASSERT(jitter.insert(8, ramp_packet(8, 4)), "Insert 2");
+    ASSERT(ring.getAvailableFeaturesRead() == 4, "Only packet 0 is complete");
+
+    ASSERT(jitter.flush(8) == 8, "Flush conceals the hole and commits the run behind it");
+    ASSERT(jitter.getConcealedSamples() == 4, "Concealed sample count");
+    std::vector<std::vector<float>> out;
+    ASSERT(ring.read(out, 3), "Read failed");
+    for (size_t i = 0; i < 12; ++i) {
+        float expected = (i >= 4 && i < 8) ? 0.0f : static_cast<float>(i);
+        ASSERT(out[0][i] == expected, "Silence concealment mismatch");
+    }
+    ASSERT(jitter.flush(3) == 0, "Flushing behind the head does nothing");
+
+    // Automatic deadline: with a playout delay of 8, a missing packet is given up once 8 newer samples arrived.
+    jitter.setPlayoutDelay(8);
+    ASSERT(jitter.insert(16, ramp_packet(16, 4)), "Insert 4");
+    ASSERT(jitter.getHeadTimestamp() == 12 && jitter.getHoleCount() == 1, "Hole within the delay waits");
+    ASSERT(jitter.insert(20, ramp_packet(20, 4)), "Insert 5");
+    ASSERT(jitter.getHeadTimestamp() == 24 && jitter.getHoleCount() == 0, "Hole past the delay is concealed");
+    ASSERT(jitter.getConcealedSamples() == 8, "Concealed after deadline");
+
+    bool thrown = false;
+    try { jitter.flush(24 + 1000); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Flush beyond the free space should throw");
+}
+
+void TestJitterRepeatFade() {
+    print_header("TestJitterRepeatFade");
+    JABuff::FramingRingBuffer2D<float> ring(2, 64, 4, 4);
+    JABuff::JitterBuffer<float> jitter(ring, 0, JABuff::ConcealMode::RepeatFade, 4);
+
+    std::vector<std::vector<float>> packet(2, std::vector<float>(4));
+    for (size_t i = 0; i < 4; ++i) {
+        packet[0][i] = 1.0f;
+        packet[1][i] = static_cast<float>(i + 1);
+    }
+    ASSERT(jitter.insert(0, packet), "Insert");
+    ASSERT(jitter.flush(10) == 6, "Flush");
+
+    std::vector<std::vector<float>> out;
+    ASSERT(ring.read(out, 1) && ring.read(out, 1), "Read failed");
+    // Samples 4..7 repeat the last 4 samples with gains 0.8, 0.6, 0.4, 0.2.
+    const float gains[4] = {0.8f, 0.6f, 0.4f, 0.2f};
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_NEAR(out[0][i], gains[i], 1e-6f, "Faded repeat (constant)");
+        ASSERT_NEAR(out[1][i], static_cast<float>(i + 1) * gains[i], 1e-6f, "Faded repeat (ramp)");
+    }
+    ASSERT(ring.getAvailableFeaturesRead() == 2, "Tail of the hole committed");
+
+    bool thrown = false;
+    try { JABuff::JitterBuffer<float> bad(ring, 0, JABuff::ConcealMode::RepeatFade, 0); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "RepeatFade without a fade length should throw");
+
+    thrown = false;
+    try { jitter.insert(20, std::vector<std::vector<float>>(1, std::vector<float>(4))); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Channel mismatch should throw");
+}
+
+int main() {
+    TestJitterReorder();
+    TestJitterDeadline();
+    TestJitterRepeatFade();
+    print_pass();
+    return 0;
+}
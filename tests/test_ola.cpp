@@ -254,6 +254,34 @@ void TestPrimeSilence() {
     ASSERT(splice_val >= 0.0f, "Splice val positive");
 }
 
+void TestSaveLoadState() {
+    print_header("TestSaveLoadState");
+    // The pending tail must be restored so the next write splices as it would have on the original.
+    JABuff::OLARingBuffer2D<float> source(2, 64, 10, 4);
+    std::vector<std::vector<float>> block(2, std::vector<float>(30));
+    for (size_t i = 0; i < 30; ++i) { block[0][i] = static_cast<float>(i); block[1][i] = 1.0f; }
+    ASSERT(source.write(block), "Write 1 failed");
+    std::vector<std::vector<float>> out_a, out_b;
+    ASSERT(source.read(out_a, 2), "Read failed");
+    ASSERT(source.write(block) && source.write(block), "Write 2 failed");
+
+    std::vector<std::uint8_t> bytes;
+    source.saveState(bytes);
+    JABuff::OLARingBuffer2D<float> restored(2, 64, 10, 4);
+    ASSERT(restored.loadState(bytes.data(), bytes.size()) == bytes.size(), "Whole snapshot consumed");
+    ASSERT(restored.getAvailableSamplesRead() == source.getAvailableSamplesRead(), "Cursors");
+
+    ASSERT(source.read(out_a, 0) && restored.read(out_b, 0), "Read all failed");
+    ASSERT(out_a == out_b, "Restored samples must match");
+    ASSERT(source.write(block) && restored.write(block), "Write after restore failed");
+    ASSERT(source.read(out_a, 0) && restored.read(out_b, 0), "Read after splice failed");
+    ASSERT(out_a == out_b, "Splice with the restored tail must match");
+
+    bool thrown = false;
+    try { JABuff::OLARingBuffer2D<float> wrong(2, 64, 10, 8); wrong.loadState(bytes.data(), bytes.size()); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Overlap mismatch should throw");
+}
+
 int main() {
     TestInitialization();
     TestZeroOverlapFIFO();
@@ -261,6 +289,7 @@ int main() {
     TestCrossfadeLogic();
     TestVariableWritesAndWrapping();
     TestPrimeSilence();
+    TestSaveLoadState();
     
     print_pass();
     return 0;
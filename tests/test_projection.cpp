@@ -0,0 +1,130 @@
+#include "JABuff/FramingRingBuffer3D.hpp"
+#include "JABuff/BandedMatrix.hpp"
+#include "test_utils.hpp"
+#include <vector>
+
+void TestBandedMatrix() {
+    print_header("TestBandedMatrix");
+    std::vector<std::vector<double>> dense = {
+        {0.0, 1.0, 2.0, 0.0, 0.0, 0.0},
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {0.0, 0.0, 3.0, 0.0, -1.0, 0.0},
+        {0.5, 0.0, 0.0, 0.0, 0.0, 4.0},
+    };
+    auto m = JABuff::BandedMatrix<double>::fromDense(dense);
+    ASSERT(m.getOutputDim() == 4 && m.getInputDim() == 6, "Shape");
+    ASSERT(m.getNonZeros() == 2 + 0 + 3 + 6, "Band storage (inner zeros kept)");
+
+    std::vector<double> x = {1.0, -2.0, 3.0, 0.5, 7.0, -1.5};
+    std::vector<double> y(4);
+    m.apply(x.data(), y.data());
+    for (size_t r = 0; r < 4; ++r) {
+        double expected = 0.0;
+        for (size_t k = 0; k < 6; ++k) expected += dense[r][k] * x[k];
+        ASSERT_NEAR(y[r], expected, 1e-12, "apply() mismatch");
+    }
+
+    // Replacing a band shifts the packed storage of later rows.
+    m.setRow(0, 3, {1.0, 1.0, 1.0});
+    m.apply(x.data(), y.data());
+    ASSERT_NEAR(y[0], 0.5 + 7.0 - 1.5, 1e-12, "setRow() mismatch");
+    ASSERT_NEAR(y[3], 0.5 - 6.0, 1e-12, "Later row after setRow()");
+
+    bool thrown = false;
+    try { m.setRow(1, 5, {1.0, 1.0}); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Band past input dimension should throw");
+}
+
+void TestMelFilterbank() {
+    print_header("TestMelFilterbank");
+    const size_t bins = 257, mels = 40;
+    auto mel = JABuff::BandedMatrix<float>::melFilterbank(bins, mels, 16000.0);
+    ASSERT(mel.getOutputDim() == mels && mel.getInputDim() == bins, "Mel shape");
+    ASSERT(mel.getNonZeros() < bins * mels / 4, "Mel bands should be sparse");
+
+    // A unit impulse in each bin lands in at most two neighbouring bands with weights summing to ~1.
+    std::vector<float> x(bins, 0.0f), y(mels);
+    for (size_t k = 20; k < 240; k += 17) {
+        std::fill(x.begin(), x.end(), 0.0f);
+        x[k] = 1.0f;
+        mel.apply(x.data(), y.data());
+        float total = 0.0f;
+        size_t hit = 0;
+        for (float v : y) {
+            ASSERT(v >= 0.0f, "Mel weights are non-negative");
+            total += v;
+            if (v > 0.0f) ++hit;
+        }
+        ASSERT(hit >= 1 && hit <= 2, "Impulse should hit one or two bands");
+        ASSERT_NEAR(total, 1.0f, 1e-4f, "Overlapping triangles sum to one");
+    }
+}
+
+void TestProjectedBuffer3D() {
+    print_header("TestProjectedBuffer3D");
+    const size_t in_dim = 6, out_dim = 3;
+    std::vector<std::vector<double>> dense(out_dim, std::vector<double>(in_dim, 0.0));
+    for (size_t r = 0; r < out_dim; ++r) {
+        dense[r][2 * r] = 1.0;
+        dense[r][2 * r + 1] = 0.5;
+    }
+    auto proj = JABuff::BandedMatrix<double>::fromDense(dense);
+
+    // Project on write: the ring stores out_dim features.
+    JABuff::FramingRingBuffer3D<double> stored(2, out_dim, 4, 2, 1);
+    stored.setWriteProjection(proj);
+    std::vector<std::vector<double>> step(2, std::vector<double>(in_dim));
+    for (int t = 0; t < 6; ++t) {
+        for (size_t c = 0; c < 2; ++c)
+            for (size_t k = 0; k < in_dim; ++k) step[c][k] = static_cast<double>(t * 10 + k) + static_cast<double>(c) * 100.0;
+        if (t >= 4) {
+            std::vector<std::vector<std::vector<double>>> drained;
+            ASSERT(stored.read(drained, 1), "Drain read failed");
+        }
+        ASSERT(stored.pushProjected(step), "Projected push failed");
+    }
+    std::vector<std::vector<std::vector<double>>> out;
+    ASSERT(stored.read(out, 1), "Read after projected push failed");
+    ASSERT(out[1].size() == 2 && out[1][0].size() == out_dim, "Projected storage shape");
+    for (size_t r = 0; r < out_dim; ++r) {
+        double a = 2.0 * 10 + 2 * r + 100.0;
+        ASSERT_NEAR(out[1][0][r], a + 0.5 * (a + 1.0), 1e-12, "Projected stored value");
+    }
+
+    std::vector<std::vector<double>> wrong(2, std::vector<double>(out_dim));
+    bool thrown = false;
+    try { stored.pushProjected(wrong); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Wrong input size should throw");
+
+    // Project on read: the ring stores in_dim features.
+    JABuff::FramingRingBuffer3D<double> raw(1, in_dim, 8, 3, 3);
+    thrown = false;
+    try { raw.setWriteProjection(proj); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Write projection with wrong output dim should throw");
+    raw.setReadProjection(proj);
+    for (int t = 0; t < 3; ++t) {
+        std::vector<std::vector<double>> one(1, std::vector<double>(in_dim));
+        for (size_t k = 0; k < in_dim; ++k) one[0][k] = static_cast<double>(t) - static_cast<double>(k);
+        ASSERT(raw.push(one), "Push failed");
+    }
+    ASSERT(raw.readProjected(out, 1), "Projected read failed");
+    ASSERT(out[0].size() == 3 && out[0][2].size() == out_dim, "Projected read shape");
+    for (size_t r = 0; r < out_dim; ++r) {
+        double a = 2.0 - static_cast<double>(2 * r);
+        ASSERT_NEAR(out[0][2][r], a + 0.5 * (a - 1.0), 1e-12, "Projected read value");
+    }
+    ASSERT(raw.getAvailableTimeRead() == 0, "Projected read consumption");
+
+    raw.clearProjections();
+    thrown = false;
+    try { raw.readProjected(out, 1); } catch (const std::logic_error&) { thrown = true; }
+    ASSERT(thrown, "readProjected without projection should throw");
+}
+
+int main() {
+    TestBandedMatrix();
+    TestMelFilterbank();
+    TestProjectedBuffer3D();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "JABuff/PolyphaseResampler.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <cmath>
+
+static std::vector<float> tone(size_t n, double freq, double rate) {
+    const double two_pi = 6.283185307179586476925286766559;
+    std::vector<float> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = static_cast<float>(std::sin(two_pi * freq * static_cast<double>(i) / rate));
+    return x;
+}
+
+void TestResamplerBlockInvariance() {
+    print_header("TestResamplerBlockInvariance");
+    const size_t input_len = 1000;
+    std::vector<float> x = tone(input_len, 440.0, 44100.0);
+
+    // 44.1 kHz -> 16 kHz (160 / 441), once in one block and once in irregular blocks.
+    JABuff::FramingRingBuffer2D<float> whole_ring(1, 1024, 1, 1);
+    JABuff::PolyphaseResampler<float> whole(whole_ring, 160, 441, 16);
+    ASSERT(whole.getUp() == 160 && whole.getDown() == 441, "Ratio");
+    size_t expected_out = whole.getOutputCount(input_len);
+    ASSERT(whole.write({x}), "Whole write failed");
+    ASSERT(whole_ring.getAvailableFeaturesRead() == expected_out, "Output count");
+    ASSERT(expected_out == (input_len * 160 + 440) / 441, "ceil(N * L / M) outputs from phase 0");
+
+    JABuff::FramingRingBuffer2D<float> split_ring(1, 1024, 1, 1);
+    JABuff::PolyphaseResampler<float> split(split_ring, 160, 441, 16);
+    size_t pos = 0, step = 1;
+    while (pos < input_len) {
+        size_t len = std::min(step, input_len - pos);
+        std::vector<std::vector<float>> block(1, std::vector<float>(x.begin() + pos, x.begin() + pos + len));
+        ASSERT(split.write(block), "Split write failed");
+        pos += len;
+        step = step * 3 % 97 + 1;
+    }
+
+    std::vector<std::vector<float>> a, b;
+    ASSERT(whole_ring.read(a, 0) && split_ring.read(b, 0), "Read failed");
+    ASSERT(a[0].size() == b[0].size(), "Block split changed the output length");
+    for (size_t i = 0; i < a[0].size(); ++i) {
+        ASSERT_NEAR(a[0][i], b[0][i], 1e-6f, "Block split changed the output");
+    }
+}
+
+void TestResamplerTone() {
+    print_header("TestResamplerTone");
+    // 48 kHz -> 16 kHz: a 1 kHz tone comes out as a 1 kHz tone delayed by the group delay.
+    const size_t input_len = 4800;
+    JABuff::FramingRingBuffer2D<double> ring(2, 2048, 1, 1);
+    JABuff::PolyphaseResampler<double> resampler(ring, 3, 9, 48);
+    ASSERT(resampler.getUp() == 1 && resampler.getDown() == 3, "Ratio reduced by gcd");
+    ASSERT_NEAR(resampler.getGroupDelay(), 47.0 / 6.0, 1e-12, "Group delay");
+
+    std::vector<float> xf = tone(input_len, 1000.0, 48000.0);
+    std::vector<std::vector<double>> x(2, std::vector<double>(xf.begin(), xf.end()));
+    for (double& v : x[1]) v *= 0.5;
+    ASSERT(resampler.write(x), "Write failed");
+
+    std::vector<std::vector<double>> out;
+    ASSERT(ring.read(out, 0), "Read failed");
+    ASSERT(out[0].size() == 1600, "Decimated length");
+
+    const double two_pi = 6.283185307179586476925286766559;
+    double delay = resampler.getGroupDelay();
+    for (size_t n = 100; n < 1500; ++n) {
+        double expected = std::sin(two_pi * 1000.0 * (static_cast<double>(n) - delay) / 16000.0);
+        ASSERT_NEAR(out[0][n], expected, 2e-3, "Resampled tone mismatch");
+        ASSERT_NEAR(out[1][n], 0.5 * expected, 1e-3, "Second channel mismatch");
+    }
+
+    // Backpressure: the target is too small for the next block, nothing changes.
+    JABuff::FramingRingBuffer2D<double> small(2, 8, 1, 1);
+    JABuff::PolyphaseResampler<double> limited(small, 1, 3, 8);
+    std::vector<std::vector<double>> block(2, std::vector<double>(30, 1.0));
+    ASSERT(!limited.write(block), "Write should fail when the target is full");
+    ASSERT(small.getAvailableFeaturesRead() == 0, "Nothing written on failure");
+    ASSERT(limited.getOutputCount(30) == 10, "State unchanged after failure");
+
+    bool thrown = false;
+    try { JABuff::PolyphaseResampler<double> bad(ring, 0, 1); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Zero factor should throw");
+
+    // Ragged channels are rejected before any state changes.
+    for (const auto& ragged : {std::vector<std::vector<double>>{std::vector<double>(30, 1.0), std::vector<double>(3000, 1.0)},
+                               std::vector<std::vector<double>>{std::vector<double>(30, 1.0), {}}}) {
+        thrown = false;
+        try { limited.write(ragged); } catch (const std::invalid_argument&) { thrown = true; }
+        ASSERT(thrown, "Ragged input should throw");
+    }
+    ASSERT(limited.getOutputCount(30) == 10, "State unchanged after ragged input");
+}
+
+int main() {
+    TestResamplerBlockInvariance();
+    TestResamplerTone();
+    print_pass();
+    return 0;
+}
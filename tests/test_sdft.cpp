@@ -0,0 +1,125 @@
+#include "JABuff/SlidingDFT.hpp"
+#include "test_utils.hpp"
+#include <complex>
+#include <vector>
+
+// DFT of the newest n samples of a signal (zero before the start)
+std::complex<double> window_dft(const std::vector<float>& signal, size_t end, size_t n, size_t k) {
+    const double two_pi = 6.283185307179586476925286766559;
+    std::complex<double> acc(0.0, 0.0);
+    for (size_t m = 0; m < n; ++m) {
+        double x = (end + m >= n) ? static_cast<double>(signal[end + m - n]) : 0.0;
+        double phase = -two_pi * static_cast<double>((k * m) % n) / static_cast<double>(n);
+        acc += x * std::complex<double>(std::cos(phase), std::sin(phase));
+    }
+    return acc;
+}
+
+void TestSlidingDFTTracksWindow() {
+    print_header("TestSlidingDFTTracksWindow");
+    size_t frame = 16;
+    JABuff::FramingRingBuffer2D<float> buffer(1, 40, frame, 4);
+    JABuff::SlidingDFT<float> sdft(buffer, {0, 1, 5});
+
+    std::vector<float> signal(200);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.7f * static_cast<float>(i)) + 0.25f;
+
+    // Odd block sizes, reading as we go so the ring wraps many times.
+    size_t written = 0;
+    std::vector<std::vector<float>> out;
+    while (written < signal.size()) {
+        size_t len = std::min<size_t>(7, signal.size() - written);
+        std::vector<std::vector<float>> block(1, std::vector<float>(signal.begin() + written, signal.begin() + written + len));
+        ASSERT(buffer.write(block), "Write failed");
+        written += len;
+        while (buffer.read(out)) {}
+
+        for (size_t b = 0; b < sdft.getBins().size(); ++b) {
+            std::complex<double> expected = window_dft(signal, written, frame, sdft.getBins()[b]);
+            std::complex<float> got = sdft.getBin(0, b);
+            ASSERT_NEAR(got.real(), expected.real(), 1e-3, "SDFT real mismatch");
+            ASSERT_NEAR(got.imag(), expected.imag(), 1e-3, "SDFT imag mismatch");
+        }
+    }
+
+    // push() is observed too
+    std::vector<float> one(1, 3.0f);
+    buffer.push(one);
+    signal.push_back(3.0f);
+    ASSERT_NEAR(sdft.getMagnitude(0, 1), std::abs(window_dft(signal, signal.size(), frame, 1)), 1e-3, "SDFT after push");
+}
+
+void TestSlidingDFTResyncAndClear() {
+    print_header("TestSlidingDFTResyncAndClear");
+    JABuff::FramingRingBuffer2D<float> buffer(2, 64, 8, 8);
+    {
+        JABuff::SlidingDFT<float> sdft(buffer, {2}, 5); // Resync every 5 samples
+
+        std::vector<std::vector<float>> block(2, std::vector<float>(8));
+        std::vector<float> signal;
+        for (int rep = 0; rep < 4; ++rep) {
+            for (size_t i = 0; i < 8; ++i) {
+                block[0][i] = static_cast<float>((rep * 8 + i) % 5);
+                block[1][i] = -block[0][i];
+                signal.push_back(block[0][i]);
+            }
+            buffer.write(block);
+            std::vector<std::vector<float>> out;
+            buffer.read(out);
+        }
+        std::complex<double> expected = window_dft(signal, signal.size(), 8, 2);
+        ASSERT_NEAR(sdft.getBin(0, 0).real(), expected.real(), 1e-4, "Resynced real mismatch");
+        ASSERT_NEAR(sdft.getBin(1, 0).imag(), -expected.imag(), 1e-4, "Resynced imag mismatch (ch1)");
+
+        buffer.clear();
+        ASSERT_NEAR(sdft.getPower(0, 0), 0.0f, 1e-9, "Clear should reset bins");
+
+        bool caught = false;
+        try {
+            sdft.getBin(2, 0);
+        } catch (const std::out_of_range&) {
+            caught = true;
+        }
+        ASSERT(caught, "Out of range channel did not throw");
+    }
+
+    // Destroyed observer must have detached itself
+    std::vector<std::vector<float>> block(2, std::vector<float>(8, 1.0f));
+    ASSERT(buffer.write(block), "Write after observer destruction failed");
+}
+
+void TestSlidingDFTLoadState() {
+    print_header("TestSlidingDFTLoadState");
+    // A restored buffer replays its samples, so its observers pick up where the original's were.
+    JABuff::FramingRingBuffer2D<float> source(1, 32, 8, 8);
+    JABuff::SlidingDFT<float> source_sdft(source, {1, 3});
+
+    std::vector<std::vector<float>> block(1, std::vector<float>(44));
+    for (size_t i = 0; i < block[0].size(); ++i) block[0][i] = std::cos(0.4f * static_cast<float>(i)) - 0.5f;
+    std::vector<std::vector<float>> out;
+    ASSERT(source.write({std::vector<float>(block[0].begin(), block[0].begin() + 24)}), "Write 1 failed");
+    ASSERT(source.read(out, 2), "Read failed");
+    ASSERT(source.write({std::vector<float>(block[0].begin() + 24, block[0].end())}), "Write 2 failed");
+
+    std::vector<std::uint8_t> bytes;
+    source.saveState(bytes);
+
+    JABuff::FramingRingBuffer2D<float> restored(1, 32, 8, 8);
+    JABuff::SlidingDFT<float> restored_sdft(restored, {1, 3});
+    ASSERT(restored.write({std::vector<float>(8, 9.0f)}), "Write before restore failed");
+    ASSERT(restored.loadState(bytes.data(), bytes.size()) == bytes.size(), "Restore failed");
+    for (size_t b = 0; b < 2; ++b) {
+        std::complex<double> expected = window_dft(block[0], block[0].size(), 8, source_sdft.getBins()[b]);
+        ASSERT_NEAR(restored_sdft.getBin(0, b).real(), expected.real(), 1e-4, "Restored real mismatch");
+        ASSERT_NEAR(restored_sdft.getBin(0, b).imag(), expected.imag(), 1e-4, "Restored imag mismatch");
+        ASSERT_NEAR(restored_sdft.getPower(0, b), source_sdft.getPower(0, b), 1e-4, "Restored bins match the original");
+    }
+}
+
+int main() {
+    TestSlidingDFTTracksWindow();
+    TestSlidingDFTResyncAndClear();
+    TestSlidingDFTLoadState();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "JABuff/StreamingStateCache.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// Causal depthwise conv over [steps][dim] rows: out[t] = sum_k w[k] * in[t + k], over a view with kernel-1 history rows.
+static void causal_conv(const float* in, size_t out_steps, size_t dim, const std::vector<float>& w, float* out) {
+    for (size_t t = 0; t < out_steps; ++t)
+        for (size_t f = 0; f < dim; ++f) {
+            float acc = 0.0f;
+            for (size_t k = 0; k < w.size(); ++k) acc += w[k] * in[(t + k) * dim + f];
+            out[t * dim + f] = acc;
+        }
+}
+
+void TestStateCacheMatchesOffline() {
+    print_header("TestStateCacheMatchesOffline");
+    const size_t dim = 2, length = 53, max_chunk = 4;
+    const std::vector<float> w0 = {0.25f, -1.0f, 2.0f}, w1 = {0.5f, 1.5f};
+
+    std::vector<float> x(length * dim);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>((i * 7) % 11) - 5.0f;
+
+    // Offline reference with zero left padding.
+    std::vector<float> padded0((length + 2) * dim, 0.0f), y0(length * dim), padded1((length + 1) * dim, 0.0f), y1(length * dim);
+    std::copy(x.begin(), x.end(), padded0.begin() + 2 * dim);
+    causal_conv(padded0.data(), length, dim, w0, y0.data());
+    std::copy(y0.begin(), y0.end(), padded1.begin() + dim);
+    causal_conv(padded1.data(), length, dim, w1, y1.data());
+
+    JABuff::StreamingStateCache<float> cache({{2, dim}, {1, dim}}, max_chunk);
+    ASSERT(cache.getNumLayers() == 2, "Layer count");
+
+    std::vector<float> out(length * dim);
+    size_t pos = 0, chunk_index = 0;
+    while (pos < length) {
+        size_t chunk = std::min<size_t>(1 + (chunk_index++ * 3) % max_chunk, length - pos);
+
+        JABuff::StateView<float> v0 = cache.getView(0, chunk);
+        ASSERT(v0.steps() == 2 + chunk, "View length");
+        std::copy(x.begin() + pos * dim, x.begin() + (pos + chunk) * dim, v0.chunk());
+
+        // Layer 0 writes its output straight into layer 1's chunk slot.
+        JABuff::StateView<float> v1 = cache.getView(1, chunk);
+        causal_conv(v0.data, chunk, dim, w0, v1.chunk());
+        causal_conv(v1.data, chunk, dim, w1, out.data() + pos * dim);
+
+        cache.advance(chunk);
+        pos += chunk;
+    }
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_NEAR(out[i], y1[i], 1e-4f, "Streaming output mismatch");
+    }
+
+    // History holds the newest inputs.
+    JABuff::StateView<float> h = cache.getHistory(0);
+    ASSERT(h.steps() == 2, "History length");
+    ASSERT_NEAR(h.row(1)[1], x[(length - 1) * dim + 1], 0.0f, "History content");
+
+    cache.reset();
+    h = cache.getHistory(1);
+    ASSERT_NEAR(h.row(0)[0], 0.0f, 0.0f, "History after reset");
+}
+
+void TestStateCacheLayout() {
+    print_header("TestStateCacheLayout");
+    JABuff::StreamingStateCache<float> cache({{3, 5}, {0, 7}, {10, 1}}, 8);
+
+    // Views of different layers never overlap and live in one slab.
+    auto a = cache.getView(0, 8), b = cache.getView(1, 8), c = cache.getView(2, 8);
+    ASSERT(a.data + a.steps() * a.feature_dim <= b.data, "Layer 0 / 1 overlap");
+    ASSERT(b.data + b.steps() * b.feature_dim <= c.data, "Layer 1 / 2 overlap");
+    ASSERT(reinterpret_cast<const char*>(c.data + c.steps()) - reinterpret_cast<const char*>(a.data) <= static_cast<std::ptrdiff_t>(cache.getSlabBytes()), "Single slab");
+
+    // The view is zero-copy: it moves forward until a compaction.
+    float* before = cache.getView(0, 1).data;
+    cache.advance(1);
+    ASSERT(cache.getView(0, 1).data == before + 5, "Advance should not copy");
+
+    bool thrown = false;
+    try { cache.getView(0, 9); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Chunk above max should throw");
+    thrown = false;
+    try { cache.getView(3, 1); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT(thrown, "Bad layer should throw");
+}
+
+int main() {
+    TestStateCacheMatchesOffline();
+    TestStateCacheLayout();
+    print_pass();
+    return 0;
+}
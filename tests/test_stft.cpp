@@ -0,0 +1,128 @@
+#include "JABuff/StreamingSTFT.hpp"
+#include "test_utils.hpp"
+#include <complex>
+#include <vector>
+
+// Reference O(n^2) DFT
+template <typename T>
+std::vector<std::complex<double>> naive_dft(const std::vector<T>& x) {
+    size_t n = x.size();
+    std::vector<std::complex<double>> out(n);
+    const double two_pi = 6.283185307179586476925286766559;
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> acc(0.0, 0.0);
+        for (size_t j = 0; j < n; ++j) {
+            double phase = -two_pi * static_cast<double>((j * k) % n) / static_cast<double>(n);
+            acc += static_cast<double>(x[j]) * std::complex<double>(std::cos(phase), std::sin(phase));
+        }
+        out[k] = acc;
+    }
+    return out;
+}
+
+void TestFFTSizes() {
+    print_header("TestFFTSizes");
+    // Powers of two, mixed radix, odd and prime sizes
+    const size_t sizes[] = {1, 2, 7, 8, 12, 15, 16, 30, 49, 64, 100};
+    for (size_t n : sizes) {
+        std::vector<double> x(n);
+        for (size_t i = 0; i < n; ++i) x[i] = std::sin(0.37 * static_cast<double>(i * i)) + 0.1 * static_cast<double>(i);
+
+        auto expected = naive_dft(x);
+
+        JABuff::RealFFT<double> rfft(n);
+        std::vector<std::complex<double>> out(n / 2 + 1);
+        rfft.forward(x.data(), out.data());
+        for (size_t k = 0; k <= n / 2; ++k) {
+            ASSERT_NEAR(out[k].real(), expected[k].real(), 1e-9, "RealFFT real mismatch (n=" << n << ", k=" << k << ")");
+            ASSERT_NEAR(out[k].imag(), expected[k].imag(), 1e-9, "RealFFT imag mismatch (n=" << n << ", k=" << k << ")");
+        }
+
+        JABuff::ComplexFFT<double> cfft(n);
+        std::vector<std::complex<double>> cin(n), cout(n);
+        for (size_t i = 0; i < n; ++i) cin[i] = std::complex<double>(x[i], 0.0);
+        cfft.forward(cin.data(), cout.data());
+        for (size_t k = 0; k < n; ++k) {
+            ASSERT_NEAR(std::abs(cout[k] - expected[k]), 0.0, 1e-9, "ComplexFFT mismatch (n=" << n << ")");
+        }
+    }
+}
+
+void TestStreamingMatchesOffline() {
+    print_header("TestStreamingMatchesOffline");
+    size_t fft_size = 16;
+    size_t hop = 4;
+    JABuff::StreamingSTFT<float> stft(2, fft_size, hop, 64);
+
+    ASSERT(stft.getNumBins() == 9, "Bin count");
+    ASSERT(stft.getLatencySamples() == 12, "Latency should be fft_size - hop");
+
+    // 60 samples in odd-sized blocks; channel 1 is channel 0 scaled by 2.
+    std::vector<float> signal(60);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.3f * static_cast<float>(i)) + 0.01f * static_cast<float>(i);
+
+    size_t written = 0;
+    const size_t blocks[] = {5, 11, 1, 23, 20};
+    for (size_t len : blocks) {
+        std::vector<std::vector<float>> block(2, std::vector<float>(len));
+        for (size_t i = 0; i < len; ++i) {
+            block[0][i] = signal[written + i];
+            block[1][i] = 2.0f * signal[written + i];
+        }
+        ASSERT(stft.write(block), "STFT write failed");
+        written += len;
+    }
+
+    // Frames: 1 + (60 - 16) / 4 = 12
+    auto& spec = stft.getSpectrogram();
+    ASSERT(spec.getAvailableTimeRead() == 12, "Spectrum count mismatch");
+    ASSERT(stft.getSamplesUntilNextSpectrum() == 4, "Samples until next spectrum");
+
+    std::vector<std::vector<std::vector<float>>> out;
+    ASSERT(spec.read(out, 0), "Spectrogram read failed");
+    ASSERT(out[0].size() == 12 && out[0][0].size() == 9, "Spectrogram shape");
+
+    const std::vector<float>& window = stft.getWindow();
+    for (size_t t = 0; t < 12; ++t) {
+        std::vector<double> frame(fft_size);
+        for (size_t i = 0; i < fft_size; ++i) frame[i] = signal[t * hop + i] * window[i];
+        auto expected = naive_dft(frame);
+        for (size_t k = 0; k < 9; ++k) {
+            ASSERT_NEAR(out[0][t][k], std::abs(expected[k]), 1e-4, "Magnitude mismatch");
+            ASSERT_NEAR(out[1][t][k], 2.0 * std::abs(expected[k]), 2e-4, "Magnitude mismatch (ch1)");
+        }
+    }
+}
+
+void TestPrimeAndBackpressure() {
+    print_header("TestPrimeAndBackpressure");
+    JABuff::StreamingSTFT<float, JABuff::Float16> stft(1, 8, 2, 3, 1, 1, 1, 0, JABuff::SpectrumType::Power);
+    stft.prime();
+
+    std::vector<std::vector<float>> hop_block(1, std::vector<float>(2, 1.0f));
+    ASSERT(stft.write(hop_block), "First hop write failed");
+    ASSERT(stft.getSpectrogram().getAvailableTimeRead() == 1, "Primed STFT should emit on first hop");
+
+    // Two more spectra fit; a block producing three must be rejected without side effects.
+    std::vector<std::vector<float>> big(1, std::vector<float>(6, 1.0f));
+    ASSERT(!stft.write(big), "Write should fail when spectrogram is full");
+    ASSERT(stft.getSamplesUntilNextSpectrum() == 2, "Rejected write must not consume input");
+
+    std::vector<std::vector<float>> two_hops(1, std::vector<float>(4, 1.0f));
+    ASSERT(stft.write(two_hops), "Write filling the spectrogram failed");
+    ASSERT(stft.getSpectrogram().isFull(), "Spectrogram should be full");
+
+    // First spectrum: 6 primed zeros then two ones, so DC = (w[6] + w[7])^2 with a periodic Hann of 8.
+    std::vector<std::vector<std::vector<float>>> out;
+    stft.getSpectrogram().read(out, 1);
+    float dc = stft.getWindow()[6] + stft.getWindow()[7];
+    ASSERT_NEAR(out[0][0][0], dc * dc, 1e-3f, "DC power of first (primed) spectrum");
+}
+
+int main() {
+    TestFFTSizes();
+    TestStreamingMatchesOffline();
+    TestPrimeAndBackpressure();
+    print_pass();
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "JABuff/DiskTap.hpp"
+#include "JABuff/MappedFileSource.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static std::vector<std::uint8_t> read_file(const std::string& path) {
+    std::vector<std::uint8_t> bytes;
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) return bytes;
+    std::uint8_t chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    std::fclose(f);
+    return bytes;
+}
+
+void TestTapWav() {
+    print_header("TestTapWav");
+    const std::string path = "jabuff_test_tap.wav";
+    std::remove(path.c_str());
+
+    JABuff::FramingRingBuffer2D<float> ring(2, 512, 64, 64);
+    // Small batches so several full-batch writes happen.
+    JABuff::DiskTap<float> tap(ring, path, JABuff::TapFormat::Wav, 16000, 1 << 16, 4096);
+    ASSERT(!tap.isRecording(), "Tap must be disabled by default");
+
+    std::vector<std::vector<float>> block(2, std::vector<float>(100));
+    std::vector<std::vector<float>> out;
+    ring.write(block);
+    ASSERT(tap.getRecordedSamples() == 0, "Nothing is recorded before start()");
+    ring.clear();
+
+    tap.start();
+    ASSERT(tap.isRecording(), "Recording after start()");
+    const size_t blocks = 50;
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t i = 0; i < 100; ++i) {
+            block[0][i] = static_cast<float>(b * 100 + i);
+            block[1][i] = -static_cast<float>(b * 100 + i);
+        }
+        ASSERT(ring.write(block), "Write failed");
+        while (ring.read(out, 1)) {}
+    }
+    tap.stop();
+    ASSERT(!tap.isRecording(), "Stopped");
+    ASSERT(tap.getRecordedSamples() == blocks * 100 && tap.getDroppedBlocks() == 0, "Recorded count");
+
+    // Sample data starts on the first 4 KiB boundary.
+    ASSERT(read_file(path).size() == 4096 + blocks * 100 * 2 * sizeof(float), "File size");
+
+    JABuff::MappedFileSource<float> source(path);
+    ASSERT(source.getNumChannels() == 2 && source.getSampleRate() == 16000, "Header");
+    ASSERT(source.getFormat() == JABuff::SampleFormat::Float32 && source.getTotalFrames() == blocks * 100, "Format / length");
+    JABuff::FramingRingBuffer2D<float> check(2, 8192, 5000, 5000);
+    ASSERT(source.pump(check) == blocks * 100 && check.read(out, 1), "Read back failed");
+    for (size_t i = 0; i < blocks * 100; ++i) {
+        ASSERT(out[0][i] == static_cast<float>(i) && out[1][i] == -static_cast<float>(i), "Recorded samples mismatch");
+    }
+    std::remove(path.c_str());
+}
+
+void TestTapRawOLA() {
+    print_header("TestTapRawOLA");
+    const std::string path = "jabuff_test_tap.raw";
+    JABuff::OLARingBuffer2D<double> ola(1, 1024, 84, 16);
+    JABuff::DiskTap<double> tap(ola, path, JABuff::TapFormat::RawTimestamped, 48000, 1 << 16, 4096);
+    tap.start();
+
+    std::vector<std::vector<double>> block(1, std::vector<double>(100));
+    std::vector<std::vector<double>> out;
+    std::vector<double> expected;
+    for (size_t b = 0; b < 20; ++b) {
+        for (size_t i = 0; i < 100; ++i) block[0][i] = static_cast<double>(b) + 0.01 * static_cast<double>(i);
+        ASSERT(ola.write(block), "OLA write failed");
+        ASSERT(ola.read(out, 1), "OLA read failed");
+        expected.insert(expected.end(), out[0].begin(), out[0].end());
+    }
+    tap.stop();
+
+    // Records must hold exactly what read() returned, with contiguous positions.
+    std::vector<std::uint8_t> bytes = read_file(path);
+    std::vector<double> recorded;
+    std::uint64_t next_position = 0;
+    std::uint64_t last_time = 0;
+    size_t pos = 0;
+    while (pos + sizeof(JABuff::TapRecordHeader) <= bytes.size()) {
+        JABuff::TapRecordHeader header;
+        std::memcpy(&header, bytes.data() + pos, sizeof(header));
+        pos += sizeof(header);
+        ASSERT(header.num_channels == 1 && header.position == next_position, "Record header");
+        ASSERT(header.time_ns >= last_time, "Timestamps must not go backwards");
+        next_position += header.count;
+        last_time = header.time_ns;
+        for (size_t i = 0; i < header.count; ++i, pos += sizeof(double)) {
+            double v;
+            std::memcpy(&v, bytes.data() + pos, sizeof(double));
+            recorded.push_back(v);
+        }
+    }
+    ASSERT(pos == bytes.size(), "Trailing bytes in the raw file");
+    ASSERT(recorded.size() == expected.size(), "Recorded length");
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT(recorded[i] == expected[i], "Recorded OLA output mismatch");
+    }
+    std::remove(path.c_str());
+}
+
+void TestTapOverflow() {
+    print_header("TestTapOverflow");
+    const std::string path = "jabuff_test_tap_overflow.raw";
+    JABuff::FramingRingBuffer2D<float> ring(1, 4096, 16, 16);
+    JABuff::DiskTap<float> tap(ring, path, JABuff::TapFormat::RawTimestamped, 48000, 4096, 4096);
+    tap.start();
+    // A block larger than the whole queue can never be staged.
+    ASSERT(ring.write(std::vector<std::vector<float>>(1, std::vector<float>(2000))), "Write failed");
+    ASSERT(tap.getDroppedBlocks() == 1 && tap.getRecordedSamples() == 2000, "Oversized block is dropped, not blocked on");
+    tap.stop();
+    ASSERT(read_file(path).empty(), "Nothing written for a dropped block");
+    std::remove(path.c_str());
+
+    bool thrown = false;
+    try { JABuff::DiskTap<float> bad(ring, path, JABuff::TapFormat::Wav, 48000, 1 << 16, 1000); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Unaligned batch size should throw");
+
+    thrown = false;
+    try { JABuff::DiskTap<float> bad(ring, path, JABuff::TapFormat::Wav, 48000, 4096, 8192); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Queue smaller than a batch should throw");
+
+    thrown = false;
+    JABuff::DiskTap<float> unwritable(ring, "/nonexistent_dir/tap.wav");
+    try { unwritable.start(); } catch (const std::runtime_error&) { thrown = true; }
+    ASSERT(thrown && !unwritable.isRecording(), "Unopenable path should throw");
+}
+
+int main() {
+    TestTapWav();
+    TestTapRawOLA();
+    TestTapOverflow();
+    print_pass();
+    return 0;
+}
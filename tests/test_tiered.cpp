@@ -0,0 +1,115 @@
+#include "JABuff/TieredHistory.hpp"
+#include "test_utils.hpp"
+#include <vector>
+#include <cmath>
+
+void TestTieredHistoryRoundTrip() {
+    print_header("TestTieredHistoryRoundTrip");
+    // Hot ring of 256 samples, cold blocks of 64 (hop 16), 1024 samples of cold history.
+    JABuff::FramingRingBuffer2D<float> ring(2, 256, 32, 16);
+    // The pool holds every block the loop below produces, so none is dropped however slow the worker.
+    JABuff::TieredHistory<float> history(ring, 64, 1024, 64);
+    ASSERT(history.getBlockSize() == 64 && history.getMaxHistorySamples() == 1024 && history.getPoolBlocks() == 64, "Getters");
+
+    // A quiet tone plus stretches of silence: the silence compresses to almost nothing.
+    auto sample = [](std::uint64_t i, size_t c) {
+        if ((i / 200) % 2 == 1) return 0.0f;
+        return static_cast<float>(0.25 * std::sin(0.05 * static_cast<double>(i)) * (c == 0 ? 1.0 : -1.0));
+    };
+
+    std::vector<std::vector<float>> block(2, std::vector<float>(48));
+    std::vector<std::vector<float>> out;
+    std::uint64_t written = 0;
+    for (int round = 0; round < 61; ++round) {
+        for (size_t c = 0; c < 2; ++c) {
+            for (size_t i = 0; i < 48; ++i) block[c][i] = sample(written + i, c);
+        }
+        ASSERT(ring.write(block), "Write failed");
+        written += 48;
+        while (ring.read(out, 1)) {}
+    }
+    history.flush();
+    ASSERT(history.getDroppedBlocks() == 0, "No block dropped");
+
+    // 2928 samples written: 45 full blocks, the newest 16 kept, plus a partial block of 48.
+    ASSERT(history.getColdSamples() == 1024, "Cold tier capped at max history");
+    std::uint64_t oldest = history.getOldestPosition();
+    ASSERT(oldest == 2880 - 1024, "Oldest position");
+    ASSERT(history.getColdBytes() < 1024 * 2 * sizeof(float), "Cold tier should be smaller than raw floats");
+
+    // Random access across cold blocks and into the partial block, bit-exact.
+    ASSERT(history.read(oldest + 10, written, out), "Read across tiers");
+    ASSERT(out.size() == 2 && out[0].size() == written - oldest - 10, "Read size");
+    for (size_t c = 0; c < 2; ++c) {
+        for (size_t i = 0; i < out[c].size(); ++i) {
+            ASSERT(out[c][i] == sample(oldest + 10 + i, c), "Lossless round trip");
+        }
+    }
+
+    ASSERT(history.read(oldest + 100, oldest + 130, out) && out[1][0] == sample(oldest + 100, 1), "Short cold read");
+    ASSERT(!history.read(oldest - 1, oldest + 10, out), "Evicted samples are refused");
+    ASSERT(!history.read(written - 4, written + 4, out), "Unwritten samples are refused");
+
+    bool thrown = false;
+    try { JABuff::TieredHistory<float> bad(ring, 40, 1024); } catch (const std::invalid_argument&) { thrown = true; }
+    ASSERT(thrown, "Block size not aligned to the hop should throw");
+}
+
+void TestTieredHistoryHotPath() {
+    print_header("TestTieredHistoryHotPath");
+    // Ranges still retained by the ring come straight from it.
+    JABuff::FramingRingBuffer2D<double> ring(1, 512, 16, 16);
+    ring.setHistoryRetention(256);
+    JABuff::TieredHistory<double> history(ring, 128, 4096);
+
+    std::vector<std::vector<double>> block(1, std::vector<double>(100));
+    for (size_t i = 0; i < 100; ++i) block[0][i] = static_cast<double>(i) * 1.5;
+    ASSERT(ring.write(block), "Write failed");
+
+    std::vector<std::vector<double>> out;
+    ASSERT(history.read(10, 90, out), "Hot read");
+    ASSERT(out[0].size() == 80 && out[0][0] == 15.0 && out[0][79] == 133.5, "Hot read data");
+
+    ring.clear();
+    ASSERT(history.getColdSamples() == 0, "Clear drops the cold tier");
+    ASSERT(!history.read(0, 1, out), "Nothing to read after clear");
+}
+
+void TestTieredHistoryDrops() {
+    print_header("TestTieredHistoryDrops");
+    // One pool slot and 20 blocks written back to back: blocks the worker has not taken
+    // yet are dropped, never waited for. Whatever the timing, every block is either
+    // compressed or counted, and everything read back (all from the cold tier, the
+    // ring is drained) is exact.
+    JABuff::FramingRingBuffer2D<float> ring(1, 256, 16, 16);
+    JABuff::TieredHistory<float> history(ring, 64, 4096, 1);
+
+    std::vector<std::vector<float>> block(1, std::vector<float>(64));
+    std::vector<std::vector<float>> out;
+    for (size_t b = 0; b < 20; ++b) {
+        for (size_t i = 0; i < 64; ++i) block[0][i] = static_cast<float>(b * 64 + i);
+        ASSERT(ring.write(block), "Write failed");
+        while (ring.read(out, 1)) {}
+    }
+    history.flush();
+
+    ASSERT(history.getColdSamples() / 64 + history.getDroppedBlocks() == 20, "Blocks compressed or counted");
+    size_t readable = 0;
+    for (std::uint64_t start = 0; start < 20 * 64; start += 64) {
+        if (!history.read(start, start + 64, out)) continue;
+        ++readable;
+        for (size_t i = 0; i < 64; ++i) ASSERT(out[0][i] == static_cast<float>(start + i), "Exact data around gaps");
+    }
+    ASSERT(readable == 20 - history.getDroppedBlocks(), "Dropped blocks are refused, the rest readable");
+    if (history.getDroppedBlocks() > 0) {
+        ASSERT(!history.read(0, 20 * 64, out), "A range over a dropped block is refused");
+    }
+}
+
+int main() {
+    TestTieredHistoryRoundTrip();
+    TestTieredHistoryHotPath();
+    TestTieredHistoryDrops();
+    print_pass();
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include <cstdlib>
 #include <vector>
 #include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <string>
 
 // Simple assertion macro
 #define ASSERT(condition, message) \
@@ -33,3 +36,36 @@ inline void print_header(const std::string& name) {
 inline void print_pass() {
     std::cout << "[\033[1;32mPASS\033[0m] All checks passed." << std::endl;
 }
+
+// Little-endian writers for building test files byte by byte
+inline void put_u16(std::vector<std::uint8_t>& b, std::uint32_t v) { b.push_back(v & 0xFF); b.push_back((v >> 8) & 0xFF); }
+inline void put_u32(std::vector<std::uint8_t>& b, std::uint32_t v) { put_u16(b, v & 0xFFFF); put_u16(b, v >> 16); }
+
+inline void write_file(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+}
+
+// Minimal 16 kHz WAV writer: an extra chunk before "data" checks that the parser skips unknown chunks.
+inline void write_wav(const std::string& path, std::uint16_t tag, std::uint16_t channels, std::uint16_t bits,
+                      const std::vector<std::uint8_t>& payload) {
+    std::vector<std::uint8_t> b;
+    b.insert(b.end(), {'R', 'I', 'F', 'F'});
+    put_u32(b, static_cast<std::uint32_t>(4 + 24 + 10 + 8 + payload.size()));
+    b.insert(b.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(b, 16);
+    put_u16(b, tag);
+    put_u16(b, channels);
+    put_u32(b, 16000);
+    put_u32(b, 16000u * channels * bits / 8);
+    put_u16(b, static_cast<std::uint16_t>(channels * bits / 8));
+    put_u16(b, bits);
+    b.insert(b.end(), {'L', 'I', 'S', 'T'});
+    put_u32(b, 1);
+    b.insert(b.end(), {'x', 0}); // Odd-sized chunk plus pad byte
+    b.insert(b.end(), {'d', 'a', 't', 'a'});
+    put_u32(b, static_cast<std::uint32_t>(payload.size()));
+    b.insert(b.end(), payload.begin(), payload.end());
+    write_file(path, b);
+}